@@ -19,8 +19,18 @@
 #define AUTOMATION1_AXIS_H
 
 #include <map>
+#include <optional>
 #include <tango/tango.h>
 #include <Automation1Status.h>
+#include "EventPusher.h"
+#include "PositionCapture.h"
+#include "Retarget.h"
+#include "Sampler.h"
+#include "StateFilter.h"
+#include "StepScan.h"
+#include "TrajectoryStreamer.h"
+#include "VelocityStreamer.h"
+#include "WatchSet.h"
 
 
 namespace Axis_ns
@@ -91,6 +101,30 @@ namespace Axis_ns
         bool InternalFault;
     };
 
+    // Position synchronized output setup as given to the psoConfigure command.
+    struct PsoConfig
+    {
+        enum Mode { Distance = 0, Array = 1 };
+
+        Mode mode{Distance};
+        double pulse_on_time{};
+        double window_low{NAN};
+        double window_high{NAN};
+        double distance{};
+        std::vector<double> positions{};
+    };
+
+    // Drive telemetry item of the telemetryItems property, read through a dynamic attribute.
+    struct TelemetryChannel
+    {
+        std::string attribute;
+        Automation1AxisStatusItem item{};
+        std::optional<double> min_alarm{};
+        std::optional<double> max_alarm{};
+        // Storage of the value handed to Tango by the last read.
+        Tango::DevDouble value{};
+    };
+
     class Axis final : public TANGO_BASE_CLASS
     {
     public:
@@ -135,18 +169,50 @@ namespace Axis_ns
         Tango::DevBoolean* attr_positive_hard_limit_read{};
         Tango::DevBoolean* attr_negative_hard_limit_read{};
 
+        Tango::DevDouble* attr_sampling_rate_read{};
+
+        Tango::DevBoolean* attr_pso_armed_read{};
+
+        Tango::DevLong* attr_trajectory_progress_read{};
+        Tango::DevLong* attr_trajectory_underruns_read{};
+        Tango::DevString* attr_trajectory_status_read{};
+
+        Tango::DevLong* attr_step_scan_progress_read{};
+        Tango::DevString* attr_step_scan_status_read{};
+
+        Tango::DevLong* attr_capture_count_read{};
+        Tango::DevLong* attr_capture_restarts_read{};
+        Tango::DevLong* attr_capture_dropped_read{};
+        Tango::DevBoolean* attr_capture_armed_read{};
+
+        Tango::DevDouble* attr_position_history_window{};
+        Tango::DevLong* attr_position_history_points{};
+
+        Tango::DevDouble* attr_velocity_setpoint_read{};
+        Tango::DevLong* attr_velocity_stream_coalesced_read{};
+        Tango::DevString* attr_velocity_stream_status_read{};
+
+        Tango::DevBoolean* attr_retarget_enabled{};
+        Tango::DevString* attr_retarget_status_read{};
+        Tango::DevLong64* attr_suppressed_state_changes_read{};
+        Tango::DevBoolean* attr_motion_done_read{};
+        Tango::DevString* attr_motion_result_read{};
 
         void delete_device() override;
 
         void init_device() override;
 
+        void init_hardware();
+
+        void set_init_error(const std::string& error);
+
         void get_device_property();
 
         void always_executed_hook() override;
 
         void read_attr_hardware(std::vector<long>& attr_list) override;
 
-        static void add_dynamic_attributes();
+        void add_dynamic_attributes();
 
         void enable();
 
@@ -210,24 +276,247 @@ namespace Axis_ns
 
         bool is_freerun_allowed(const CORBA::Any& type);
 
-        [[nodiscard]] AxisStatus get_axis_status() const;
+        // Returns immediately. motion_done and motion_result push change events when the motion is done.
+        void notify_motion_done(Tango::DevDouble timeout);
+
+        bool is_notify_motion_done_allowed(const CORBA::Any& type);
+
+        void move_and_notify(const Tango::DevVarDoubleArray* arg_in);
+
+        bool is_move_and_notify_allowed(const CORBA::Any& type);
+
+        void read_motion_done(Tango::Attribute& attribute);
+
+        void read_motion_result(Tango::Attribute& attribute);
+
+        void pso_configure(const Tango::DevVarDoubleArray* arg_in);
+
+        void pso_arm();
+
+        void pso_disarm();
+
+        bool is_pso_allowed(const CORBA::Any& type);
+
+        void read_pso_armed(Tango::Attribute& attribute);
+
+        void read_sampling_rate(Tango::Attribute& attribute);
+
+        void trajectory_load(const Tango::DevVarDoubleArray* arg_in);
+
+        void trajectory_start();
+
+        void trajectory_abort();
+
+        bool is_trajectory_allowed(const CORBA::Any& type);
+
+        void read_trajectory_progress(Tango::Attribute& attribute);
+
+        void read_trajectory_underruns(Tango::Attribute& attribute);
+
+        void read_trajectory_status(Tango::Attribute& attribute);
+
+        void step_scan_start(const Tango::DevVarDoubleArray* arg_in);
+
+        void step_scan_abort();
+
+        bool is_step_scan_start_allowed(const CORBA::Any& type);
+
+        void read_step_scan_progress(Tango::Attribute& attribute);
+
+        void read_step_scan_status(Tango::Attribute& attribute);
+
+        void read_step_scan_timestamps(Tango::Attribute& attribute);
+
+        void read_step_scan_positions(Tango::Attribute& attribute);
+
+        void capture_arm();
+
+        void capture_disarm();
+
+        void read_captured_positions(Tango::Attribute& attribute);
+
+        void read_captured_indices(Tango::Attribute& attribute);
+
+        void read_capture_count(Tango::Attribute& attribute);
+
+        void read_capture_restarts(Tango::Attribute& attribute);
+
+        void read_capture_dropped(Tango::Attribute& attribute);
+
+        void read_capture_armed(Tango::Attribute& attribute);
+
+        void read_position_history(Tango::Attribute& attribute);
+
+        void read_position_history_time(Tango::Attribute& attribute);
+
+        void read_position_history_window(Tango::Attribute& attribute);
+
+        void write_position_history_window(Tango::WAttribute& attribute);
+
+        void read_position_history_points(Tango::Attribute& attribute);
+
+        void write_position_history_points(Tango::WAttribute& attribute);
+
+        void read_velocity_setpoint(Tango::Attribute& attribute);
+
+        void write_velocity_setpoint(Tango::WAttribute& attribute);
+
+        void velocity_stream_stop();
+
+        void read_velocity_stream_coalesced(Tango::Attribute& attribute);
+
+        void read_velocity_stream_status(Tango::Attribute& attribute);
+
+        void read_retarget_enabled(Tango::Attribute& attribute);
+
+        void write_retarget_enabled(Tango::WAttribute& attribute);
+
+        void read_retarget_status(Tango::Attribute& attribute);
 
-        [[nodiscard]] AxisFaults get_axis_faults() const;
+        void read_suppressed_state_changes(Tango::Attribute& attribute);
 
-        [[nodiscard]] DriveStatus get_drive_status() const;
+        void read_telemetry(Tango::Attribute& attribute);
+
+        // arg_in: [name, expression]. Fields without an axis name refer to this axis.
+        void watch_add(const Tango::DevVarStringArray* arg_in);
+
+        void watch_remove(Tango::DevString name);
+
+        Tango::DevVarStringArray* watch_list();
+
+        bool is_watch_allowed(const CORBA::Any& type);
+
+        void read_watch(Tango::Attribute& attribute);
+
+        [[nodiscard]] static AxisStatus get_axis_status(const Controller_ns::AxisSnapshot& snapshot);
+
+        [[nodiscard]] static AxisFaults get_axis_faults(const Controller_ns::AxisSnapshot& snapshot);
+
+        [[nodiscard]] static DriveStatus get_drive_status(const Controller_ns::AxisSnapshot& snapshot);
 
     private:
+        [[nodiscard]] Controller_ns::AxisSnapshot get_snapshot() const;
+
+        // State of the status bits, without the debouncing of dev_state().
+        Tango::DevState raw_state();
+
+        void move_absolute(double position);
+
+        // Writes a command of this axis to the flight recorder.
+        void record(Controller_ns::FlightCommand command, std::initializer_list<double> arguments, bool ok) const;
+
+        // True if a position write may change the target of the running motion.
+        [[nodiscard]] bool can_retarget();
+
+        // Parses telemetryItems into telemetry. Throws on unknown items.
+        void parse_telemetry_items();
+
+        [[nodiscard]] static bool is_motion_finished(const Controller_ns::AxisSnapshot& snapshot);
+
+        void cancel_motion_notification();
+
+        // Throws if the drive array regions of the PSO distances and of the capture overlap.
+        void check_array_regions(const char* origin) const;
+
+        // Pushes motion_done and motion_result. Called under the device monitor.
+        void push_motion_done();
+
         [[nodiscard]] double counts_to_user_unit(double counts) const;
 
         [[nodiscard]] double user_unit_to_counts(double user_unit) const;
 
-        Automation1StatusConfig statusConfig{};
-
         int axisID{};
 
+        bool sampled{false};
+
         std::string axisName{};
 
+        Tango::DevLong psoInput{};
+
+        Tango::DevLong psoOutput{};
+
+        Tango::DevLong psoArrayAddress{0};
+
+        Tango::DevLong psoArraySize{4096};
+
+        std::optional<PsoConfig> pso{};
+
+        Tango::DevLong trajectoryTask{2};
+
+        Tango::DevLong trajectoryQueueDepth{64};
+
+        std::unique_ptr<TrajectoryStreamer> trajectory{};
+
+        std::string trajectory_status{};
+
+        std::unique_ptr<StepScan> step_scan{};
+
+        std::string step_scan_status{};
+
+        std::vector<double> step_scan_timestamps{};
+
+        std::vector<double> step_scan_positions{};
+
+        Tango::DevLong captureInput{};
+
+        Tango::DevLong captureTrigger{};
+
+        Tango::DevLong captureArrayAddress{4096};
+
+        Tango::DevLong captureArraySize{4096};
+
+        Tango::DevLong captureMaxPoints{1000000};
+
+        std::unique_ptr<PositionCapture> capture{};
+
+        Tango::DevDouble velocityStreamRate{50.};
+
+        Tango::DevDouble velocityStreamTimeout{0.5};
+
+        std::unique_ptr<VelocityStreamer> velocity_stream{};
+
+        std::string velocity_stream_status{};
+
+        Tango::DevDouble retargetAcceleration{10.};
+
+        std::unique_ptr<Retarget> retarget{};
+
+        std::string retarget_status{};
+
+        std::vector<std::string> stateDebounce{};
+
+        Tango::DevDouble stateMinDwell{};
+
+        StateFilter state_filter{};
+
+        std::vector<std::string> telemetryItems{};
+
+        std::vector<TelemetryChannel> telemetry{};
+
+        bool telemetry_registered{false};
+
+        std::unique_ptr<Controller_ns::WatchSet> watches{};
+
+        // Change events pushed from the sampler thread.
+        std::unique_ptr<Controller_ns::EventPusher> events{};
+
+        std::optional<int> motion_notification{};
+
+        // Counts notifyMotionDone calls, so a result posted for an earlier call is ignored.
+        std::uint64_t motion_generation{};
+
+        bool motion_done{true};
+
+        std::string motion_result{};
+
+        // Filled once per read request, so position_history and position_history_time read together match.
+        std::vector<double> position_history{};
+
+        std::vector<double> position_history_time{};
+
         std::string status{};
+
+        std::string init_error{};
     };
 }
 #endif   //	AUTOMATION1_AXIS_H
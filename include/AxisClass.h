@@ -210,10 +210,732 @@ namespace Axis_ns
         }
     };
 
+    class samplingRateAttrib final : public Tango::Attr
+    {
+    public:
+        samplingRateAttrib() : Attr("sampling_rate",
+                                    Tango::DEV_DOUBLE, Tango::READ)
+        {
+        };
+
+        ~samplingRateAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_sampling_rate(att); }
+    };
+
+    class psoArmedAttrib final : public Tango::Attr
+    {
+    public:
+        psoArmedAttrib() : Attr("pso_armed",
+                                Tango::DEV_BOOLEAN, Tango::READ)
+        {
+        };
+
+        ~psoArmedAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_pso_armed(att); }
+    };
+
+    class trajectoryProgressAttrib final : public Tango::Attr
+    {
+    public:
+        trajectoryProgressAttrib() : Attr("trajectory_progress",
+                                         Tango::DEV_LONG, Tango::READ)
+        {
+        };
+
+        ~trajectoryProgressAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_trajectory_progress(att); }
+    };
+
+    class trajectoryUnderrunsAttrib final : public Tango::Attr
+    {
+    public:
+        trajectoryUnderrunsAttrib() : Attr("trajectory_underruns",
+                                          Tango::DEV_LONG, Tango::READ)
+        {
+        };
+
+        ~trajectoryUnderrunsAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_trajectory_underruns(att); }
+    };
+
+    class trajectoryStatusAttrib final : public Tango::Attr
+    {
+    public:
+        trajectoryStatusAttrib() : Attr("trajectory_status",
+                                       Tango::DEV_STRING, Tango::READ)
+        {
+        };
+
+        ~trajectoryStatusAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_trajectory_status(att); }
+    };
+
+    class stepScanProgressAttrib final : public Tango::Attr
+    {
+    public:
+        stepScanProgressAttrib() : Attr("step_scan_progress",
+                                         Tango::DEV_LONG, Tango::READ)
+        {
+        };
+
+        ~stepScanProgressAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_step_scan_progress(att); }
+    };
+
+    class stepScanStatusAttrib final : public Tango::Attr
+    {
+    public:
+        stepScanStatusAttrib() : Attr("step_scan_status",
+                                       Tango::DEV_STRING, Tango::READ)
+        {
+        };
+
+        ~stepScanStatusAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_step_scan_status(att); }
+    };
+
+    class stepScanTimestampsAttrib final : public Tango::SpectrumAttr
+    {
+    public:
+        stepScanTimestampsAttrib() : SpectrumAttr("step_scan_timestamps",
+                                                   Tango::DEV_DOUBLE, Tango::READ, 100000)
+        {
+        };
+
+        ~stepScanTimestampsAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_step_scan_timestamps(att); }
+    };
+
+    class stepScanPositionsAttrib final : public Tango::SpectrumAttr
+    {
+    public:
+        stepScanPositionsAttrib() : SpectrumAttr("step_scan_positions",
+                                                  Tango::DEV_DOUBLE, Tango::READ, 100000)
+        {
+        };
+
+        ~stepScanPositionsAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_step_scan_positions(att); }
+    };
+
+    class capturedPositionsAttrib final : public Tango::SpectrumAttr
+    {
+    public:
+        capturedPositionsAttrib() : SpectrumAttr("captured_positions",
+                                                  Tango::DEV_DOUBLE, Tango::READ, 1000000)
+        {
+        };
+
+        ~capturedPositionsAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_captured_positions(att); }
+    };
+
+    class capturedIndicesAttrib final : public Tango::SpectrumAttr
+    {
+    public:
+        capturedIndicesAttrib() : SpectrumAttr("captured_indices",
+                                                Tango::DEV_LONG64, Tango::READ, 1000000)
+        {
+        };
+
+        ~capturedIndicesAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_captured_indices(att); }
+    };
+
+    class captureCountAttrib final : public Tango::Attr
+    {
+    public:
+        captureCountAttrib() : Attr("capture_count",
+                                     Tango::DEV_LONG, Tango::READ)
+        {
+        };
+
+        ~captureCountAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_capture_count(att); }
+    };
+
+    class captureRestartsAttrib final : public Tango::Attr
+    {
+    public:
+        captureRestartsAttrib() : Attr("capture_restarts",
+                                        Tango::DEV_LONG, Tango::READ)
+        {
+        };
+
+        ~captureRestartsAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_capture_restarts(att); }
+    };
+
+    class captureDroppedAttrib final : public Tango::Attr
+    {
+    public:
+        captureDroppedAttrib() : Attr("capture_dropped",
+                                       Tango::DEV_LONG, Tango::READ)
+        {
+        };
+
+        ~captureDroppedAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_capture_dropped(att); }
+    };
+
+    class captureArmedAttrib final : public Tango::Attr
+    {
+    public:
+        captureArmedAttrib() : Attr("capture_armed",
+                                     Tango::DEV_BOOLEAN, Tango::READ)
+        {
+        };
+
+        ~captureArmedAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_capture_armed(att); }
+    };
+
+    class positionHistoryAttrib final : public Tango::SpectrumAttr
+    {
+    public:
+        positionHistoryAttrib() : SpectrumAttr("position_history",
+                                                Tango::DEV_DOUBLE, Tango::READ, 100000)
+        {
+        };
+
+        ~positionHistoryAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_position_history(att); }
+    };
+
+    class positionHistoryTimeAttrib final : public Tango::SpectrumAttr
+    {
+    public:
+        positionHistoryTimeAttrib() : SpectrumAttr("position_history_time",
+                                                    Tango::DEV_DOUBLE, Tango::READ, 100000)
+        {
+        };
+
+        ~positionHistoryTimeAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_position_history_time(att); }
+    };
+
+    class positionHistoryWindowAttrib final : public Tango::Attr
+    {
+    public:
+        positionHistoryWindowAttrib() : Attr("position_history_window",
+                                              Tango::DEV_DOUBLE, Tango::READ_WRITE)
+        {
+        };
+
+        ~positionHistoryWindowAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_position_history_window(att); }
+
+        void write(Tango::DeviceImpl* dev,
+                   Tango::WAttribute& att) override { (dynamic_cast<Axis*>(dev))->write_position_history_window(att); }
+    };
+
+    class positionHistoryPointsAttrib final : public Tango::Attr
+    {
+    public:
+        positionHistoryPointsAttrib() : Attr("position_history_points",
+                                              Tango::DEV_LONG, Tango::READ_WRITE)
+        {
+        };
+
+        ~positionHistoryPointsAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_position_history_points(att); }
+
+        void write(Tango::DeviceImpl* dev,
+                   Tango::WAttribute& att) override { (dynamic_cast<Axis*>(dev))->write_position_history_points(att); }
+    };
+
+    class velocitySetpointAttrib final : public Tango::Attr
+    {
+    public:
+        velocitySetpointAttrib() : Attr("velocity_setpoint",
+                                         Tango::DEV_DOUBLE, Tango::READ_WRITE)
+        {
+        };
+
+        ~velocitySetpointAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_velocity_setpoint(att); }
+
+        void write(Tango::DeviceImpl* dev,
+                   Tango::WAttribute& att) override { (dynamic_cast<Axis*>(dev))->write_velocity_setpoint(att); }
+    };
+
+    class velocityStreamCoalescedAttrib final : public Tango::Attr
+    {
+    public:
+        velocityStreamCoalescedAttrib() : Attr("velocity_stream_coalesced",
+                                                Tango::DEV_LONG, Tango::READ)
+        {
+        };
+
+        ~velocityStreamCoalescedAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_velocity_stream_coalesced(att); }
+    };
+
+    class velocityStreamStatusAttrib final : public Tango::Attr
+    {
+    public:
+        velocityStreamStatusAttrib() : Attr("velocity_stream_status",
+                                             Tango::DEV_STRING, Tango::READ)
+        {
+        };
+
+        ~velocityStreamStatusAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_velocity_stream_status(att); }
+    };
+
+    class retargetEnabledAttrib final : public Tango::Attr
+    {
+    public:
+        retargetEnabledAttrib() : Attr("retarget_enabled",
+                                        Tango::DEV_BOOLEAN, Tango::READ_WRITE)
+        {
+        };
+
+        ~retargetEnabledAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_retarget_enabled(att); }
+
+        void write(Tango::DeviceImpl* dev,
+                   Tango::WAttribute& att) override { (dynamic_cast<Axis*>(dev))->write_retarget_enabled(att); }
+    };
+
+    class retargetStatusAttrib final : public Tango::Attr
+    {
+    public:
+        retargetStatusAttrib() : Attr("retarget_status",
+                                       Tango::DEV_STRING, Tango::READ)
+        {
+        };
+
+        ~retargetStatusAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_retarget_status(att); }
+    };
+
+    class suppressedStateChangesAttrib final : public Tango::Attr
+    {
+    public:
+        suppressedStateChangesAttrib() : Attr("suppressed_state_changes",
+                                               Tango::DEV_LONG64, Tango::READ)
+        {
+        };
+
+        ~suppressedStateChangesAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_suppressed_state_changes(att); }
+    };
+
+    class motionDoneAttrib final : public Tango::Attr
+    {
+    public:
+        motionDoneAttrib() : Attr("motion_done",
+                                   Tango::DEV_BOOLEAN, Tango::READ)
+        {
+        };
+
+        ~motionDoneAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_motion_done(att); }
+    };
+
+    class motionResultAttrib final : public Tango::Attr
+    {
+    public:
+        motionResultAttrib() : Attr("motion_result",
+                                     Tango::DEV_STRING, Tango::READ)
+        {
+        };
+
+        ~motionResultAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_motion_result(att); }
+    };
+
+    // Dynamic attribute of a drive telemetry item of the telemetryItems property.
+    class telemetryAttrib final : public Tango::Attr
+    {
+    public:
+        explicit telemetryAttrib(const std::string& name) : Attr(name.c_str(),
+                                                                 Tango::DEV_DOUBLE, Tango::READ)
+        {
+        };
+
+        ~telemetryAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_telemetry(att); }
+    };
+
+    // Dynamic attribute of a watch added with watchAdd.
+    class watchAttrib final : public Tango::Attr
+    {
+    public:
+        explicit watchAttrib(const std::string& name) : Attr(name.c_str(),
+                                                             Tango::DEV_BOOLEAN, Tango::READ)
+        {
+        };
+
+        ~watchAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Axis*>(dev))->read_watch(att); }
+    };
+
     class EnableCommand final : public Tango::Command
     {
     public:
-        EnableCommand(const char* cmd_name,
+        EnableCommand(const char* cmd_name,
+                      const Tango::CmdArgType in,
+                      const Tango::CmdArgType out,
+                      const char* in_desc,
+                      const char* out_desc,
+                      const Tango::DispLevel level)
+            : Command(cmd_name, in, out, in_desc, out_desc, level)
+        {
+        };
+
+        EnableCommand(const char* cmd_name,
+                      const Tango::CmdArgType in,
+                      const Tango::CmdArgType out)
+            : Command(cmd_name, in, out)
+        {
+        };
+
+        ~EnableCommand() override = default;
+
+        CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
+
+        bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
+        {
+            return (dynamic_cast<Axis*>(dev))->is_enable_allowed(any);
+        }
+    };
+
+
+    class FaultAckAllCommand final : public Tango::Command
+    {
+    public:
+        FaultAckAllCommand(const char* cmd_name,
+                           const Tango::CmdArgType in,
+                           const Tango::CmdArgType out,
+                           const char* in_desc,
+                           const char* out_desc,
+                           const Tango::DispLevel level)
+            : Command(cmd_name, in, out, in_desc, out_desc, level)
+        {
+        };
+
+        FaultAckAllCommand(const char* cmd_name,
+                           const Tango::CmdArgType in,
+                           const Tango::CmdArgType out)
+            : Command(cmd_name, in, out)
+        {
+        };
+
+        ~FaultAckAllCommand() override = default;
+
+        CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
+
+        bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
+        {
+            return (dynamic_cast<Axis*>(dev))->is_faultack_all_allowed(any);
+        }
+    };
+
+    class FreerunCommand final : public Tango::Command
+    {
+    public:
+        FreerunCommand(const char* cmd_name,
+                       const Tango::CmdArgType in,
+                       const Tango::CmdArgType out,
+                       const char* in_desc,
+                       const char* out_desc,
+                       const Tango::DispLevel level)
+            : Command(cmd_name, in, out, in_desc, out_desc, level)
+        {
+        };
+
+        FreerunCommand(const char* cmd_name,
+                       const Tango::CmdArgType in,
+                       const Tango::CmdArgType out)
+            : Command(cmd_name, in, out)
+        {
+        };
+
+        ~FreerunCommand() override = default;
+
+        CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
+
+        bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
+        {
+            return (dynamic_cast<Axis*>(dev))->is_freerun_allowed(any);
+        }
+    };
+
+    class StopCommand final : public Tango::Command
+    {
+    public:
+        StopCommand(const char* cmd_name,
+                    const Tango::CmdArgType in,
+                    const Tango::CmdArgType out,
+                    const char* in_desc,
+                    const char* out_desc,
+                    const Tango::DispLevel level)
+            : Command(cmd_name, in, out, in_desc, out_desc, level)
+        {
+        };
+
+        StopCommand(const char* cmd_name,
+                    const Tango::CmdArgType in,
+                    const Tango::CmdArgType out)
+            : Command(cmd_name, in, out)
+        {
+        };
+
+        ~StopCommand() override = default;
+
+        CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
+
+        bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
+        {
+            return (dynamic_cast<Axis*>(dev))->is_stop_allowed(any);
+        }
+    };
+
+    class HomeCommand final : public Tango::Command
+    {
+    public:
+        HomeCommand(const char* cmd_name,
+                    const Tango::CmdArgType in,
+                    const Tango::CmdArgType out,
+                    const char* in_desc,
+                    const char* out_desc,
+                    const Tango::DispLevel level)
+            : Command(cmd_name, in, out, in_desc, out_desc, level)
+        {
+        };
+
+        HomeCommand(const char* cmd_name,
+                    const Tango::CmdArgType in,
+                    const Tango::CmdArgType out)
+            : Command(cmd_name, in, out)
+        {
+        };
+
+        ~HomeCommand() override = default;
+
+        CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
+
+        bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
+        {
+            return (dynamic_cast<Axis*>(dev))->is_home_allowed(any);
+        }
+    };
+
+    class DisableCommand final : public Tango::Command
+    {
+    public:
+        DisableCommand(const char* cmd_name,
+                       const Tango::CmdArgType in,
+                       const Tango::CmdArgType out,
+                       const char* in_desc,
+                       const char* out_desc,
+                       const Tango::DispLevel level)
+            : Command(cmd_name, in, out, in_desc, out_desc, level)
+        {
+        };
+
+        DisableCommand(const char* cmd_name,
+                       const Tango::CmdArgType in,
+                       const Tango::CmdArgType out)
+            : Command(cmd_name, in, out)
+        {
+        };
+
+        ~DisableCommand() override = default;
+
+        CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
+
+        bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
+        {
+            return (dynamic_cast<Axis*>(dev))->is_disable_allowed(any);
+        }
+    };
+
+    class FaultAckCommand final : public Tango::Command
+    {
+    public:
+        FaultAckCommand(const char* cmd_name,
+                        const Tango::CmdArgType in,
+                        const Tango::CmdArgType out,
+                        const char* in_desc,
+                        const char* out_desc,
+                        const Tango::DispLevel level)
+            : Command(cmd_name, in, out, in_desc, out_desc, level)
+        {
+        };
+
+        FaultAckCommand(const char* cmd_name,
+                        const Tango::CmdArgType in,
+                        const Tango::CmdArgType out)
+            : Command(cmd_name, in, out)
+        {
+        };
+
+        ~FaultAckCommand() override = default;
+
+        CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
+
+        bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
+        {
+            return (dynamic_cast<Axis*>(dev))->is_fault_ack_allowed(any);
+        }
+    };
+
+
+    class NotifyMotionDoneCommand final : public Tango::Command
+    {
+    public:
+        NotifyMotionDoneCommand(const char* cmd_name,
+                                const Tango::CmdArgType in,
+                                const Tango::CmdArgType out,
+                                const char* in_desc,
+                                const char* out_desc,
+                                const Tango::DispLevel level)
+            : Command(cmd_name, in, out, in_desc, out_desc, level)
+        {
+        };
+
+        NotifyMotionDoneCommand(const char* cmd_name,
+                                const Tango::CmdArgType in,
+                                const Tango::CmdArgType out)
+            : Command(cmd_name, in, out)
+        {
+        };
+
+        ~NotifyMotionDoneCommand() override = default;
+
+        CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
+
+        bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
+        {
+            return (dynamic_cast<Axis*>(dev))->is_notify_motion_done_allowed(any);
+        }
+    };
+
+    class MoveAndNotifyCommand final : public Tango::Command
+    {
+    public:
+        MoveAndNotifyCommand(const char* cmd_name,
+                             const Tango::CmdArgType in,
+                             const Tango::CmdArgType out,
+                             const char* in_desc,
+                             const char* out_desc,
+                             const Tango::DispLevel level)
+            : Command(cmd_name, in, out, in_desc, out_desc, level)
+        {
+        };
+
+        MoveAndNotifyCommand(const char* cmd_name,
+                             const Tango::CmdArgType in,
+                             const Tango::CmdArgType out)
+            : Command(cmd_name, in, out)
+        {
+        };
+
+        ~MoveAndNotifyCommand() override = default;
+
+        CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
+
+        bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
+        {
+            return (dynamic_cast<Axis*>(dev))->is_move_and_notify_allowed(any);
+        }
+    };
+
+    class PsoConfigureCommand final : public Tango::Command
+    {
+    public:
+        PsoConfigureCommand(const char* cmd_name,
+                            const Tango::CmdArgType in,
+                            const Tango::CmdArgType out,
+                            const char* in_desc,
+                            const char* out_desc,
+                            const Tango::DispLevel level)
+            : Command(cmd_name, in, out, in_desc, out_desc, level)
+        {
+        };
+
+        PsoConfigureCommand(const char* cmd_name,
+                            const Tango::CmdArgType in,
+                            const Tango::CmdArgType out)
+            : Command(cmd_name, in, out)
+        {
+        };
+
+        ~PsoConfigureCommand() override = default;
+
+        CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
+
+        bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
+        {
+            return (dynamic_cast<Axis*>(dev))->is_pso_allowed(any);
+        }
+    };
+
+    class PsoArmCommand final : public Tango::Command
+    {
+    public:
+        PsoArmCommand(const char* cmd_name,
                       const Tango::CmdArgType in,
                       const Tango::CmdArgType out,
                       const char* in_desc,
@@ -223,178 +945,297 @@ namespace Axis_ns
         {
         };
 
-        EnableCommand(const char* cmd_name,
+        PsoArmCommand(const char* cmd_name,
                       const Tango::CmdArgType in,
                       const Tango::CmdArgType out)
             : Command(cmd_name, in, out)
         {
         };
 
-        ~EnableCommand() override = default;
+        ~PsoArmCommand() override = default;
 
         CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
 
         bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
         {
-            return (dynamic_cast<Axis*>(dev))->is_enable_allowed(any);
+            return (dynamic_cast<Axis*>(dev))->is_pso_allowed(any);
         }
     };
 
+    class PsoDisarmCommand final : public Tango::Command
+    {
+    public:
+        PsoDisarmCommand(const char* cmd_name,
+                         const Tango::CmdArgType in,
+                         const Tango::CmdArgType out,
+                         const char* in_desc,
+                         const char* out_desc,
+                         const Tango::DispLevel level)
+            : Command(cmd_name, in, out, in_desc, out_desc, level)
+        {
+        };
+
+        PsoDisarmCommand(const char* cmd_name,
+                         const Tango::CmdArgType in,
+                         const Tango::CmdArgType out)
+            : Command(cmd_name, in, out)
+        {
+        };
+
+        ~PsoDisarmCommand() override = default;
 
-    class FaultAckAllCommand final : public Tango::Command
+        CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
+
+        bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
+        {
+            return true;
+        }
+    };
+
+    class TrajectoryLoadCommand final : public Tango::Command
     {
     public:
-        FaultAckAllCommand(const char* cmd_name,
-                           const Tango::CmdArgType in,
-                           const Tango::CmdArgType out,
-                           const char* in_desc,
-                           const char* out_desc,
-                           const Tango::DispLevel level)
+        TrajectoryLoadCommand(const char* cmd_name,
+                              const Tango::CmdArgType in,
+                              const Tango::CmdArgType out,
+                              const char* in_desc,
+                              const char* out_desc,
+                              const Tango::DispLevel level)
             : Command(cmd_name, in, out, in_desc, out_desc, level)
         {
         };
 
-        FaultAckAllCommand(const char* cmd_name,
-                           const Tango::CmdArgType in,
-                           const Tango::CmdArgType out)
+        TrajectoryLoadCommand(const char* cmd_name,
+                              const Tango::CmdArgType in,
+                              const Tango::CmdArgType out)
             : Command(cmd_name, in, out)
         {
         };
 
-        ~FaultAckAllCommand() override = default;
+        ~TrajectoryLoadCommand() override = default;
 
         CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
 
         bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
         {
-            return (dynamic_cast<Axis*>(dev))->is_faultack_all_allowed(any);
+            return (dynamic_cast<Axis*>(dev))->is_trajectory_allowed(any);
         }
     };
 
-    class FreerunCommand final : public Tango::Command
+    class TrajectoryStartCommand final : public Tango::Command
     {
     public:
-        FreerunCommand(const char* cmd_name,
-                       const Tango::CmdArgType in,
-                       const Tango::CmdArgType out,
-                       const char* in_desc,
-                       const char* out_desc,
-                       const Tango::DispLevel level)
+        TrajectoryStartCommand(const char* cmd_name,
+                               const Tango::CmdArgType in,
+                               const Tango::CmdArgType out,
+                               const char* in_desc,
+                               const char* out_desc,
+                               const Tango::DispLevel level)
             : Command(cmd_name, in, out, in_desc, out_desc, level)
         {
         };
 
-        FreerunCommand(const char* cmd_name,
-                       const Tango::CmdArgType in,
-                       const Tango::CmdArgType out)
+        TrajectoryStartCommand(const char* cmd_name,
+                               const Tango::CmdArgType in,
+                               const Tango::CmdArgType out)
             : Command(cmd_name, in, out)
         {
         };
 
-        ~FreerunCommand() override = default;
+        ~TrajectoryStartCommand() override = default;
 
         CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
 
         bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
         {
-            return (dynamic_cast<Axis*>(dev))->is_freerun_allowed(any);
+            return (dynamic_cast<Axis*>(dev))->is_trajectory_allowed(any);
         }
     };
 
-    class StopCommand final : public Tango::Command
+    class TrajectoryAbortCommand final : public Tango::Command
     {
     public:
-        StopCommand(const char* cmd_name,
-                    const Tango::CmdArgType in,
-                    const Tango::CmdArgType out,
-                    const char* in_desc,
-                    const char* out_desc,
-                    const Tango::DispLevel level)
+        TrajectoryAbortCommand(const char* cmd_name,
+                               const Tango::CmdArgType in,
+                               const Tango::CmdArgType out,
+                               const char* in_desc,
+                               const char* out_desc,
+                               const Tango::DispLevel level)
             : Command(cmd_name, in, out, in_desc, out_desc, level)
         {
         };
 
-        StopCommand(const char* cmd_name,
-                    const Tango::CmdArgType in,
-                    const Tango::CmdArgType out)
+        TrajectoryAbortCommand(const char* cmd_name,
+                               const Tango::CmdArgType in,
+                               const Tango::CmdArgType out)
             : Command(cmd_name, in, out)
         {
         };
 
-        ~StopCommand() override = default;
+        ~TrajectoryAbortCommand() override = default;
 
         CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
 
         bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
         {
-            return (dynamic_cast<Axis*>(dev))->is_stop_allowed(any);
+            return true;
         }
     };
 
-    class HomeCommand final : public Tango::Command
+    class StepScanStartCommand final : public Tango::Command
     {
     public:
-        HomeCommand(const char* cmd_name,
-                    const Tango::CmdArgType in,
-                    const Tango::CmdArgType out,
-                    const char* in_desc,
-                    const char* out_desc,
-                    const Tango::DispLevel level)
+        StepScanStartCommand(const char* cmd_name,
+                             const Tango::CmdArgType in,
+                             const Tango::CmdArgType out,
+                             const char* in_desc,
+                             const char* out_desc,
+                             const Tango::DispLevel level)
             : Command(cmd_name, in, out, in_desc, out_desc, level)
         {
         };
 
-        HomeCommand(const char* cmd_name,
-                    const Tango::CmdArgType in,
-                    const Tango::CmdArgType out)
+        StepScanStartCommand(const char* cmd_name,
+                             const Tango::CmdArgType in,
+                             const Tango::CmdArgType out)
             : Command(cmd_name, in, out)
         {
         };
 
-        ~HomeCommand() override = default;
+        ~StepScanStartCommand() override = default;
 
         CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
 
         bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
         {
-            return (dynamic_cast<Axis*>(dev))->is_home_allowed(any);
+            return (dynamic_cast<Axis*>(dev))->is_step_scan_start_allowed(any);
         }
     };
 
-    class DisableCommand final : public Tango::Command
+    class StepScanAbortCommand final : public Tango::Command
     {
     public:
-        DisableCommand(const char* cmd_name,
-                       const Tango::CmdArgType in,
-                       const Tango::CmdArgType out,
-                       const char* in_desc,
-                       const char* out_desc,
-                       const Tango::DispLevel level)
+        StepScanAbortCommand(const char* cmd_name,
+                             const Tango::CmdArgType in,
+                             const Tango::CmdArgType out,
+                             const char* in_desc,
+                             const char* out_desc,
+                             const Tango::DispLevel level)
             : Command(cmd_name, in, out, in_desc, out_desc, level)
         {
         };
 
-        DisableCommand(const char* cmd_name,
-                       const Tango::CmdArgType in,
-                       const Tango::CmdArgType out)
+        StepScanAbortCommand(const char* cmd_name,
+                             const Tango::CmdArgType in,
+                             const Tango::CmdArgType out)
             : Command(cmd_name, in, out)
         {
         };
 
-        ~DisableCommand() override = default;
+        ~StepScanAbortCommand() override = default;
 
         CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
 
         bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
         {
-            return (dynamic_cast<Axis*>(dev))->is_disable_allowed(any);
+            return true;
         }
     };
 
-    class FaultAckCommand final : public Tango::Command
+    class CaptureArmCommand final : public Tango::Command
     {
     public:
-        FaultAckCommand(const char* cmd_name,
+        CaptureArmCommand(const char* cmd_name,
+                          const Tango::CmdArgType in,
+                          const Tango::CmdArgType out,
+                          const char* in_desc,
+                          const char* out_desc,
+                          const Tango::DispLevel level)
+            : Command(cmd_name, in, out, in_desc, out_desc, level)
+        {
+        };
+
+        CaptureArmCommand(const char* cmd_name,
+                          const Tango::CmdArgType in,
+                          const Tango::CmdArgType out)
+            : Command(cmd_name, in, out)
+        {
+        };
+
+        ~CaptureArmCommand() override = default;
+
+        CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
+
+        bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
+        {
+            return true;
+        }
+    };
+
+    class CaptureDisarmCommand final : public Tango::Command
+    {
+    public:
+        CaptureDisarmCommand(const char* cmd_name,
+                             const Tango::CmdArgType in,
+                             const Tango::CmdArgType out,
+                             const char* in_desc,
+                             const char* out_desc,
+                             const Tango::DispLevel level)
+            : Command(cmd_name, in, out, in_desc, out_desc, level)
+        {
+        };
+
+        CaptureDisarmCommand(const char* cmd_name,
+                             const Tango::CmdArgType in,
+                             const Tango::CmdArgType out)
+            : Command(cmd_name, in, out)
+        {
+        };
+
+        ~CaptureDisarmCommand() override = default;
+
+        CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
+
+        bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
+        {
+            return true;
+        }
+    };
+
+    class VelocityStreamStopCommand final : public Tango::Command
+    {
+    public:
+        VelocityStreamStopCommand(const char* cmd_name,
+                                  const Tango::CmdArgType in,
+                                  const Tango::CmdArgType out,
+                                  const char* in_desc,
+                                  const char* out_desc,
+                                  const Tango::DispLevel level)
+            : Command(cmd_name, in, out, in_desc, out_desc, level)
+        {
+        };
+
+        VelocityStreamStopCommand(const char* cmd_name,
+                                  const Tango::CmdArgType in,
+                                  const Tango::CmdArgType out)
+            : Command(cmd_name, in, out)
+        {
+        };
+
+        ~VelocityStreamStopCommand() override = default;
+
+        CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
+
+        bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
+        {
+            return true;
+        }
+    };
+
+    class WatchAddCommand final : public Tango::Command
+    {
+    public:
+        WatchAddCommand(const char* cmd_name,
                         const Tango::CmdArgType in,
                         const Tango::CmdArgType out,
                         const char* in_desc,
@@ -404,23 +1245,82 @@ namespace Axis_ns
         {
         };
 
-        FaultAckCommand(const char* cmd_name,
+        WatchAddCommand(const char* cmd_name,
                         const Tango::CmdArgType in,
                         const Tango::CmdArgType out)
             : Command(cmd_name, in, out)
         {
         };
 
-        ~FaultAckCommand() override = default;
+        ~WatchAddCommand() override = default;
 
         CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
 
         bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
         {
-            return (dynamic_cast<Axis*>(dev))->is_fault_ack_allowed(any);
+            return (dynamic_cast<Axis*>(dev))->is_watch_allowed(any);
+        }
+    };
+
+    class WatchRemoveCommand final : public Tango::Command
+    {
+    public:
+        WatchRemoveCommand(const char* cmd_name,
+                           const Tango::CmdArgType in,
+                           const Tango::CmdArgType out,
+                           const char* in_desc,
+                           const char* out_desc,
+                           const Tango::DispLevel level)
+            : Command(cmd_name, in, out, in_desc, out_desc, level)
+        {
+        };
+
+        WatchRemoveCommand(const char* cmd_name,
+                           const Tango::CmdArgType in,
+                           const Tango::CmdArgType out)
+            : Command(cmd_name, in, out)
+        {
+        };
+
+        ~WatchRemoveCommand() override = default;
+
+        CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
+
+        bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
+        {
+            return (dynamic_cast<Axis*>(dev))->is_watch_allowed(any);
         }
     };
 
+    class WatchListCommand final : public Tango::Command
+    {
+    public:
+        WatchListCommand(const char* cmd_name,
+                         const Tango::CmdArgType in,
+                         const Tango::CmdArgType out,
+                         const char* in_desc,
+                         const char* out_desc,
+                         const Tango::DispLevel level)
+            : Command(cmd_name, in, out, in_desc, out_desc, level)
+        {
+        };
+
+        WatchListCommand(const char* cmd_name,
+                         const Tango::CmdArgType in,
+                         const Tango::CmdArgType out)
+            : Command(cmd_name, in, out)
+        {
+        };
+
+        ~WatchListCommand() override = default;
+
+        CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
+
+        bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
+        {
+            return true;
+        }
+    };
 
     class AxisClass final : public Tango::DeviceClass
     {
@@ -429,6 +1329,10 @@ namespace Axis_ns
         Tango::DbData cl_def_prop;
         Tango::DbData dev_def_prop;
 
+        // Set while the device factory creates the devices. The controller dependent part of init_device is then
+        // run afterwards on the device init pool.
+        bool deferred_init{false};
+
         static AxisClass* init(const char*);
 
         static AxisClass* instance();
@@ -19,6 +19,7 @@
 #define AUTOMATION1_BISS_ENCODER_H
 
 #include <tango/tango.h>
+#include "Sampler.h"
 
 
 namespace BissEncoder_ns
@@ -44,6 +45,10 @@ namespace BissEncoder_ns
 
         void init_device() override;
 
+        void init_hardware();
+
+        void set_init_error(const std::string& error);
+
         void get_device_property();
 
         void always_executed_hook() override;
@@ -56,6 +61,20 @@ namespace BissEncoder_ns
 
         void read_position(Tango::Attribute& attribute);
 
+        void read_position_mean(Tango::Attribute& attribute);
+
+        void read_position_median(Tango::Attribute& attribute);
+
+        void read_position_min(Tango::Attribute& attribute);
+
+        void read_position_max(Tango::Attribute& attribute);
+
+        void read_position_std(Tango::Attribute& attribute);
+
+        void read_position_ema(Tango::Attribute& attribute);
+
+        void read_sample_count(Tango::Attribute& attribute);
+
         bool is_position_allowed(Tango::AttReqType type);
 
     private:
@@ -63,15 +82,46 @@ namespace BissEncoder_ns
 
         [[nodiscard]] double user_unit_to_counts(double user_unit) const;
 
+        // Computes the statistics attributes from the sample window of the encoder.
+        void update_statistics();
+
         int axisID{};
 
+        bool sampled{false};
+
+        // CountsPerUnit of the axis, read once at init.
+        double countsPerUnit{1.};
+
         std::string axisName{};
 
         double scale{};
 
         double offset{};
 
+        double sampling_rate{};
+
+        Tango::DevLong filter_window{100};
+
+        double ema_time_constant{1.};
+
+        struct Statistics
+        {
+            Tango::DevDouble mean{};
+            Tango::DevDouble median{};
+            Tango::DevDouble min{};
+            Tango::DevDouble max{};
+            Tango::DevDouble std{};
+            Tango::DevDouble ema{};
+            Tango::DevLong count{};
+        } statistics;
+
+        std::vector<Controller_ns::EncoderSnapshot> samples{};
+
+        std::vector<double> values{};
+
         std::string status{};
+
+        std::string init_error{};
     };
 }
 #endif   //	AUTOMATION1_BISS_ENCODER_H
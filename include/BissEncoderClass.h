@@ -44,6 +44,104 @@ namespace BissEncoder_ns
         }
     };
 
+    class positionMeanAttrib final : public Tango::Attr
+    {
+    public:
+        positionMeanAttrib() : Attr("position_mean",
+                                     Tango::DEV_DOUBLE, Tango::READ)
+        {
+        };
+
+        ~positionMeanAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<BissEncoder*>(dev))->read_position_mean(att); }
+    };
+
+    class positionMedianAttrib final : public Tango::Attr
+    {
+    public:
+        positionMedianAttrib() : Attr("position_median",
+                                       Tango::DEV_DOUBLE, Tango::READ)
+        {
+        };
+
+        ~positionMedianAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<BissEncoder*>(dev))->read_position_median(att); }
+    };
+
+    class positionMinAttrib final : public Tango::Attr
+    {
+    public:
+        positionMinAttrib() : Attr("position_min",
+                                    Tango::DEV_DOUBLE, Tango::READ)
+        {
+        };
+
+        ~positionMinAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<BissEncoder*>(dev))->read_position_min(att); }
+    };
+
+    class positionMaxAttrib final : public Tango::Attr
+    {
+    public:
+        positionMaxAttrib() : Attr("position_max",
+                                    Tango::DEV_DOUBLE, Tango::READ)
+        {
+        };
+
+        ~positionMaxAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<BissEncoder*>(dev))->read_position_max(att); }
+    };
+
+    class positionStdAttrib final : public Tango::Attr
+    {
+    public:
+        positionStdAttrib() : Attr("position_std",
+                                    Tango::DEV_DOUBLE, Tango::READ)
+        {
+        };
+
+        ~positionStdAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<BissEncoder*>(dev))->read_position_std(att); }
+    };
+
+    class positionEmaAttrib final : public Tango::Attr
+    {
+    public:
+        positionEmaAttrib() : Attr("position_ema",
+                                    Tango::DEV_DOUBLE, Tango::READ)
+        {
+        };
+
+        ~positionEmaAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<BissEncoder*>(dev))->read_position_ema(att); }
+    };
+
+    class sampleCountAttrib final : public Tango::Attr
+    {
+    public:
+        sampleCountAttrib() : Attr("sample_count",
+                                    Tango::DEV_LONG, Tango::READ)
+        {
+        };
+
+        ~sampleCountAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<BissEncoder*>(dev))->read_sample_count(att); }
+    };
+
     class BissEncoderClass final : public Tango::DeviceClass
     {
     public:
@@ -51,6 +149,10 @@ namespace BissEncoder_ns
         Tango::DbData cl_def_prop;
         Tango::DbData dev_def_prop;
 
+        // Set while the device factory creates the devices. The controller dependent part of init_device is then
+        // run afterwards on the device init pool.
+        bool deferred_init{false};
+
         static BissEncoderClass* init(const char*);
 
         static BissEncoderClass* instance();
@@ -0,0 +1,73 @@
+/*
+ * Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUTOMATION1_CLOCK_SYNC_H
+#define AUTOMATION1_CLOCK_SYNC_H
+
+#include <chrono>
+#include <deque>
+
+
+namespace Controller_ns
+{
+    /*
+     * Maps the controller timer to host time. Every status query gives a pair of controller time and the host time
+     * window the query was answered in. A line host = offset + rate * controller is fitted through the pairs with
+     * the shortest query delay, which are the ones closest to the true sample time.
+     */
+    class ClockSync
+    {
+    public:
+        using Clock = std::chrono::system_clock;
+
+        // Adds a sample and returns the host time of the controller time.
+        Clock::time_point update(double controller_time, Clock::time_point before, Clock::time_point after);
+
+        // Host minus controller time in seconds at the latest sample.
+        [[nodiscard]] double offset() const { return latest_offset; }
+
+        // Relative rate difference of the two clocks (host / controller - 1).
+        [[nodiscard]] double drift() const { return rate - 1.; }
+
+        [[nodiscard]] bool is_locked() const { return locked; }
+
+    private:
+        struct Point
+        {
+            double controller;
+            double host;
+            double delay;
+        };
+
+        void fit();
+
+        std::deque<Point> points;
+
+        double reference_controller{};
+
+        double reference_host{};
+
+        double intercept{};
+
+        double rate{1.};
+
+        double latest_offset{};
+
+        bool locked{false};
+    };
+}
+#endif   //	AUTOMATION1_CLOCK_SYNC_H
@@ -0,0 +1,81 @@
+/*
+ * Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUTOMATION1_COMMAND_BATCH_H
+#define AUTOMATION1_COMMAND_BATCH_H
+
+#include <set>
+#include <string>
+#include <vector>
+#include "Automation1.h"
+#include "FlightRecorder.h"
+
+
+namespace Controller_ns
+{
+    struct BatchOperation
+    {
+        enum Kind { Enable, Disable, FaultAck, Move, Parameter };
+
+        Kind kind{};
+        int axisID{};
+        double position{};
+        double velocity{};
+        Automation1AxisParameterId parameter{};
+        double value{};
+    };
+
+    /*
+     * A list of axis operations executed with a single acquisition of the controller lock. Consecutive operations of
+     * the same kind (enable, disable, fault_ack, move) are merged into one multi-axis call. Each operation is given
+     * as one string:
+     *
+     *   enable <axis> | disable <axis> | fault_ack <axis> | move <axis> <position> <velocity> |
+     *   param <axis> <name or id> <value>
+     *
+     * A batch containing an invalid operation is not executed at all. Otherwise execution stops at the first failing
+     * call and all later operations are reported as skipped.
+     */
+    class CommandBatch
+    {
+    public:
+        // Parses the operations and resolves the axis names. The controller lock must be held by the caller.
+        CommandBatch(Automation1Controller controller, const std::vector<std::string>& operations);
+
+        // The controller lock must be held by the caller. The axis commands are written to recorder.
+        void execute(FlightRecorder& recorder);
+
+        // One entry per operation: "OK", "SKIPPED" or "ERROR: <reason>".
+        [[nodiscard]] const std::vector<std::string>& results() const { return result; }
+
+        [[nodiscard]] const std::set<int>& axes() const { return touched; }
+
+    private:
+        [[nodiscard]] BatchOperation parse(const std::string& text) const;
+
+        Automation1Controller controller;
+
+        std::vector<BatchOperation> ops;
+
+        std::vector<std::size_t> index;
+
+        std::vector<std::string> result;
+
+        std::set<int> touched;
+    };
+}
+#endif   //	AUTOMATION1_COMMAND_BATCH_H
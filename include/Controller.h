@@ -19,6 +19,12 @@
 #define AUTOMATION1_CONTROLLER_H
 
 #include <tango/tango.h>
+#include <condition_variable>
+#include <thread>
+#include "Automation1.h"
+#include "DriveTelemetry.h"
+#include "EventPusher.h"
+#include "WatchSet.h"
 
 
 namespace Controller_ns {
@@ -26,10 +32,32 @@ namespace Controller_ns {
     class Controller final : public TANGO_BASE_CLASS {
     public:
         std::string ip_address {"127.0.0.1"};
+        Tango::DevDouble fast_sampling_rate {50.};
+        Tango::DevDouble slow_sampling_rate {2.};
+        std::string program_cache_dir {};
+        std::vector<Tango::DevLong> global_real_range {0, 0};
+        std::vector<Tango::DevLong> global_integer_range {0, 0};
+        Tango::DevDouble global_poll_rate {10.};
+        Tango::DevDouble telemetry_rate {1.};
+        Tango::DevDouble io_poll_rate {20.};
+        std::string flight_recorder_file {};
+        Tango::DevLong flight_recorder_records {262144};
+        Tango::DevDouble flight_recorder_snapshot_period {1.};
+        std::string trace_export_dir {};
         Tango::DevString *attr_api_version_read{};
         Tango::DevShort *attr_available_axis_count_read{};
         Tango::DevShort *attr_available_task_count_read{};
         Tango::DevBoolean *attr_is_running_read{};
+        Tango::DevDouble *attr_startup_time_read{};
+        Tango::DevDouble *attr_status_query_rate_read{};
+        Tango::DevDouble *attr_clock_offset_read{};
+        Tango::DevDouble *attr_clock_drift_read{};
+        Tango::DevDouble *attr_servo_loop_utilization_read{};
+        Tango::DevDouble *attr_cpu_utilization_read{};
+        Tango::DevDouble *attr_data_collection_usage_read{};
+        Tango::DevDouble *attr_controller_response_time_read{};
+        Tango::DevBoolean *attr_tracing_read{};
+        Tango::DevLong64 *attr_trace_dropped_read{};
 
         Controller(Tango::DeviceClass *cl, const std::string &s);
 
@@ -65,6 +93,122 @@ namespace Controller_ns {
 
         void available_task_count( Tango::Attribute & att) const;
 
+        void read_startup_time( Tango::Attribute & att) const;
+
+        void read_status_query_rate( Tango::Attribute & att) const;
+
+        void read_clock_offset( Tango::Attribute & att) const;
+
+        void read_clock_drift( Tango::Attribute & att) const;
+
+        Tango::DevVarStringArray *execute_batch(const Tango::DevVarStringArray *arg_in);
+
+        bool is_execute_batch_allowed(const CORBA::Any &any);
+
+        Tango::DevString program_compile(Tango::DevString source);
+
+        void program_load(const Tango::DevVarLongStringArray *arg_in);
+
+        void program_run(const Tango::DevVarLongStringArray *arg_in);
+
+        void program_start(Tango::DevLong task);
+
+        void program_stop(Tango::DevLong task);
+
+        bool is_program_allowed(const CORBA::Any &any);
+
+        void read_task_status( Tango::Attribute & att);
+
+        void read_servo_loop_utilization( Tango::Attribute & att);
+
+        void read_cpu_utilization( Tango::Attribute & att);
+
+        void read_data_collection_usage( Tango::Attribute & att);
+
+        void read_controller_response_time( Tango::Attribute & att);
+
+        void read_task_queue_depth( Tango::Attribute & att);
+
+        void read_task_queue_capacity( Tango::Attribute & att);
+
+        void read_global_reals( Tango::Attribute & att);
+
+        void write_global_reals( Tango::WAttribute & att);
+
+        void read_global_integers( Tango::Attribute & att);
+
+        void write_global_integers( Tango::WAttribute & att);
+
+        // arg_in: [name, expression]. Every field has to name its axis, e.g. X.position.
+        void watch_add(const Tango::DevVarStringArray *arg_in);
+
+        void watch_remove(Tango::DevString name);
+
+        Tango::DevVarStringArray *watch_list();
+
+        bool is_watch_allowed(const CORBA::Any &any);
+
+        void read_watch( Tango::Attribute & att);
+
+        void read_tracing( Tango::Attribute & att);
+
+        void write_tracing( Tango::WAttribute & att);
+
+        void read_trace_dropped( Tango::Attribute & att);
+
+        // Writes the recorded trace events as Chrome trace JSON and returns their number.
+        Tango::DevLong trace_export(Tango::DevString file_name);
+
+    private:
+        static std::pair<int, std::string> get_program_argument(const Tango::DevVarLongStringArray *arg_in);
+
+        static void check_task(int task);
+
+        Automation1StatusConfig task_config{};
+
+        int task_config_count{};
+
+        std::vector<std::string> task_status;
+
+        std::vector<Tango::DevString> task_status_read;
+
+        // Taken once per read request, so the load attributes of one request come from the same query.
+        ControllerLoad load{};
+
+        std::vector<Tango::DevLong> task_queue_depth_read;
+
+        std::vector<Tango::DevLong> task_queue_capacity_read;
+
+        void check_load() const;
+
+        // Opens the journal of the flight recorder, once per server run.
+        void open_flight_recorder();
+
+        void start_global_watch();
+
+        void stop_global_watch();
+
+        void watch_globals();
+
+        std::vector<double> global_reals_read;
+
+        std::vector<std::int64_t> global_integers_values;
+
+        std::vector<Tango::DevLong64> global_integers_read;
+
+        std::thread global_thread;
+
+        std::mutex global_mutex;
+
+        std::condition_variable global_cv;
+
+        bool global_watch{false};
+
+        std::unique_ptr<WatchSet> watches{};
+
+        // Change events pushed from the global variable watch.
+        std::unique_ptr<EventPusher> events{};
+
     };
 
 }
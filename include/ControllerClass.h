@@ -23,6 +23,12 @@
 #include "Controller.h"
 #include <memory>
 #include "Automation1.h"
+#include "DriveTelemetry.h"
+#include "FlightRecorder.h"
+#include "GlobalVariables.h"
+#include "IoScanner.h"
+#include "ProgramCache.h"
+#include "Sampler.h"
 
 
 namespace Controller_ns
@@ -83,10 +89,544 @@ namespace Controller_ns
                   Tango::Attribute& att) override { (dynamic_cast<Controller*>(dev))->available_task_count(att); }
     };
 
+    class status_query_rateAttrib final : public Tango::Attr
+    {
+    public:
+        status_query_rateAttrib() : Attr("status_query_rate",
+                                         Tango::DEV_DOUBLE, Tango::READ)
+        {
+        };
+
+        ~status_query_rateAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Controller*>(dev))->read_status_query_rate(att); }
+    };
+
+    class startup_timeAttrib final : public Tango::Attr
+    {
+    public:
+        startup_timeAttrib() : Attr("startup_time",
+                                    Tango::DEV_DOUBLE, Tango::READ)
+        {
+        };
+
+        ~startup_timeAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Controller*>(dev))->read_startup_time(att); }
+    };
+
+    class global_realsAttrib final : public Tango::SpectrumAttr
+    {
+    public:
+        global_realsAttrib() : SpectrumAttr("global_reals",
+                                            Tango::DEV_DOUBLE, Tango::READ_WRITE, 4096)
+        {
+        };
+
+        ~global_realsAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Controller*>(dev))->read_global_reals(att); }
+
+        void write(Tango::DeviceImpl* dev,
+                   Tango::WAttribute& att) override { (dynamic_cast<Controller*>(dev))->write_global_reals(att); }
+    };
+
+    class global_integersAttrib final : public Tango::SpectrumAttr
+    {
+    public:
+        global_integersAttrib() : SpectrumAttr("global_integers",
+                                               Tango::DEV_LONG64, Tango::READ_WRITE, 4096)
+        {
+        };
+
+        ~global_integersAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Controller*>(dev))->read_global_integers(att); }
+
+        void write(Tango::DeviceImpl* dev,
+                   Tango::WAttribute& att) override { (dynamic_cast<Controller*>(dev))->write_global_integers(att); }
+    };
+
+    class ExecuteBatchCommand final : public Tango::Command
+    {
+    public:
+        ExecuteBatchCommand(const char* cmd_name,
+                            const Tango::CmdArgType in,
+                            const Tango::CmdArgType out,
+                            const char* in_desc,
+                            const char* out_desc,
+                            const Tango::DispLevel level)
+            : Command(cmd_name, in, out, in_desc, out_desc, level)
+        {
+        };
+
+        ExecuteBatchCommand(const char* cmd_name,
+                            const Tango::CmdArgType in,
+                            const Tango::CmdArgType out)
+            : Command(cmd_name, in, out)
+        {
+        };
+
+        ~ExecuteBatchCommand() override = default;
+
+        CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
+
+        bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
+        {
+            return (dynamic_cast<Controller*>(dev))->is_execute_batch_allowed(any);
+        }
+    };
+
+    class clock_offsetAttrib final : public Tango::Attr
+    {
+    public:
+        clock_offsetAttrib() : Attr("clock_offset",
+                                   Tango::DEV_DOUBLE, Tango::READ)
+        {
+        };
+
+        ~clock_offsetAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Controller*>(dev))->read_clock_offset(att); }
+    };
+
+    class clock_driftAttrib final : public Tango::Attr
+    {
+    public:
+        clock_driftAttrib() : Attr("clock_drift",
+                                  Tango::DEV_DOUBLE, Tango::READ)
+        {
+        };
+
+        ~clock_driftAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Controller*>(dev))->read_clock_drift(att); }
+    };
+
+    class task_statusAttrib final : public Tango::SpectrumAttr
+    {
+    public:
+        task_statusAttrib() : SpectrumAttr("task_status",
+                                           Tango::DEV_STRING, Tango::READ, 32)
+        {
+        };
+
+        ~task_statusAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Controller*>(dev))->read_task_status(att); }
+    };
+
+    class servo_loop_utilizationAttrib final : public Tango::Attr
+    {
+    public:
+        servo_loop_utilizationAttrib() : Attr("servo_loop_utilization",
+                                              Tango::DEV_DOUBLE, Tango::READ)
+        {
+        };
+
+        ~servo_loop_utilizationAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Controller*>(dev))->read_servo_loop_utilization(att); }
+    };
+
+    class cpu_utilizationAttrib final : public Tango::Attr
+    {
+    public:
+        cpu_utilizationAttrib() : Attr("cpu_utilization",
+                                       Tango::DEV_DOUBLE, Tango::READ)
+        {
+        };
+
+        ~cpu_utilizationAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Controller*>(dev))->read_cpu_utilization(att); }
+    };
+
+    class data_collection_usageAttrib final : public Tango::Attr
+    {
+    public:
+        data_collection_usageAttrib() : Attr("data_collection_usage",
+                                             Tango::DEV_DOUBLE, Tango::READ)
+        {
+        };
+
+        ~data_collection_usageAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Controller*>(dev))->read_data_collection_usage(att); }
+    };
+
+    class controller_response_timeAttrib final : public Tango::Attr
+    {
+    public:
+        controller_response_timeAttrib() : Attr("controller_response_time",
+                                                Tango::DEV_DOUBLE, Tango::READ)
+        {
+        };
+
+        ~controller_response_timeAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Controller*>(dev))->read_controller_response_time(att); }
+    };
+
+    class task_queue_depthAttrib final : public Tango::SpectrumAttr
+    {
+    public:
+        task_queue_depthAttrib() : SpectrumAttr("task_queue_depth",
+                                                Tango::DEV_LONG, Tango::READ, 32)
+        {
+        };
+
+        ~task_queue_depthAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Controller*>(dev))->read_task_queue_depth(att); }
+    };
+
+    class task_queue_capacityAttrib final : public Tango::SpectrumAttr
+    {
+    public:
+        task_queue_capacityAttrib() : SpectrumAttr("task_queue_capacity",
+                                                   Tango::DEV_LONG, Tango::READ, 32)
+        {
+        };
+
+        ~task_queue_capacityAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Controller*>(dev))->read_task_queue_capacity(att); }
+    };
+
+    class tracingAttrib final : public Tango::Attr
+    {
+    public:
+        tracingAttrib() : Attr("tracing",
+                               Tango::DEV_BOOLEAN, Tango::READ_WRITE)
+        {
+        };
+
+        ~tracingAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Controller*>(dev))->read_tracing(att); }
+
+        void write(Tango::DeviceImpl* dev,
+                   Tango::WAttribute& att) override { (dynamic_cast<Controller*>(dev))->write_tracing(att); }
+    };
+
+    class trace_droppedAttrib final : public Tango::Attr
+    {
+    public:
+        trace_droppedAttrib() : Attr("trace_dropped",
+                                     Tango::DEV_LONG64, Tango::READ)
+        {
+        };
+
+        ~trace_droppedAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Controller*>(dev))->read_trace_dropped(att); }
+    };
+
+    // Dynamic attribute of a watch added with watchAdd.
+    class watchAttrib final : public Tango::Attr
+    {
+    public:
+        explicit watchAttrib(const std::string& name) : Attr(name.c_str(),
+                                                             Tango::DEV_BOOLEAN, Tango::READ)
+        {
+        };
+
+        ~watchAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<Controller*>(dev))->read_watch(att); }
+    };
+
+    class ProgramCompileCommand final : public Tango::Command
+    {
+    public:
+        ProgramCompileCommand(const char* cmd_name,
+                              const Tango::CmdArgType in,
+                              const Tango::CmdArgType out,
+                              const char* in_desc,
+                              const char* out_desc,
+                              const Tango::DispLevel level)
+            : Command(cmd_name, in, out, in_desc, out_desc, level)
+        {
+        };
+
+        ProgramCompileCommand(const char* cmd_name,
+                              const Tango::CmdArgType in,
+                              const Tango::CmdArgType out)
+            : Command(cmd_name, in, out)
+        {
+        };
+
+        ~ProgramCompileCommand() override = default;
+
+        CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
+
+        bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
+        {
+            return (dynamic_cast<Controller*>(dev))->is_program_allowed(any);
+        }
+    };
+
+    class ProgramLoadCommand final : public Tango::Command
+    {
+    public:
+        ProgramLoadCommand(const char* cmd_name,
+                           const Tango::CmdArgType in,
+                           const Tango::CmdArgType out,
+                           const char* in_desc,
+                           const char* out_desc,
+                           const Tango::DispLevel level)
+            : Command(cmd_name, in, out, in_desc, out_desc, level)
+        {
+        };
+
+        ProgramLoadCommand(const char* cmd_name,
+                           const Tango::CmdArgType in,
+                           const Tango::CmdArgType out)
+            : Command(cmd_name, in, out)
+        {
+        };
+
+        ~ProgramLoadCommand() override = default;
+
+        CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
+
+        bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
+        {
+            return (dynamic_cast<Controller*>(dev))->is_program_allowed(any);
+        }
+    };
+
+    class ProgramRunCommand final : public Tango::Command
+    {
+    public:
+        ProgramRunCommand(const char* cmd_name,
+                          const Tango::CmdArgType in,
+                          const Tango::CmdArgType out,
+                          const char* in_desc,
+                          const char* out_desc,
+                          const Tango::DispLevel level)
+            : Command(cmd_name, in, out, in_desc, out_desc, level)
+        {
+        };
+
+        ProgramRunCommand(const char* cmd_name,
+                          const Tango::CmdArgType in,
+                          const Tango::CmdArgType out)
+            : Command(cmd_name, in, out)
+        {
+        };
+
+        ~ProgramRunCommand() override = default;
+
+        CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
+
+        bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
+        {
+            return (dynamic_cast<Controller*>(dev))->is_program_allowed(any);
+        }
+    };
+
+    class ProgramStartCommand final : public Tango::Command
+    {
+    public:
+        ProgramStartCommand(const char* cmd_name,
+                            const Tango::CmdArgType in,
+                            const Tango::CmdArgType out,
+                            const char* in_desc,
+                            const char* out_desc,
+                            const Tango::DispLevel level)
+            : Command(cmd_name, in, out, in_desc, out_desc, level)
+        {
+        };
+
+        ProgramStartCommand(const char* cmd_name,
+                            const Tango::CmdArgType in,
+                            const Tango::CmdArgType out)
+            : Command(cmd_name, in, out)
+        {
+        };
+
+        ~ProgramStartCommand() override = default;
+
+        CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
+
+        bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
+        {
+            return (dynamic_cast<Controller*>(dev))->is_program_allowed(any);
+        }
+    };
+
+    class ProgramStopCommand final : public Tango::Command
+    {
+    public:
+        ProgramStopCommand(const char* cmd_name,
+                           const Tango::CmdArgType in,
+                           const Tango::CmdArgType out,
+                           const char* in_desc,
+                           const char* out_desc,
+                           const Tango::DispLevel level)
+            : Command(cmd_name, in, out, in_desc, out_desc, level)
+        {
+        };
+
+        ProgramStopCommand(const char* cmd_name,
+                           const Tango::CmdArgType in,
+                           const Tango::CmdArgType out)
+            : Command(cmd_name, in, out)
+        {
+        };
+
+        ~ProgramStopCommand() override = default;
+
+        CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
+
+        bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
+        {
+            return (dynamic_cast<Controller*>(dev))->is_program_allowed(any);
+        }
+    };
+
 #ifdef _TG_WINDOWS_
     class __declspec(dllexport)  ControllerClass : public Tango::DeviceClass
 #else
 
+    class WatchAddCommand final : public Tango::Command
+    {
+    public:
+        WatchAddCommand(const char* cmd_name,
+                        const Tango::CmdArgType in,
+                        const Tango::CmdArgType out,
+                        const char* in_desc,
+                        const char* out_desc,
+                        const Tango::DispLevel level)
+            : Command(cmd_name, in, out, in_desc, out_desc, level)
+        {
+        };
+
+        WatchAddCommand(const char* cmd_name,
+                        const Tango::CmdArgType in,
+                        const Tango::CmdArgType out)
+            : Command(cmd_name, in, out)
+        {
+        };
+
+        ~WatchAddCommand() override = default;
+
+        CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
+
+        bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
+        {
+            return (dynamic_cast<Controller*>(dev))->is_watch_allowed(any);
+        }
+    };
+
+    class WatchRemoveCommand final : public Tango::Command
+    {
+    public:
+        WatchRemoveCommand(const char* cmd_name,
+                           const Tango::CmdArgType in,
+                           const Tango::CmdArgType out,
+                           const char* in_desc,
+                           const char* out_desc,
+                           const Tango::DispLevel level)
+            : Command(cmd_name, in, out, in_desc, out_desc, level)
+        {
+        };
+
+        WatchRemoveCommand(const char* cmd_name,
+                           const Tango::CmdArgType in,
+                           const Tango::CmdArgType out)
+            : Command(cmd_name, in, out)
+        {
+        };
+
+        ~WatchRemoveCommand() override = default;
+
+        CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
+
+        bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
+        {
+            return (dynamic_cast<Controller*>(dev))->is_watch_allowed(any);
+        }
+    };
+
+    class WatchListCommand final : public Tango::Command
+    {
+    public:
+        WatchListCommand(const char* cmd_name,
+                         const Tango::CmdArgType in,
+                         const Tango::CmdArgType out,
+                         const char* in_desc,
+                         const char* out_desc,
+                         const Tango::DispLevel level)
+            : Command(cmd_name, in, out, in_desc, out_desc, level)
+        {
+        };
+
+        WatchListCommand(const char* cmd_name,
+                         const Tango::CmdArgType in,
+                         const Tango::CmdArgType out)
+            : Command(cmd_name, in, out)
+        {
+        };
+
+        ~WatchListCommand() override = default;
+
+        CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
+
+        bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
+        {
+            return true;
+        }
+    };
+
+    class TraceExportCommand final : public Tango::Command
+    {
+    public:
+        TraceExportCommand(const char* cmd_name,
+                           const Tango::CmdArgType in,
+                           const Tango::CmdArgType out,
+                           const char* in_desc,
+                           const char* out_desc,
+                           const Tango::DispLevel level)
+            : Command(cmd_name, in, out, in_desc, out_desc, level)
+        {
+        };
+
+        TraceExportCommand(const char* cmd_name,
+                           const Tango::CmdArgType in,
+                           const Tango::CmdArgType out)
+            : Command(cmd_name, in, out)
+        {
+        };
+
+        ~TraceExportCommand() override = default;
+
+        CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
+
+        bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
+        {
+            return true;
+        }
+    };
+
     class ControllerClass final : public Tango::DeviceClass
 #endif
     {
@@ -111,6 +651,23 @@ namespace Controller_ns
 
         std::mutex mutex;
 
+        FlightRecorder recorder;
+
+        Sampler sampler{controller, mutex, recorder};
+
+        DriveTelemetry telemetry{controller, mutex};
+
+        IoScanner io{controller, mutex};
+
+        ProgramCache programs;
+
+        GlobalReals global_reals{controller, mutex};
+
+        GlobalIntegers global_integers{controller, mutex};
+
+        // Accumulated time spent in the device factories of the axis and encoder classes in seconds.
+        double startup_time{};
+
     protected:
         explicit ControllerClass(const std::string&);
 
@@ -0,0 +1,35 @@
+/*
+ * Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUTOMATION1_DEVICE_INIT_H
+#define AUTOMATION1_DEVICE_INIT_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+
+namespace Controller_ns
+{
+    /*
+     * Runs the controller dependent part of the device initialisation in device order. A failing device does not stop
+     * the others, its error is collected, so it can be reported in the status of the device.
+     * Returns one error message per index of task(0) ... task(count - 1), empty on success.
+     */
+    std::vector<std::string> init_devices(std::size_t count, const std::function<void(std::size_t)>& task);
+}
+#endif   //	AUTOMATION1_DEVICE_INIT_H
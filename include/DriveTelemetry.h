@@ -0,0 +1,132 @@
+/*
+ * Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUTOMATION1_DRIVE_TELEMETRY_H
+#define AUTOMATION1_DRIVE_TELEMETRY_H
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Automation1.h"
+#include "Sampler.h"
+
+
+namespace Controller_ns
+{
+    // Drive signals available as telemetry, by the name used in the telemetryItems property of the axes.
+    const std::map<std::string, Automation1AxisStatusItem>& telemetry_items();
+
+    struct TelemetryValue
+    {
+        double value{};
+        SampleClock::time_point timestamp{};
+    };
+
+    // Load of the controller, read with the drive telemetry.
+    struct ControllerLoad
+    {
+        // Percent of the servo loop period used by the controller.
+        double servo_loop_utilization{};
+        double cpu_utilization{};
+        // Percent of the data collection buffer in use.
+        double data_collection_usage{};
+        // Commands queued and queue capacity of the tasks 1 to n - 1 (task 0 is the library task).
+        std::vector<double> queue_depth{};
+        std::vector<double> queue_capacity{};
+        // Duration of the status query, i.e. the response time of the controller.
+        double query_time{};
+        SampleClock::time_point timestamp{};
+        bool valid{};
+    };
+
+    /*
+     * Reads drive signals like currents, temperatures and bus voltages of all axes together with the load of the
+     * controller with one Automation1_Status_GetResults call per tick. The values change slowly, so the rate is low
+     * and independent of the status sampler.
+     */
+    class DriveTelemetry
+    {
+    public:
+        DriveTelemetry(Automation1Controller& controller, std::mutex& controller_mutex);
+
+        ~DriveTelemetry();
+
+        // A rate of 0 disables the telemetry. The task count sets the tasks the queue depths are read for.
+        void start(double rate, int task_count);
+
+        void stop();
+
+        void add(int axisID, Automation1AxisStatusItem item);
+
+        void remove(int axisID, Automation1AxisStatusItem item);
+
+        // Latest value of the item. std::nullopt until the first successful query after add().
+        [[nodiscard]] std::optional<TelemetryValue> value(int axisID, Automation1AxisStatusItem item);
+
+        [[nodiscard]] ControllerLoad load();
+
+        [[nodiscard]] std::string last_error();
+
+    private:
+        struct Channel
+        {
+            std::optional<TelemetryValue> latest{};
+            int references{};
+        };
+
+        using Key = std::pair<int, Automation1AxisStatusItem>;
+
+        void run();
+
+        void rebuild_config();
+
+        Automation1Controller& controller;
+
+        std::mutex& controller_mutex;
+
+        std::mutex mutex;
+
+        std::condition_variable cv;
+
+        std::thread thread;
+
+        bool running{false};
+
+        std::chrono::duration<double> period{1.};
+
+        int task_count{};
+
+        std::map<Key, Channel> channels;
+
+        // Channels in the order of the results of config, before the task and controller load items.
+        std::vector<Key> config_keys;
+
+        ControllerLoad controller_load{};
+
+        Automation1StatusConfig config{};
+
+        bool config_dirty{false};
+
+        std::string error{};
+    };
+}
+#endif   //	AUTOMATION1_DRIVE_TELEMETRY_H
@@ -0,0 +1,85 @@
+/*
+ * Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUTOMATION1_EVENT_PUSHER_H
+#define AUTOMATION1_EVENT_PUSHER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tango/tango.h>
+
+
+namespace Controller_ns
+{
+    /*
+     * Pushes the change events of a device for threads that are not Tango request threads, e.g. the status sampler
+     * or the IO scanner. Pushes are queued per attribute, either the latest one wins (post) or all of them are kept in
+     * order (append), and run on an own thread under the device monitor, so they are serialized with the requests of
+     * the device like any attribute read. Posting never waits for the monitor, so callers may post while holding
+     * their own locks.
+     */
+    class EventPusher
+    {
+    public:
+        explicit EventPusher(Tango::DeviceImpl& device);
+
+        ~EventPusher();
+
+        // push runs under the device monitor and may use the attributes and read buffers of the device. It replaces
+        // the queued pushes of the attribute, for values where only the latest one matters.
+        void post(const std::string& attribute, std::function<void()> push);
+
+        // Like post(), but queues push after the queued pushes of the attribute, so no change is lost, e.g. the edges
+        // of a digital input.
+        void append(const std::string& attribute, std::function<void()> push);
+
+        // Drops the queued pushes and stops the thread, no push runs after it returns. From delete_device(), with
+        // the monitor held, it waits at most the monitor timeout for a thread that is already waiting for it.
+        void stop();
+
+    private:
+        struct Queue
+        {
+            std::deque<std::function<void()>> pushes{};
+            // Set by append(), older pushes are kept.
+            bool keep_all{};
+        };
+
+        void queue(const std::string& attribute, std::function<void()> push, bool keep_all);
+
+        void run();
+
+        Tango::DeviceImpl& device;
+
+        std::mutex mutex;
+
+        std::condition_variable cv;
+
+        std::map<std::string, Queue> pending;
+
+        std::atomic<bool> stopping{false};
+
+        std::thread thread;
+    };
+}
+#endif   //	AUTOMATION1_EVENT_PUSHER_H
@@ -0,0 +1,97 @@
+/*
+ * Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUTOMATION1_FLIGHT_RECORD_H
+#define AUTOMATION1_FLIGHT_RECORD_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+
+namespace Controller_ns
+{
+    /*
+     * File format of the flight recorder journal, shared by the server and the offline decoder. The file holds a
+     * header followed by a ring of fixed size records in host byte order. head counts the records ever claimed, the
+     * record of sequence number n is stored at index (n - 1) % capacity. Writers set sequence to 0 while they fill a
+     * record and to its sequence number when done, so a record torn by a crash reads as empty.
+     */
+    constexpr std::array<char, 8> flight_record_magic{'A', '1', 'J', 'O', 'U', 'R', 'N', 'L'};
+
+    constexpr std::uint32_t flight_record_version = 1;
+
+    enum class FlightRecordType : std::uint16_t
+    {
+        // The server opened the journal. values: none.
+        Start = 1,
+        // code: FlightCommand. values: up to 3 arguments (NaN if unused), then 1 if the controller accepted the
+        // command and 0 if not.
+        Command = 2,
+        // values: previous axis fault word, new axis fault word, axis status, drive status, position feedback.
+        FaultChange = 3,
+        // values: axis status, drive status, axis fault, position feedback, velocity feedback.
+        Snapshot = 4,
+    };
+
+    enum class FlightCommand : std::uint16_t
+    {
+        Enable, Disable, Home, Stop, FaultAck, FaultAckAll, MoveAbsolute, MoveFreerun, Retarget, VelocitySetpoint,
+        VelocityStreamStop, TrajectoryStart, TrajectoryAbort, StepScanStart, StepScanAbort,
+        // Commands the server sends by itself, e.g. from the streaming threads.
+        Abort, MoveFreerunStop,
+        // Program commands, the axis is -1 and the argument the task.
+        ProgramRun, ProgramStart, ProgramStop
+    };
+
+    constexpr const char* flight_command_name(const FlightCommand command)
+    {
+        constexpr const char* names[] = {
+            "enable", "disable", "home", "stop", "fault_ack", "fault_ack_all", "move_absolute", "move_freerun",
+            "retarget", "velocity_setpoint", "velocity_stream_stop", "trajectory_start", "trajectory_abort",
+            "step_scan_start", "step_scan_abort", "abort", "move_freerun_stop", "program_run", "program_start",
+            "program_stop"
+        };
+        const auto index = static_cast<std::size_t>(command);
+        return index < std::size(names) ? names[index] : "unknown";
+    }
+
+    struct FlightRecordHeader
+    {
+        std::array<char, 8> magic;
+        std::uint32_t version;
+        std::uint32_t record_size;
+        std::uint64_t capacity;
+        std::uint64_t head;
+        std::uint64_t reserved[4];
+    };
+
+    struct FlightRecord
+    {
+        std::uint64_t sequence;
+        // Nanoseconds since the epoch.
+        std::int64_t time;
+        FlightRecordType type;
+        std::uint16_t code;
+        std::int32_t axisID;
+        double values[5];
+    };
+
+    static_assert(sizeof(FlightRecordHeader) == 64 && sizeof(FlightRecord) == 64);
+}
+#endif   //	AUTOMATION1_FLIGHT_RECORD_H
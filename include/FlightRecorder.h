@@ -0,0 +1,74 @@
+/*
+ * Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUTOMATION1_FLIGHT_RECORDER_H
+#define AUTOMATION1_FLIGHT_RECORDER_H
+
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include "FlightRecord.h"
+
+
+namespace Controller_ns
+{
+    struct AxisSnapshot;
+
+    /*
+     * Always-on journal of the motion commands, fault word changes and periodic status snapshots, kept in a memory
+     * mapped ring file (see FlightRecord.h) that survives a crash of the server. Writers claim a record with one
+     * atomic increment and never wait, so recording from the command and sampling paths costs a few stores. Before
+     * open() and after a failed open() all records are dropped.
+     */
+    class FlightRecorder
+    {
+    public:
+        ~FlightRecorder();
+
+        // Maps the journal with capacity records. An existing journal of the same capacity is continued, so the
+        // records before a crash are kept. Only the first call has an effect. Throws if the file cannot be mapped.
+        void open(const std::filesystem::path& path, std::size_t capacity);
+
+        // Journal of the device in a directory of the system temp directory that only the server user may write, so
+        // several servers on one host keep separate journals. Throws if that directory is not safe to use.
+        [[nodiscard]] static std::filesystem::path default_path(const std::string& device_name);
+
+        void command(FlightCommand command, int axisID, std::initializer_list<double> arguments, bool ok);
+
+        void fault_change(int axisID, double previous_fault, const AxisSnapshot& snapshot);
+
+        void snapshot(int axisID, const AxisSnapshot& snapshot);
+
+    private:
+        void write(FlightRecordType type, std::uint16_t code, int axisID, std::initializer_list<double> values);
+
+        std::mutex open_mutex;
+
+        // Published last by open(), the other members are constant afterwards.
+        std::atomic<FlightRecordHeader*> header{nullptr};
+
+        FlightRecord* records{};
+
+        std::size_t capacity{};
+
+        std::size_t mapped_size{};
+    };
+}
+#endif   //	AUTOMATION1_FLIGHT_RECORDER_H
@@ -0,0 +1,75 @@
+/*
+ * Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUTOMATION1_GLOBAL_VARIABLES_H
+#define AUTOMATION1_GLOBAL_VARIABLES_H
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "Automation1.h"
+
+
+namespace Controller_ns
+{
+    /*
+     * A contiguous range of controller global variables ($rglobal or $iglobal), read and written with one bulk call.
+     * The values of the last poll() are kept to detect changes.
+     */
+    template <typename T>
+    class GlobalVariableRange
+    {
+    public:
+        GlobalVariableRange(Automation1Controller& controller, std::mutex& controller_mutex) :
+            controller(controller), controller_mutex(controller_mutex)
+        {
+        }
+
+        void configure(int first, int count);
+
+        [[nodiscard]] int size() const { return count; }
+
+        // Reads the range without touching the change detection.
+        void read(std::vector<T>& values);
+
+        // Reads the range. Returns true if the values differ from the previous poll. Meant for a single poller.
+        bool poll(std::vector<T>& values);
+
+        // Writes values to the start of the range.
+        void write(const T* values, int length);
+
+    private:
+        Automation1Controller& controller;
+
+        std::mutex& controller_mutex;
+
+        std::mutex mutex;
+
+        int first{};
+
+        int count{};
+
+        std::vector<T> last;
+
+        bool valid{false};
+    };
+
+    using GlobalReals = GlobalVariableRange<double>;
+
+    using GlobalIntegers = GlobalVariableRange<std::int64_t>;
+}
+#endif   //	AUTOMATION1_GLOBAL_VARIABLES_H
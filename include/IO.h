@@ -0,0 +1,122 @@
+/*
+ * Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUTOMATION1_IO_H
+#define AUTOMATION1_IO_H
+
+#include <memory>
+#include <optional>
+#include <tango/tango.h>
+#include "EventPusher.h"
+#include "IoScanner.h"
+
+
+namespace IO_ns
+{
+    // Named I/O of the inputs or outputs property, exposed as the dynamic attribute of the same name.
+    struct IoMapping
+    {
+        std::string name;
+        std::string axisName;
+        Controller_ns::IoChannel channel{};
+        // Storage of the value handed to Tango by the last read.
+        Tango::DevBoolean digital{};
+        Tango::DevDouble analog{};
+    };
+
+    class IO final : public TANGO_BASE_CLASS
+    {
+    public:
+        IO(Tango::DeviceClass* cl, const std::string& s);
+
+        IO(Tango::DeviceClass* cl, const char* s);
+
+        IO(Tango::DeviceClass* cl, const char* s, const char* d);
+
+        ~IO() override;
+
+        Tango::DevState dev_state() override;
+
+        const char* dev_status() override;
+
+        void delete_device() override;
+
+        void init_device() override;
+
+        void init_hardware();
+
+        // Subscribes the I/O to the scanner. Called after add_dynamic_attributes(), so the attributes exist when the
+        // first scan pushes their change events.
+        void start_scan();
+
+        void set_init_error(const std::string& error);
+
+        void get_device_property();
+
+        void always_executed_hook() override;
+
+        void read_attr_hardware(std::vector<long>& attr_list) override;
+
+        void add_dynamic_attributes();
+
+        static void add_dynamic_commands();
+
+        void read_io(Tango::Attribute& attribute);
+
+        void write_io(Tango::WAttribute& attribute);
+
+        bool is_io_allowed(Tango::AttReqType type);
+
+        void set_outputs(const Tango::DevVarDoubleStringArray* arg_in);
+
+        bool is_set_outputs_allowed(const CORBA::Any& any);
+
+    private:
+        // Parses inputs and outputs into mappings. Throws on invalid entries.
+        void parse_mappings();
+
+        [[nodiscard]] IoMapping& mapping(const std::string& name);
+
+        // Sets the outputs under one acquisition of the controller lock.
+        void write_outputs(const std::vector<std::pair<const IoMapping*, double>>& outputs);
+
+        // Called by the scanner when a value changed, posts the change events.
+        void push_changes(const Controller_ns::IoSample& sample);
+
+        std::vector<std::string> inputs{};
+
+        std::vector<std::string> outputs{};
+
+        std::vector<IoMapping> mappings{};
+
+        std::optional<int> subscription{};
+
+        // Taken once per read request, so all attributes of one request come from the same scan.
+        Controller_ns::IoSample sample{};
+
+        // Values of the last change events, only used by the scan thread.
+        std::vector<double> pushed{};
+
+        // Change events pushed from the scan thread.
+        std::unique_ptr<Controller_ns::EventPusher> events{};
+
+        std::string status{};
+
+        std::string init_error{};
+    };
+}
+#endif   //	AUTOMATION1_IO_H
@@ -0,0 +1,137 @@
+/*
+* Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUTOMATION1_IO_CLASS_H
+#define AUTOMATION1_IO_CLASS_H
+
+#include <tango/tango.h>
+#include "IO.h"
+
+
+namespace IO_ns
+{
+    // Dynamic attribute of an I/O of the inputs or outputs property.
+    class ioAttrib final : public Tango::Attr
+    {
+    public:
+        ioAttrib(const std::string& name, const long type, const Tango::AttrWriteType write_type) :
+            Attr(name.c_str(), type, write_type)
+        {
+        };
+
+        ~ioAttrib() override = default;
+
+        void read(Tango::DeviceImpl* dev,
+                  Tango::Attribute& att) override { (dynamic_cast<IO*>(dev))->read_io(att); }
+
+        void write(Tango::DeviceImpl* dev,
+                   Tango::WAttribute& att) override { (dynamic_cast<IO*>(dev))->write_io(att); }
+
+        bool is_allowed(Tango::DeviceImpl* dev, const Tango::AttReqType ty) override
+        {
+            return (dynamic_cast<IO*>(dev))->is_io_allowed(ty);
+        }
+    };
+
+    class SetOutputsCommand final : public Tango::Command
+    {
+    public:
+        SetOutputsCommand(const char* cmd_name,
+                          const Tango::CmdArgType in,
+                          const Tango::CmdArgType out,
+                          const char* in_desc,
+                          const char* out_desc,
+                          const Tango::DispLevel level)
+            : Command(cmd_name, in, out, in_desc, out_desc, level)
+        {
+        };
+
+        SetOutputsCommand(const char* cmd_name,
+                          const Tango::CmdArgType in,
+                          const Tango::CmdArgType out)
+            : Command(cmd_name, in, out)
+        {
+        };
+
+        ~SetOutputsCommand() override = default;
+
+        CORBA::Any* execute(Tango::DeviceImpl* dev, const CORBA::Any& any) override;
+
+        bool is_allowed(Tango::DeviceImpl* dev, const CORBA::Any& any) override
+        {
+            return (dynamic_cast<IO*>(dev))->is_set_outputs_allowed(any);
+        }
+    };
+
+    class IOClass final : public Tango::DeviceClass
+    {
+    public:
+        Tango::DbData cl_prop;
+        Tango::DbData cl_def_prop;
+        Tango::DbData dev_def_prop;
+
+        // Set while the device factory creates the devices. The controller dependent part of init_device is then
+        // run afterwards on the device init pool.
+        bool deferred_init{false};
+
+        static IOClass* init(const char*);
+
+        static IOClass* instance();
+
+        ~IOClass() override;
+
+        Tango::DbDatum get_class_property(std::string&);
+
+        Tango::DbDatum get_default_device_property(std::string&);
+
+        Tango::DbDatum get_default_class_property(std::string&);
+
+    protected:
+        explicit IOClass(const std::string&);
+
+        static IOClass* _instance;
+
+        void command_factory() override;
+
+        void attribute_factory(std::vector<Tango::Attr*>&) override;
+
+        void pipe_factory() override;
+
+        void write_class_property();
+
+        static void set_default_property();
+
+        void get_class_property();
+
+        std::string get_cvstag();
+
+        std::string get_cvsroot();
+
+    private:
+        void device_factory(TANGO_UNUSED(const Tango::DevVarStringArray *)) override;
+
+        void create_static_attribute_list(std::vector<Tango::Attr*>&);
+
+        void erase_dynamic_attributes(const Tango::DevVarStringArray*, const std::vector<Tango::Attr*>&);
+
+        std::vector<std::string> defaultAttList;
+
+        static Tango::Attr* get_attr_object_by_name(std::vector<Tango::Attr*>& att_list, const std::string& attname);
+    };
+}
+
+#endif
@@ -0,0 +1,142 @@
+/*
+ * Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUTOMATION1_IO_SCANNER_H
+#define AUTOMATION1_IO_SCANNER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Automation1.h"
+#include "Sampler.h"
+
+
+namespace Controller_ns
+{
+    // One digital or analog input or output of an axis.
+    struct IoChannel
+    {
+        enum Kind { DigitalInput, DigitalOutput, AnalogInput, AnalogOutput };
+
+        int axisID{};
+        Kind kind{DigitalInput};
+        int index{};
+
+        [[nodiscard]] bool is_digital() const { return kind == DigitalInput || kind == DigitalOutput; }
+
+        [[nodiscard]] bool is_output() const { return kind == DigitalOutput || kind == AnalogOutput; }
+    };
+
+    // Values of the channels of a subscription, digital channels as 0 or 1.
+    struct IoSample
+    {
+        std::vector<double> values{};
+        SampleClock::time_point timestamp{};
+        bool valid{};
+    };
+
+    /*
+     * Reads the I/O channels of all subscriptions with one Automation1_Status_GetResults call per scan. Digital
+     * channels of an axis share one status item holding all bits, so any number of them costs a single value.
+     * Subscribers are notified from the scan thread when one of their values changed.
+     */
+    class IoScanner
+    {
+    public:
+        using Callback = std::function<void(const IoSample&)>;
+
+        IoScanner(Automation1Controller& controller, std::mutex& controller_mutex);
+
+        ~IoScanner();
+
+        void start(double rate);
+
+        void stop();
+
+        // Adds the channels to the scan and returns the subscription id. on_change is called from the scan thread
+        // with all values of the subscription, after the first scan and whenever one of them changed.
+        int subscribe(const std::vector<IoChannel>& channels, Callback on_change);
+
+        // Removes the subscription. Waits for a running on_change call to finish.
+        void unsubscribe(int id);
+
+        // Latest values of the subscription.
+        [[nodiscard]] IoSample read(int id);
+
+        [[nodiscard]] std::string last_error();
+
+    private:
+        // Status item of the query, read once for all channels using it.
+        struct Item
+        {
+            int axisID;
+            Automation1AxisStatusItem item;
+            int argument;
+
+            auto operator<=>(const Item&) const = default;
+        };
+
+        struct Subscription
+        {
+            std::vector<IoChannel> channels{};
+            Callback on_change{};
+            IoSample sample{};
+        };
+
+        static Item item_of(const IoChannel& channel);
+
+        void run();
+
+        void rebuild_config();
+
+        Automation1Controller& controller;
+
+        std::mutex& controller_mutex;
+
+        std::mutex mutex;
+
+        // Held while the subscribers are notified, so unsubscribe() never returns during a notification.
+        std::mutex callback_mutex;
+
+        std::condition_variable cv;
+
+        std::thread thread;
+
+        bool running{false};
+
+        std::chrono::duration<double> period{0.05};
+
+        std::map<int, Subscription> subscriptions;
+
+        int next_id{};
+
+        // Items in the order of the results of config.
+        std::vector<Item> config_items;
+
+        Automation1StatusConfig config{};
+
+        bool config_dirty{false};
+
+        std::string error{};
+    };
+}
+#endif   //	AUTOMATION1_IO_SCANNER_H
@@ -0,0 +1,150 @@
+/*
+ * Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUTOMATION1_POSITION_CAPTURE_H
+#define AUTOMATION1_POSITION_CAPTURE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <tango/tango.h>
+#include "Automation1.h"
+#include "TripleBuffer.h"
+
+
+namespace Axis_ns
+{
+    struct CaptureSettings
+    {
+        // Drive signal that is captured, e.g. the position feedback.
+        int input{};
+        // Drive signal the capture is triggered by, e.g. a marker or the PSO output.
+        int trigger{};
+        // Region of the drive array the drive captures into.
+        int array_address{};
+        int array_size{};
+        // Maximum number of positions kept in the server.
+        std::size_t max_points{};
+    };
+
+    // Captured positions in user units and the trigger index of each of them.
+    struct CaptureData
+    {
+        std::vector<double> positions;
+        std::vector<Tango::DevLong64> indices;
+        // Arm call the data belongs to.
+        std::uint64_t generation{};
+    };
+
+    /*
+     * Drive data capture of the axis position at every trigger edge. The drive captures into a region of the drive
+     * array, a server thread drains it into an unbounded host buffer while the capture is armed. When the drive
+     * array is full, the capture is restarted and the restart counter is increased, as triggers during the restart
+     * can be missed. Positions beyond max_points are dropped and counted separately.
+     *
+     * The captured data is handed to the reader through a triple buffer. Each of the three buffers only gets the
+     * values appended since it was last published, so neither publishing nor reading copies the whole capture.
+     */
+    class PositionCapture
+    {
+    public:
+        PositionCapture(Automation1Controller& controller, std::mutex& controller_mutex);
+
+        ~PositionCapture();
+
+        void arm(int axisID, const CaptureSettings& settings);
+
+        void disarm();
+
+        [[nodiscard]] bool is_armed() const;
+
+        // Takes the latest published capture data. Only one thread may read.
+        void acquire();
+
+        // Capture data taken by the last acquire(). It stays unchanged until the next acquire().
+        [[nodiscard]] CaptureData& data();
+
+        [[nodiscard]] long count() const;
+
+        [[nodiscard]] std::string error();
+
+        // Number of drive capture restarts after the drive array was full.
+        [[nodiscard]] long restarts() const;
+
+        // Number of captured positions dropped because max_points was reached.
+        [[nodiscard]] long dropped() const;
+
+    private:
+        void run();
+
+        // Reads all new captured values. The controller lock must be held.
+        void drain();
+
+        void capture_on();
+
+        void capture_off();
+
+        void check(bool response, const char* origin) const;
+
+        // Brings the back buffer up to date with the capture and publishes it.
+        void publish();
+
+        Automation1Controller& controller;
+
+        std::mutex& controller_mutex;
+
+        int axisID{};
+
+        CaptureSettings settings;
+
+        Automation1StatusConfig status_config{};
+
+        double countsPerUnit{1.};
+
+        std::thread thread;
+
+        std::atomic<bool> armed{false};
+
+        std::atomic<long> restart_count{0};
+
+        std::atomic<long> dropped_count{0};
+
+        std::atomic<long> captured{0};
+
+        // Values of the current drive capture already copied to the host buffer.
+        int drained{};
+
+        // Trigger index of the first value of the current drive capture.
+        long long index_offset{};
+
+        std::mutex mutex;
+
+        std::condition_variable cv;
+
+        std::string last_error;
+
+        // Complete capture, only accessed by the capture thread and by arm() while the thread is not running.
+        CaptureData capture;
+
+        Controller_ns::TripleBuffer<CaptureData> published;
+    };
+}
+#endif   //	AUTOMATION1_POSITION_CAPTURE_H
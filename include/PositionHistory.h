@@ -0,0 +1,62 @@
+/*
+ * Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUTOMATION1_POSITION_HISTORY_H
+#define AUTOMATION1_POSITION_HISTORY_H
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+
+namespace Controller_ns
+{
+    /*
+     * Ring buffer of the sampled feedback positions of one axis. Reads are decimated to a maximum number of points by
+     * keeping the minimum and the maximum of every bucket, so peaks such as an overshoot survive the downsampling.
+     */
+    class PositionHistory
+    {
+    public:
+        using Clock = std::chrono::system_clock;
+
+        explicit PositionHistory(std::size_t capacity);
+
+        void push(Clock::time_point time, double position);
+
+        // Samples of the last window seconds, decimated to at most max_points. Times are seconds since the epoch.
+        void read(double window, std::size_t max_points, std::vector<double>& times,
+                  std::vector<double>& positions) const;
+
+    private:
+        struct Sample
+        {
+            double time;
+            double position;
+        };
+
+        [[nodiscard]] const Sample& at(std::size_t i) const;
+
+        std::vector<Sample> samples;
+
+        // Index of the oldest sample and number of samples in the buffer.
+        std::size_t head{};
+
+        std::size_t count{};
+    };
+}
+#endif   //	AUTOMATION1_POSITION_HISTORY_H
@@ -0,0 +1,61 @@
+/*
+ * Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUTOMATION1_PROGRAM_CACHE_H
+#define AUTOMATION1_PROGRAM_CACHE_H
+
+#include <filesystem>
+#include <mutex>
+#include <set>
+#include <string>
+#include "Automation1.h"
+
+
+namespace Controller_ns
+{
+    /*
+     * Compiles AeroScript sources with the automation1 compiler and keeps the compiled programs on disk, keyed by a
+     * hash of the source and the API version. Compiled programs are copied to the controller file system once per
+     * connection.
+     */
+    class ProgramCache
+    {
+    public:
+        void set_directory(const std::filesystem::path& path);
+
+        // Hash of the source used as the cache key and as file name of the compiled program.
+        [[nodiscard]] static std::string key(const std::string& source);
+
+        // Path of the compiled program on disk. Compiles the source if it is not cached yet.
+        std::filesystem::path compile(const std::string& source);
+
+        // File name of a compiled program on the controller. Copies it there if needed. The controller lock must be
+        // held by the caller.
+        std::string upload(Automation1Controller controller, const std::filesystem::path& compiled);
+
+        // Forgets which programs were uploaded, e.g. after a reconnect.
+        void reset_uploads();
+
+    private:
+        std::mutex mutex;
+
+        std::filesystem::path directory{std::filesystem::temp_directory_path() / "automation1_programs"};
+
+        std::set<std::string> uploaded;
+    };
+}
+#endif   //	AUTOMATION1_PROGRAM_CACHE_H
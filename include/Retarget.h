@@ -0,0 +1,99 @@
+/*
+ * Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUTOMATION1_RETARGET_H
+#define AUTOMATION1_RETARGET_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "Sampler.h"
+#include "VelocityStreamer.h"
+
+
+namespace Axis_ns
+{
+    /*
+     * Moves an axis to a target that may change while the axis is moving. The axis follows a velocity profile
+     * computed in the server (limited by the velocity and the acceleration, braking in time for the current target)
+     * and streamed through the VelocityStreamer. Close to the target the free run is stopped and a final absolute
+     * move corrects the remaining distance.
+     */
+    class Retarget
+    {
+    public:
+        using Finished = std::function<bool(const Controller_ns::AxisSnapshot&)>;
+
+        Retarget(Automation1Controller& controller, std::mutex& controller_mutex, Controller_ns::Sampler& sampler,
+                 Controller_ns::FlightRecorder& recorder, VelocityStreamer& streamer, double acceleration,
+                 double rate);
+
+        ~Retarget();
+
+        // Sets a new target, starting the motion if none is running.
+        void move_to(int axisID, double target, double velocity, Finished finished);
+
+        void abort();
+
+        [[nodiscard]] bool is_running() const;
+
+        [[nodiscard]] std::string status();
+
+    private:
+        void run(int axisID, Finished finished);
+
+        // Sleeps for the duration unless aborted. Returns false on abort.
+        bool wait(std::chrono::duration<double> duration);
+
+        Automation1Controller& controller;
+
+        std::mutex& controller_mutex;
+
+        Controller_ns::Sampler& sampler;
+
+        Controller_ns::FlightRecorder& recorder;
+
+        VelocityStreamer& streamer;
+
+        double acceleration;
+
+        double period;
+
+        std::thread thread;
+
+        std::atomic<bool> running{false};
+
+        std::mutex mutex;
+
+        std::condition_variable cv;
+
+        double target{};
+
+        double velocity{};
+
+        bool aborted{false};
+
+        // The profile is done and the final move is sent, later targets need a new motion.
+        bool finishing{false};
+
+        std::string status_text{"idle"};
+    };
+}
+#endif   //	AUTOMATION1_RETARGET_H
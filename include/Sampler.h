@@ -0,0 +1,281 @@
+/*
+ * Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUTOMATION1_SAMPLER_H
+#define AUTOMATION1_SAMPLER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+#include "Automation1.h"
+#include "ClockSync.h"
+#include "FlightRecorder.h"
+#include "PositionHistory.h"
+#include "SnapshotTable.h"
+#include "WatchExpression.h"
+
+
+namespace Controller_ns
+{
+    using SampleClock = std::chrono::system_clock;
+
+    // Samples kept per axis for the position history, about 20 minutes at a fast rate of 50 Hz.
+    constexpr std::size_t position_history_capacity = 65536;
+
+    // Raw status values of one axis, taken from one batched status query.
+    struct AxisSnapshot
+    {
+        double axis_status{};
+        double drive_status{};
+        double position_command{};
+        double position_feedback{};
+        double velocity_command{};
+        double velocity_feedback{};
+        double axis_fault{};
+        // Host time of the controller sample, derived from the controller timer.
+        SampleClock::time_point timestamp{};
+        std::uint64_t generation{};
+        bool valid{};
+    };
+
+    // Raw absolute position of a BiSS encoder, taken from the same batched status query as the axes.
+    struct EncoderSnapshot
+    {
+        double counts{};
+        SampleClock::time_point timestamp{};
+        bool valid{};
+    };
+
+    /*
+     * Samples the status of all registered axes with one Automation1_Status_GetResults call per tick.
+     * Axes that move or home are sampled at the fast rate, idle and disabled axes at the slow rate. Registered BiSS
+     * encoders are sampled at their own rate (the fast rate by default) in the same query, keeping a window of their
+     * latest samples. Watch expressions are evaluated on every sample of the axes they use.
+     */
+    class Sampler
+    {
+    public:
+        // Fault word changes and a status snapshot of every axis per journal period are written to recorder.
+        Sampler(Automation1Controller& controller, std::mutex& controller_mutex, FlightRecorder& recorder);
+
+        ~Sampler();
+
+        // journal_period: seconds between the snapshots of an axis in the flight recorder, 0 disables them.
+        void start(double fast_rate, double slow_rate, double journal_period);
+
+        void stop();
+
+        void add_axis(int axisID);
+
+        void remove_axis(int axisID);
+
+        // Requests a fresh sample of the axis, e.g. after a motion command. The next axis() call waits for it.
+        void invalidate(int axisID);
+
+        void invalidate_all();
+
+        // A rate of 0 samples the encoder at the fast rate. Devices sharing an encoder get the highest requested rate
+        // (the fast rate if any of them asks for it), the longest window and the longest EMA time constant.
+        void add_encoder(int axisID, double rate = 0., std::size_t window = 1, double ema_time_constant = 0.);
+
+        void remove_encoder(int axisID);
+
+        // Latest absolute position of the encoder. Waits for the first sample after add_encoder().
+        [[nodiscard]] EncoderSnapshot encoder(int axisID);
+
+        // Latest samples of the encoder, oldest first.
+        void encoder_window(int axisID, std::vector<EncoderSnapshot>& samples);
+
+        // Exponential moving average of the encoder counts, updated with every sample since add_encoder().
+        [[nodiscard]] double encoder_ema(int axisID);
+
+        // Latest snapshot of the axis. Throws if no valid sample is available. Unless a fresh sample is pending, the
+        // snapshot is taken from the lock free snapshot table without blocking the sampler or other readers.
+        [[nodiscard]] AxisSnapshot axis(int axisID);
+
+        // Blocks until a sample of the axis satisfies the predicate. Only samples taken after a pending invalidate()
+        // are considered. Returns std::nullopt on timeout.
+        [[nodiscard]] std::optional<AxisSnapshot> wait_axis(int axisID,
+                                                            const std::function<bool(const AxisSnapshot&)>& predicate,
+                                                            std::chrono::duration<double> timeout);
+
+        using AxisCallback = std::function<void(const std::optional<AxisSnapshot>& snapshot)>;
+
+        // Non-blocking variant of wait_axis(): on_done is called once from the sampler thread, outside of the sampler
+        // lock, with the first sample satisfying the predicate or with std::nullopt on timeout.
+        int notify_axis(int axisID, std::function<bool(const AxisSnapshot&)> predicate,
+                        std::chrono::duration<double> timeout, AxisCallback on_done);
+
+        // Cancels a notification that was not delivered yet. Waits for a running on_done call of it to finish.
+        void cancel_notify(int id);
+
+        // Measured samples per second of the axis.
+        [[nodiscard]] double axis_rate(int axisID);
+
+        // Measured Automation1_Status_GetResults calls per second.
+        [[nodiscard]] double calls_per_second();
+
+        // Feedback positions of the last window seconds, decimated to at most max_points.
+        void position_history(int axisID, double window, std::size_t max_points, std::vector<double>& times,
+                              std::vector<double>& positions);
+
+        // Host minus controller time in seconds and relative drift of the controller clock.
+        [[nodiscard]] std::pair<double, double> clock_offset_drift();
+
+        using WatchCallback = std::function<void(bool state, SampleClock::time_point timestamp)>;
+
+        // Registers a watch and samples the axes it uses. on_change is called from the sampler thread, outside of the
+        // sampler lock, after the first evaluation and whenever the state of the expression changes.
+        int add_watch(const WatchExpression& expression, WatchCallback on_change);
+
+        // Removes the watch. Waits for a running on_change call of it to finish.
+        void remove_watch(int id);
+
+        // State of the watch after its latest evaluation, std::nullopt before the first one.
+        [[nodiscard]] std::optional<bool> watch_state(int id);
+
+    private:
+        struct AxisEntry
+        {
+            AxisSnapshot snapshot{};
+            int references{};
+            bool active{true};
+            SampleClock::time_point next_due{};
+            SampleClock::time_point next_journal{};
+            std::uint64_t started{};
+            std::uint64_t attempts{};
+            std::uint64_t requested{};
+            std::uint64_t window_samples{};
+            double rate{};
+            PositionHistory history{position_history_capacity};
+        };
+
+        struct EncoderEntry
+        {
+            EncoderSnapshot snapshot{};
+            std::deque<EncoderSnapshot> window{};
+            std::size_t window_size{1};
+            // Seconds, 0 follows the latest sample.
+            double ema_time_constant{};
+            double ema{};
+            double rate{};
+            int references{};
+            SampleClock::time_point next_due{};
+            std::uint64_t attempts{};
+        };
+
+        struct WatchEntry
+        {
+            WatchExpression expression;
+            WatchCallback on_change{};
+            std::optional<bool> state{};
+        };
+
+        struct NotifyEntry
+        {
+            int axisID{};
+            std::function<bool(const AxisSnapshot&)> predicate{};
+            SampleClock::time_point deadline{};
+            AxisCallback on_done{};
+        };
+
+        void run();
+
+        // Queues the notifications of the sampled axes that are satisfied or timed out for notify_watches().
+        void evaluate_notifications(const std::vector<int>& sampled, SampleClock::time_point now);
+
+        // Evaluates the watches using one of the axes and queues the ones that changed for notify_watches().
+        void evaluate_watches(const std::vector<int>& sampled, SampleClock::time_point timestamp);
+
+        // Calls on_change of the queued watches and on_done of the queued notifications. Expects the sampler lock to
+        // be held and releases it meanwhile.
+        void notify_watches(std::unique_lock<std::mutex>& lk);
+
+        // The key holds the due axes followed by the due encoders, stored as -1 - axisID.
+        Automation1StatusConfig config_for(const std::vector<int>& key);
+
+        void clear_configs();
+
+        Automation1Controller& controller;
+
+        std::mutex& controller_mutex;
+
+        FlightRecorder& recorder;
+
+        std::mutex mutex;
+
+        std::condition_variable cv;
+
+        std::thread thread;
+
+        bool running{false};
+
+        std::chrono::duration<double> fast_period{0.02};
+
+        std::chrono::duration<double> slow_period{0.5};
+
+        std::chrono::duration<double> journal_period{1.};
+
+        std::map<int, AxisEntry> axes;
+
+        std::map<int, EncoderEntry> encoders;
+
+        std::map<std::vector<int>, Automation1StatusConfig> configs;
+
+        bool configs_dirty{false};
+
+        std::string last_error{};
+
+        SampleClock::time_point window_start{};
+
+        std::uint64_t window_calls{};
+
+        double calls_rate{};
+
+        ClockSync clock;
+
+        SnapshotTable table;
+
+        std::map<int, WatchEntry> watches;
+
+        int next_watch{};
+
+        // Watches whose state changed in the current tick, with the new state and the sample time.
+        std::vector<std::tuple<int, bool, SampleClock::time_point>> changed_watches;
+
+        std::map<int, NotifyEntry> notifications;
+
+        int next_notification{};
+
+        // Notifications to deliver in the current tick, std::nullopt on timeout.
+        std::vector<std::pair<int, std::optional<AxisSnapshot>>> done_notifications;
+
+        // Held while watch and notification callbacks run, so remove_watch() and cancel_notify() never return during
+        // a callback.
+        std::mutex callback_mutex;
+    };
+}
+#endif   //	AUTOMATION1_SAMPLER_H
@@ -0,0 +1,92 @@
+/*
+ * Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUTOMATION1_SNAPSHOT_TABLE_H
+#define AUTOMATION1_SNAPSHOT_TABLE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+
+namespace Controller_ns
+{
+    struct AxisSnapshot;
+
+    /*
+     * Latest status of all axes of the controller as a structure of arrays, published with a sequence lock. The
+     * sampler is the only writer (all writes happen under the sampler mutex), readers copy the values of an axis
+     * without any lock and retry if a write happened in between. Every array starts on its own cache line, so
+     * readers of one field do not share lines with the sequence counter the writer bumps.
+     */
+    class SnapshotTable
+    {
+    public:
+        static constexpr int max_axes = 64;
+
+        // Starts and ends an update of one or more axes. Readers retry while an update is in progress.
+        void write_begin();
+
+        void write_end();
+
+        void store(int axisID, const AxisSnapshot& snapshot);
+
+        void clear(int axisID);
+
+        // Marks that a fresh sample of the axis was requested. Readers then take the slow path and wait for it.
+        void set_pending(int axisID, bool pending);
+
+        // Consistent copy of the latest snapshot. std::nullopt if the axis has no valid snapshot or a fresh one is
+        // pending.
+        [[nodiscard]] std::optional<AxisSnapshot> load(int axisID) const;
+
+    private:
+        static constexpr std::size_t cache_line = 64;
+
+        template <typename T>
+        using Column = std::array<std::atomic<T>, max_axes>;
+
+        [[nodiscard]] static bool in_range(int axisID) { return axisID >= 0 && axisID < max_axes; }
+
+        alignas(cache_line) std::atomic<std::uint64_t> sequence{0};
+
+        alignas(cache_line) Column<double> axis_status{};
+
+        alignas(cache_line) Column<double> drive_status{};
+
+        alignas(cache_line) Column<double> position_command{};
+
+        alignas(cache_line) Column<double> position_feedback{};
+
+        alignas(cache_line) Column<double> velocity_command{};
+
+        alignas(cache_line) Column<double> velocity_feedback{};
+
+        alignas(cache_line) Column<double> axis_fault{};
+
+        alignas(cache_line) Column<std::int64_t> timestamp{};
+
+        alignas(cache_line) Column<std::uint64_t> generation{};
+
+        alignas(cache_line) Column<bool> valid{};
+
+        alignas(cache_line) Column<bool> pending{};
+    };
+}
+#endif   //	AUTOMATION1_SNAPSHOT_TABLE_H
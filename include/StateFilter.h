@@ -0,0 +1,81 @@
+/*
+ * Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUTOMATION1_STATE_FILTER_H
+#define AUTOMATION1_STATE_FILTER_H
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+#include <tango/tango.h>
+
+
+namespace Axis_ns
+{
+    /*
+     * Debounces the state derived from the raw status bits, so a flapping axis does not flood the subscribers of
+     * state events. A new state is reported once it was stable for the hold time of its transition and the current
+     * state was reported for at least the minimum dwell time. FAULT is always reported immediately.
+     */
+    class StateFilter
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        // rules: "FROM:TO:seconds" entries, FROM and TO are state names or *, later entries override earlier ones.
+        // Throws on invalid entries. Resets the filter.
+        void configure(const std::vector<std::string>& rules, double min_dwell);
+
+        // State to report for the raw state observed at now.
+        Tango::DevState filter(Tango::DevState raw, Clock::time_point now);
+
+        // Raw transitions that were not reported, including the return to the reported state after a flap.
+        [[nodiscard]] std::uint64_t suppressed();
+
+    private:
+        struct Rule
+        {
+            std::optional<Tango::DevState> from;
+            std::optional<Tango::DevState> to;
+            Clock::duration hold;
+        };
+
+        static Tango::DevState parse_state(const std::string& name, const std::string& rule);
+
+        [[nodiscard]] Clock::duration hold_time(Tango::DevState from, Tango::DevState to) const;
+
+        std::mutex mutex;
+
+        std::vector<Rule> rules;
+
+        Clock::duration min_dwell{};
+
+        std::optional<Tango::DevState> reported;
+
+        Clock::time_point reported_since;
+
+        std::optional<Tango::DevState> candidate;
+
+        Clock::time_point candidate_since;
+
+        std::uint64_t suppressed_count{};
+    };
+}
+#endif   //	AUTOMATION1_STATE_FILTER_H
@@ -0,0 +1,112 @@
+/*
+ * Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUTOMATION1_STEP_SCAN_H
+#define AUTOMATION1_STEP_SCAN_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Sampler.h"
+
+
+namespace Axis_ns
+{
+    struct StepScanSettings
+    {
+        std::vector<double> positions;
+        double velocity{};
+        double settle_time{};
+        // Digital output of the axis pulsed at every point, negative for no trigger.
+        int trigger_output{-1};
+        double trigger_time{};
+    };
+
+    /*
+     * Runs a step scan of one axis in a server thread: move to the point, wait for the motion to finish (detected
+     * by the status sampler), settle, pulse the trigger output and record the feedback position and time.
+     */
+    class StepScan
+    {
+    public:
+        // Returns an error text if the motion of the axis failed, an empty string otherwise.
+        using MotionCheck = std::function<std::string(const Controller_ns::AxisSnapshot&)>;
+
+        StepScan(Automation1Controller& controller, std::mutex& controller_mutex, Controller_ns::Sampler& sampler,
+                 Controller_ns::FlightRecorder& recorder);
+
+        ~StepScan();
+
+        void start(int axisID, StepScanSettings settings, std::function<bool(const Controller_ns::AxisSnapshot&)>
+                   finished, MotionCheck check);
+
+        void abort();
+
+        [[nodiscard]] bool is_running() const;
+
+        [[nodiscard]] int progress() const;
+
+        // Host time in seconds since the epoch at which each point was triggered.
+        [[nodiscard]] std::vector<double> timestamps();
+
+        // Feedback position of each point at the trigger.
+        [[nodiscard]] std::vector<double> positions();
+
+        [[nodiscard]] std::string status();
+
+    private:
+        void run(int axisID, std::function<bool(const Controller_ns::AxisSnapshot&)> finished, MotionCheck check);
+
+        // Sleeps for the duration unless the scan is aborted. Returns false on abort.
+        bool wait(std::chrono::duration<double> duration);
+
+        void set_output(int axisID, int value);
+
+        Automation1Controller& controller;
+
+        std::mutex& controller_mutex;
+
+        Controller_ns::Sampler& sampler;
+
+        Controller_ns::FlightRecorder& recorder;
+
+        StepScanSettings settings;
+
+        std::thread thread;
+
+        std::atomic<bool> running{false};
+
+        std::atomic<int> done{0};
+
+        std::mutex mutex;
+
+        std::condition_variable cv;
+
+        bool aborted{false};
+
+        std::vector<double> point_timestamps;
+
+        std::vector<double> point_positions;
+
+        std::string status_text{"idle"};
+    };
+}
+#endif   //	AUTOMATION1_STEP_SCAN_H
@@ -0,0 +1,193 @@
+/*
+ * Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUTOMATION1_TRACE_H
+#define AUTOMATION1_TRACE_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Highest trace level compiled in: 0 none, 1 Tango requests and automation1 calls, 2 also the per tick details of
+// the internal threads. Set with the AUTOMATION1_TRACE_LEVEL cmake cache variable.
+#ifndef AUTOMATION1_TRACE_LEVEL
+#define AUTOMATION1_TRACE_LEVEL 1
+#endif
+
+
+namespace Controller_ns
+{
+    constexpr int trace_calls = 1;
+
+    constexpr int trace_detail = 2;
+
+    // Names and argument names must be string literals, only the pointers are stored.
+    struct TraceEvent
+    {
+        const char* name{};
+        const char* arg_name{};
+        double arg{};
+        // Nanoseconds of the steady clock.
+        std::int64_t start{};
+        // Nanoseconds, -1 for instant events.
+        std::int64_t duration{};
+        std::uint32_t thread{};
+    };
+
+    /*
+     * Binary trace of timed scopes and instant events. Every thread writes its events to its own lock free ring
+     * without formatting anything, a background thread drains the rings into a bounded history that is exported in
+     * the Chrome trace event format (chrome://tracing, Perfetto). If the ring of a thread is full its events are
+     * dropped and counted, the writer never waits. Use the TRACE_SCOPE and TRACE_INSTANT macros, which compile to
+     * nothing above AUTOMATION1_TRACE_LEVEL.
+     */
+    class Tracer
+    {
+    public:
+        // Events kept for the export, older ones are overwritten.
+        static constexpr std::size_t history_size = 1 << 17;
+
+        // Created on first use and never destroyed, so threads may trace until the process exits.
+        static Tracer& instance();
+
+        [[nodiscard]] bool enabled() const { return on.load(std::memory_order_relaxed); }
+
+        void set_enabled(bool enabled);
+
+        void record(const TraceEvent& event);
+
+        [[nodiscard]] static std::int64_t now();
+
+        // Writes the history as Chrome trace JSON. Returns the number of events written, throws on IO errors.
+        std::size_t export_chrome(const std::filesystem::path& path);
+
+        [[nodiscard]] std::uint64_t dropped();
+
+    private:
+        struct ThreadBuffer
+        {
+            static constexpr std::size_t capacity = 4096;
+
+            std::array<TraceEvent, capacity> events{};
+
+            // head is written by the owning thread, tail by the drain thread.
+            std::atomic<std::size_t> head{0};
+
+            std::atomic<std::size_t> tail{0};
+
+            std::atomic<std::uint64_t> dropped{0};
+
+            std::uint32_t thread{};
+        };
+
+        Tracer();
+
+        ThreadBuffer& thread_buffer();
+
+        void run();
+
+        // Moves the events of all thread buffers to the history. Expects history_mutex to be held.
+        void drain();
+
+        std::atomic<bool> on{true};
+
+        std::mutex buffers_mutex;
+
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+
+        std::uint32_t next_thread{1};
+
+        std::uint64_t dropped_exited{};
+
+        std::mutex history_mutex;
+
+        std::vector<TraceEvent> history;
+
+        std::size_t history_next{};
+
+        std::thread thread;
+    };
+
+    template <bool Enabled>
+    class TraceScope
+    {
+    public:
+        explicit TraceScope(const char*, const char* = nullptr, double = 0.)
+        {
+        }
+    };
+
+    template <>
+    class TraceScope<true>
+    {
+    public:
+        explicit TraceScope(const char* name, const char* arg_name = nullptr, const double arg = 0.)
+        {
+            if (Tracer::instance().enabled())
+                event = TraceEvent{name, arg_name, arg, Tracer::now()};
+        }
+
+        ~TraceScope()
+        {
+            if (event.name != nullptr)
+            {
+                event.duration = Tracer::now() - event.start;
+                Tracer::instance().record(event);
+            }
+        }
+
+        TraceScope(const TraceScope&) = delete;
+
+        TraceScope& operator=(const TraceScope&) = delete;
+
+    private:
+        TraceEvent event{};
+    };
+
+    inline void trace_instant(const char* name, const char* arg_name = nullptr, const double arg = 0.)
+    {
+        if (Tracer::instance().enabled())
+            Tracer::instance().record(TraceEvent{name, arg_name, arg, Tracer::now(), -1});
+    }
+}
+
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+
+// TRACE_SCOPE(level, name[, arg_name, arg]): times the rest of the enclosing scope.
+#define TRACE_SCOPE(level, ...) \
+    const Controller_ns::TraceScope<((level) <= AUTOMATION1_TRACE_LEVEL)> TRACE_CONCAT(trace_scope_, __COUNTER__)( \
+        __VA_ARGS__)
+
+// TRACE_INSTANT(level, name[, arg_name, arg]): records a point in time.
+#define TRACE_INSTANT(level, ...) \
+    do \
+    { \
+        if constexpr ((level) <= AUTOMATION1_TRACE_LEVEL) \
+            Controller_ns::trace_instant(__VA_ARGS__); \
+    } \
+    while (false)
+
+#endif   //	AUTOMATION1_TRACE_H
@@ -0,0 +1,97 @@
+/*
+ * Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUTOMATION1_TRAJECTORY_STREAMER_H
+#define AUTOMATION1_TRAJECTORY_STREAMER_H
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Automation1.h"
+#include "FlightRecorder.h"
+
+
+namespace Axis_ns
+{
+    /*
+     * Streams a position/velocity/time trajectory of one axis as MovePvt commands through an Automation1 command
+     * queue. The queue is kept filled up to a fixed depth, so the motion runs without gaps as long as the host keeps
+     * up. Every time the queue runs empty before the last point was sent, an underrun is counted.
+     */
+    class TrajectoryStreamer
+    {
+    public:
+        struct Point
+        {
+            double position;
+            double velocity;
+            double time;
+        };
+
+        TrajectoryStreamer(Automation1Controller& controller, std::mutex& controller_mutex,
+                           Controller_ns::FlightRecorder& recorder);
+
+        ~TrajectoryStreamer();
+
+        void load(std::vector<Point> trajectory);
+
+        void start(const std::string& axisName, int axisID, int task, int depth);
+
+        void abort();
+
+        [[nodiscard]] bool is_running() const;
+
+        [[nodiscard]] int size() const;
+
+        [[nodiscard]] int progress() const;
+
+        [[nodiscard]] int underruns() const;
+
+        [[nodiscard]] std::string status() const;
+
+    private:
+        void run(std::string axisName, int axisID, int task, int depth);
+
+        void set_status(const std::string& text);
+
+        Automation1Controller& controller;
+
+        std::mutex& controller_mutex;
+
+        Controller_ns::FlightRecorder& recorder;
+
+        std::vector<Point> points;
+
+        std::thread thread;
+
+        std::atomic<bool> running{false};
+
+        std::atomic<bool> aborted{false};
+
+        std::atomic<int> executed{0};
+
+        std::atomic<int> underrun_count{0};
+
+        mutable std::mutex status_mutex;
+
+        std::string status_text{"idle"};
+    };
+}
+#endif   //	AUTOMATION1_TRAJECTORY_STREAMER_H
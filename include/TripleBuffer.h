@@ -0,0 +1,76 @@
+/*
+ * Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUTOMATION1_TRIPLE_BUFFER_H
+#define AUTOMATION1_TRIPLE_BUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+
+namespace Controller_ns
+{
+    /*
+     * Lock free hand over of a large value from one writer to one reader. The writer fills back() and publishes it,
+     * the reader takes the latest published value with acquire() and keeps using front() until its next acquire().
+     * Neither side ever waits for or copies the buffers of the other one, so the reader can hand front() to
+     * Tango without copying, e.g. with set_value(..., release = false).
+     */
+    template <typename T>
+    class TripleBuffer
+    {
+    public:
+        // Buffer owned by the writer.
+        T& back() { return buffers[back_index]; }
+
+        // Swaps back() with the published buffer. The writer then owns the buffer the reader released last.
+        void publish()
+        {
+            const auto previous = middle.exchange(static_cast<std::uint8_t>(back_index | fresh_bit),
+                                                  std::memory_order_acq_rel);
+            back_index = previous & index_mask;
+        }
+
+        // Takes the latest published buffer, if any was published since the last call. Returns true if it did.
+        bool acquire()
+        {
+            if (!(middle.load(std::memory_order_relaxed) & fresh_bit))
+                return false;
+            const auto previous = middle.exchange(front_index, std::memory_order_acq_rel);
+            front_index = previous & index_mask;
+            return true;
+        }
+
+        // Buffer owned by the reader.
+        T& front() { return buffers[front_index]; }
+
+    private:
+        static constexpr std::uint8_t index_mask = 0x3;
+
+        static constexpr std::uint8_t fresh_bit = 0x4;
+
+        std::array<T, 3> buffers{};
+
+        std::uint8_t back_index{0};
+
+        std::atomic<std::uint8_t> middle{1};
+
+        std::uint8_t front_index{2};
+    };
+}
+#endif   //	AUTOMATION1_TRIPLE_BUFFER_H
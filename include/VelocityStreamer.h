@@ -0,0 +1,108 @@
+/*
+ * Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUTOMATION1_VELOCITY_STREAMER_H
+#define AUTOMATION1_VELOCITY_STREAMER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "Sampler.h"
+
+
+namespace Axis_ns
+{
+    /*
+     * Streams velocity setpoints to a free running axis. Clients only store the latest setpoint, a server thread
+     * sends it at most at the configured rate (older setpoints that were not sent yet are dropped). If no setpoint
+     * arrives within the timeout, the axis is stopped.
+     */
+    class VelocityStreamer
+    {
+    public:
+        VelocityStreamer(Automation1Controller& controller, std::mutex& controller_mutex,
+                         Controller_ns::Sampler& sampler, Controller_ns::FlightRecorder& recorder, double rate,
+                         double timeout);
+
+        ~VelocityStreamer();
+
+        // Stores the setpoint and starts streaming if it is not running.
+        void set(int axisID, double velocity);
+
+        // Stops streaming. With halt the free run is stopped, otherwise the axis keeps its last velocity.
+        void stop(bool halt = true);
+
+        [[nodiscard]] bool is_running() const;
+
+        // Last setpoint sent to the controller.
+        [[nodiscard]] double velocity() const;
+
+        // Number of setpoints dropped because a newer one arrived before they were sent.
+        [[nodiscard]] long coalesced() const;
+
+        [[nodiscard]] std::string status();
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        void run(int axisID);
+
+        Automation1Controller& controller;
+
+        std::mutex& controller_mutex;
+
+        Controller_ns::Sampler& sampler;
+
+        Controller_ns::FlightRecorder& recorder;
+
+        Clock::duration period;
+
+        Clock::duration timeout;
+
+        std::thread thread;
+
+        std::atomic<bool> running{false};
+
+        std::atomic<double> applied{0.};
+
+        std::atomic<long> coalesced_count{0};
+
+        std::mutex mutex;
+
+        std::condition_variable cv;
+
+        double target{};
+
+        // A setpoint was stored that was not sent yet.
+        bool fresh{false};
+
+        bool stopping{false};
+
+        // The thread left its loop and no longer takes setpoints.
+        bool exiting{false};
+
+        bool halt_on_stop{true};
+
+        Clock::time_point last_update{};
+
+        std::string status_text{"idle"};
+    };
+}
+#endif   //	AUTOMATION1_VELOCITY_STREAMER_H
@@ -0,0 +1,89 @@
+/*
+ * Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUTOMATION1_WATCH_EXPRESSION_H
+#define AUTOMATION1_WATCH_EXPRESSION_H
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+
+namespace Controller_ns
+{
+    struct AxisSnapshot;
+
+    /*
+     * Condition over the status snapshot fields of one or more axes, e.g. "position > 12.5",
+     * "cw_limit or ccw_limit", "X.velocity >= 2 and (Y.drive_status & 0x4)". Fields without an axis refer to the
+     * default axis given to parse(). The expression is compiled to postfix operations, so evaluating it on every
+     * sample is a short loop without allocations.
+     */
+    class WatchExpression
+    {
+    public:
+        // Deepest nesting of operands an expression may use.
+        static constexpr std::size_t max_stack = 32;
+
+        // Returns the id of an axis name. Throws if there is none.
+        using AxisResolver = std::function<int(const std::string&)>;
+
+        // Throws a Tango exception on syntax errors and unknown fields.
+        static WatchExpression parse(const std::string& text, const AxisResolver& resolve,
+                                     std::optional<int> default_axis);
+
+        // Snapshots are looked up by axis id. False if any of them is missing.
+        [[nodiscard]] bool evaluate(const std::function<const AxisSnapshot*(int)>& snapshot) const;
+
+        // Axes the expression uses.
+        [[nodiscard]] const std::vector<int>& axes() const { return used_axes; }
+
+        [[nodiscard]] const std::string& text() const { return source; }
+
+    private:
+        enum class Field
+        {
+            Position, PositionCommand, Velocity, VelocityCommand, AxisStatus, DriveStatus, AxisFault, Enabled, Homed,
+            MotionDone, CwLimit, CcwLimit, Fault
+        };
+
+        struct Operation
+        {
+            enum Code
+            {
+                Constant, Load, Less, LessEqual, Greater, GreaterEqual, Equal, NotEqual, BitTest, And, Or, Not
+            };
+
+            Code code;
+            double value{};
+            int axisID{};
+            Field field{};
+        };
+
+        class Parser;
+
+        static double field_value(Field field, const AxisSnapshot& snapshot);
+
+        std::string source;
+
+        std::vector<Operation> program;
+
+        std::vector<int> used_axes;
+    };
+}
+#endif   //	AUTOMATION1_WATCH_EXPRESSION_H
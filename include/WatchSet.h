@@ -0,0 +1,86 @@
+/*
+ * Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef AUTOMATION1_WATCH_SET_H
+#define AUTOMATION1_WATCH_SET_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <optional>
+#include <tango/tango.h>
+#include <Automation1.h>
+#include "EventPusher.h"
+#include "Sampler.h"
+#include "WatchExpression.h"
+
+
+namespace Controller_ns
+{
+    /*
+     * Watches of one device. Each one is exposed as the boolean attribute watch_<name>, which pushes a change event
+     * whenever the sampler finds that the state of its expression changed. The events are pushed in order through
+     * the EventPusher of the device, which must outlive the watch set.
+     */
+    class WatchSet
+    {
+    public:
+        WatchSet(Tango::DeviceImpl& device, EventPusher& events, Automation1Controller& controller,
+                 std::mutex& controller_mutex, Sampler& sampler);
+
+        ~WatchSet();
+
+        // Parses expression, axis names are resolved on the controller under controller_mutex. The device takes the
+        // ownership of attribute, the Attr of its class for watch_<name>.
+        void add(const std::string& name, const std::string& expression, std::optional<int> default_axis,
+                 std::unique_ptr<Tango::Attr> attribute);
+
+        void remove(const std::string& name);
+
+        void clear();
+
+        void read(Tango::Attribute& attribute);
+
+        // One "name: expression" entry per watch.
+        [[nodiscard]] std::vector<std::string> list() const;
+
+        [[nodiscard]] static std::string attribute_name(const std::string& name) { return "watch_" + name; }
+
+    private:
+        struct Watch
+        {
+            std::string expression;
+            int id{};
+            Tango::DevBoolean value{};
+        };
+
+        Tango::DeviceImpl& device;
+
+        EventPusher& events;
+
+        Automation1Controller& controller;
+
+        std::mutex& controller_mutex;
+
+        Sampler& sampler;
+
+        std::map<std::string, Watch> watches;
+    };
+}
+#endif   //	AUTOMATION1_WATCH_SET_H
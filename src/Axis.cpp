@@ -18,13 +18,54 @@
 #include "Axis.h"
 #include "AxisClass.h"
 #include "ControllerClass.h"
+#include "Trace.h"
 #include <Automation1.h>
+#include <cctype>
 #include <complex>
+#include <sstream>
 #include <stdexcept>
 
 
 namespace Axis_ns
 {
+    namespace
+    {
+        // Maximum length of the position_history spectrum attributes.
+        constexpr Tango::DevLong position_history_max_points = 100000;
+
+        Tango::TimeVal to_timeval(const Controller_ns::SampleClock::time_point time)
+        {
+            const auto us = std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+            Tango::TimeVal tv{};
+            tv.tv_sec = static_cast<decltype(tv.tv_sec)>(us / 1000000);
+            tv.tv_usec = static_cast<decltype(tv.tv_usec)>(us % 1000000);
+            return tv;
+        }
+
+        // Attribute name of a telemetry item, e.g. drive_amplifier_temperature for AmplifierTemperature.
+        std::string telemetry_attribute_name(const std::string& item)
+        {
+            std::string name = "drive";
+            for (const char c : item)
+            {
+                if (std::isupper(static_cast<unsigned char>(c)))
+                    name += '_';
+                name += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            }
+            return name;
+        }
+
+        void check_response(const bool response, const char* origin)
+        {
+            if (!response)
+            {
+                char msg[100];
+                Automation1_GetLastErrorMessage(msg, 100);
+                Tango::Except::throw_exception("CommandFailed", msg, origin);
+            }
+        }
+    }
+
     Axis::Axis(Tango::DeviceClass* cl, const std::string& s) : TANGO_BASE_CLASS(cl, s.c_str())
     {
         Axis::init_device();
@@ -48,7 +89,32 @@ namespace Axis_ns
     void Axis::delete_device()
     {
         DEBUG_STREAM << "Axis::delete_device() " << device_name << std::endl;
-        Automation1_StatusConfig_Destroy(statusConfig);
+        cancel_motion_notification();
+        watches.reset();
+        events.reset();
+        if (sampled)
+            Controller_ns::ControllerClass::instance()->sampler.remove_axis(axisID);
+        sampled = false;
+        if (telemetry_registered)
+            for (const auto& channel : telemetry)
+                Controller_ns::ControllerClass::instance()->telemetry.remove(axisID, channel.item);
+        telemetry_registered = false;
+        for (const auto& channel : telemetry)
+        {
+            try
+            {
+                remove_attribute(channel.attribute, false, false);
+            }
+            catch (const Tango::DevFailed&)
+            {
+                // not added, e.g. init_hardware() failed
+            }
+        }
+        trajectory.reset();
+        step_scan.reset();
+        capture.reset();
+        retarget.reset();
+        velocity_stream.reset();
         delete attr_motion_velocity;
         delete attr_position_read;
         delete attr_faults_read;
@@ -56,6 +122,29 @@ namespace Axis_ns
         delete attr_accelerating_read;
         delete attr_negative_softlimit_read;
         delete attr_positive_softlimit_read;
+        delete attr_positive_hard_limit_read;
+        delete attr_negative_hard_limit_read;
+        delete attr_sampling_rate_read;
+        delete attr_pso_armed_read;
+        delete attr_trajectory_progress_read;
+        delete attr_trajectory_underruns_read;
+        delete attr_trajectory_status_read;
+        delete attr_step_scan_progress_read;
+        delete attr_step_scan_status_read;
+        delete attr_capture_count_read;
+        delete attr_capture_restarts_read;
+        delete attr_capture_dropped_read;
+        delete attr_capture_armed_read;
+        delete attr_position_history_window;
+        delete attr_position_history_points;
+        delete attr_velocity_setpoint_read;
+        delete attr_velocity_stream_coalesced_read;
+        delete attr_velocity_stream_status_read;
+        delete attr_retarget_enabled;
+        delete attr_retarget_status_read;
+        delete attr_suppressed_state_changes_read;
+        delete attr_motion_done_read;
+        delete attr_motion_result_read;
     }
 
     void Axis::init_device()
@@ -63,33 +152,6 @@ namespace Axis_ns
         DEBUG_STREAM << "Axis::init_device() create device " << device_name << std::endl;
         get_device_property();
 
-        Automation1_Controller_GetAxisIndexFromAxisName(Controller_ns::ControllerClass::instance()->controller,
-                                                        axisName.c_str(), &axisID);
-        Automation1_StatusConfig_Create(&statusConfig);
-
-
-        auto getKeyByValue = [&](const auto& map, const auto& value)
-        {
-            auto it = std::find_if(map.begin(), map.end(), [&](const auto& pair)
-            {
-                return pair.second == value;
-            });
-            if (it != map.end())
-            {
-                return it->first;
-            }
-            else
-            {
-                throw std::runtime_error("Value not found in the map");
-            }
-        };
-
-        for (int i = 0; i < axisStates.size(); i++)
-        {
-            auto fst = getKeyByValue(axisStates, i);
-            Automation1_StatusConfig_AddAxisStatusItem(statusConfig, axisID, fst, 0);
-        }
-
         attr_motion_velocity = new Tango::DevDouble();
         *attr_motion_velocity = 5.f;
         attr_position_read = new Tango::DevDouble();
@@ -100,15 +162,121 @@ namespace Axis_ns
         attr_positive_softlimit_read = new Tango::DevDouble();
         attr_positive_hard_limit_read = new Tango::DevBoolean();
         attr_negative_hard_limit_read = new Tango::DevBoolean();
+        attr_sampling_rate_read = new Tango::DevDouble();
+        attr_pso_armed_read = new Tango::DevBoolean();
+        attr_trajectory_progress_read = new Tango::DevLong();
+        attr_trajectory_underruns_read = new Tango::DevLong();
+        attr_trajectory_status_read = new Tango::DevString();
+        attr_step_scan_progress_read = new Tango::DevLong();
+        attr_step_scan_status_read = new Tango::DevString();
+        attr_capture_count_read = new Tango::DevLong();
+        attr_capture_restarts_read = new Tango::DevLong();
+        attr_capture_dropped_read = new Tango::DevLong();
+        attr_capture_armed_read = new Tango::DevBoolean();
+        attr_position_history_window = new Tango::DevDouble();
+        *attr_position_history_window = 60.;
+        attr_position_history_points = new Tango::DevLong();
+        *attr_position_history_points = 1000;
+        attr_velocity_setpoint_read = new Tango::DevDouble();
+        attr_velocity_stream_coalesced_read = new Tango::DevLong();
+        attr_velocity_stream_status_read = new Tango::DevString();
+        attr_retarget_enabled = new Tango::DevBoolean();
+        *attr_retarget_enabled = false;
+        attr_retarget_status_read = new Tango::DevString();
+        attr_suppressed_state_changes_read = new Tango::DevLong64();
+        attr_motion_done_read = new Tango::DevBoolean();
+        attr_motion_result_read = new Tango::DevString();
+        motion_done = true;
+        motion_result.clear();
+        events = std::make_unique<Controller_ns::EventPusher>(*this);
+        pso.reset();
+        trajectory = std::make_unique<TrajectoryStreamer>(Controller_ns::ControllerClass::instance()->controller,
+                                                          Controller_ns::ControllerClass::instance()->mutex,
+                                                          Controller_ns::ControllerClass::instance()->recorder);
+        step_scan = std::make_unique<StepScan>(Controller_ns::ControllerClass::instance()->controller,
+                                               Controller_ns::ControllerClass::instance()->mutex,
+                                               Controller_ns::ControllerClass::instance()->sampler,
+                                               Controller_ns::ControllerClass::instance()->recorder);
+        capture = std::make_unique<PositionCapture>(Controller_ns::ControllerClass::instance()->controller,
+                                                    Controller_ns::ControllerClass::instance()->mutex);
+        velocity_stream = std::make_unique<VelocityStreamer>(Controller_ns::ControllerClass::instance()->controller,
+                                                             Controller_ns::ControllerClass::instance()->mutex,
+                                                             Controller_ns::ControllerClass::instance()->sampler,
+                                                             Controller_ns::ControllerClass::instance()->recorder,
+                                                             velocityStreamRate, velocityStreamTimeout);
+        retarget = std::make_unique<Retarget>(Controller_ns::ControllerClass::instance()->controller,
+                                              Controller_ns::ControllerClass::instance()->mutex,
+                                              Controller_ns::ControllerClass::instance()->sampler,
+                                              Controller_ns::ControllerClass::instance()->recorder,
+                                              *velocity_stream, retargetAcceleration, velocityStreamRate);
+        watches = std::make_unique<Controller_ns::WatchSet>(*this, *events,
+                                                            Controller_ns::ControllerClass::instance()->controller,
+                                                            Controller_ns::ControllerClass::instance()->mutex,
+                                                            Controller_ns::ControllerClass::instance()->sampler);
+
+        if (!dynamic_cast<AxisClass*>(get_device_class())->deferred_init)
+        {
+            init_hardware();
+            add_dynamic_attributes();
+        }
+    }
 
+    void Axis::init_hardware()
+    {
+        init_error.clear();
+        parse_telemetry_items();
+        state_filter.configure(stateDebounce, stateMinDwell);
+        if (Controller_ns::ControllerClass::instance()->controller == nullptr)
+            Tango::Except::throw_exception("Controller not connected", "The conctroller is not connected",
+                                           "init_hardware()");
+
+        {
+            std::lock_guard lk(Controller_ns::ControllerClass::instance()->mutex);
+            if (!Automation1_Controller_GetAxisIndexFromAxisName(
+                Controller_ns::ControllerClass::instance()->controller, axisName.c_str(), &axisID))
+            {
+                char msg[100];
+                Automation1_GetLastErrorMessage(msg, 100);
+                Tango::Except::throw_exception("AxisNotFound", std::format("Axis {}: {}", axisName, msg),
+                                               "init_hardware()");
+            }
+        }
+        Controller_ns::ControllerClass::instance()->sampler.add_axis(axisID);
+        sampled = true;
+        for (const auto& channel : telemetry)
+            Controller_ns::ControllerClass::instance()->telemetry.add(axisID, channel.item);
+        telemetry_registered = true;
 
         DEBUG_STREAM << "axis " << axisName << " with id " << axisID << " found." << std::endl;
     }
 
+    void Axis::set_init_error(const std::string& error)
+    {
+        init_error = error;
+        ERROR_STREAM << "Axis::init_hardware() " << device_name << ": " << error << std::endl;
+    }
+
     void Axis::get_device_property()
     {
         Tango::DbData dev_prop;
         dev_prop.emplace_back("axisName");
+        dev_prop.emplace_back("psoInput");
+        dev_prop.emplace_back("psoOutput");
+        dev_prop.emplace_back("psoArrayAddress");
+        dev_prop.emplace_back("psoArraySize");
+        dev_prop.emplace_back("trajectoryTask");
+        dev_prop.emplace_back("trajectoryQueueDepth");
+        dev_prop.emplace_back("captureInput");
+        dev_prop.emplace_back("captureTrigger");
+        dev_prop.emplace_back("captureArrayAddress");
+        dev_prop.emplace_back("captureArraySize");
+        dev_prop.emplace_back("captureMaxPoints");
+        dev_prop.emplace_back("velocityStreamRate");
+        dev_prop.emplace_back("velocityStreamTimeout");
+        dev_prop.emplace_back("retargetAcceleration");
+        dev_prop.emplace_back("telemetryItems");
+        dev_prop.emplace_back("stateDebounce");
+        dev_prop.emplace_back("stateMinDwell");
 
         if (!dev_prop.empty())
         {
@@ -128,6 +296,176 @@ namespace Axis_ns
                     def_prop >> axisName;
             }
             if (!dev_prop[i].is_empty()) dev_prop[i] >> axisName;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty())
+                cl_prop >> psoInput;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty())
+                    def_prop >> psoInput;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> psoInput;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty())
+                cl_prop >> psoOutput;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty())
+                    def_prop >> psoOutput;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> psoOutput;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty())
+                cl_prop >> psoArrayAddress;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty())
+                    def_prop >> psoArrayAddress;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> psoArrayAddress;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty())
+                cl_prop >> psoArraySize;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty())
+                    def_prop >> psoArraySize;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> psoArraySize;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty())
+                cl_prop >> trajectoryTask;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty())
+                    def_prop >> trajectoryTask;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> trajectoryTask;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty())
+                cl_prop >> trajectoryQueueDepth;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty())
+                    def_prop >> trajectoryQueueDepth;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> trajectoryQueueDepth;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty())
+                cl_prop >> captureInput;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty())
+                    def_prop >> captureInput;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> captureInput;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty())
+                cl_prop >> captureTrigger;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty())
+                    def_prop >> captureTrigger;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> captureTrigger;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty())
+                cl_prop >> captureArrayAddress;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty())
+                    def_prop >> captureArrayAddress;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> captureArrayAddress;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty())
+                cl_prop >> captureArraySize;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty())
+                    def_prop >> captureArraySize;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> captureArraySize;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty())
+                cl_prop >> captureMaxPoints;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty())
+                    def_prop >> captureMaxPoints;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> captureMaxPoints;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty())
+                cl_prop >> velocityStreamRate;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty())
+                    def_prop >> velocityStreamRate;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> velocityStreamRate;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty())
+                cl_prop >> velocityStreamTimeout;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty())
+                    def_prop >> velocityStreamTimeout;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> velocityStreamTimeout;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty())
+                cl_prop >> retargetAcceleration;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty())
+                    def_prop >> retargetAcceleration;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> retargetAcceleration;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty())
+                cl_prop >> telemetryItems;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty())
+                    def_prop >> telemetryItems;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> telemetryItems;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty())
+                cl_prop >> stateDebounce;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty())
+                    def_prop >> stateDebounce;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> stateDebounce;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty())
+                cl_prop >> stateMinDwell;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty())
+                    def_prop >> stateMinDwell;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> stateMinDwell;
         }
     }
 
@@ -137,74 +475,217 @@ namespace Axis_ns
     }
 
 
-    void Axis::read_attr_hardware(TANGO_UNUSED(std::vector<long> &attr_list))
+    void Axis::read_attr_hardware(std::vector<long>& attr_list)
     {
+        bool history = false;
+        bool captured = false;
+        for (const auto index : attr_list)
+        {
+            const auto& name = get_device_attr()->get_attr_by_ind(index).get_name();
+            history |= name == "position_history" || name == "position_history_time";
+            captured |= name == "captured_positions" || name == "captured_indices";
+        }
+        if (history)
+            Controller_ns::ControllerClass::instance()->sampler.position_history(
+                axisID, *attr_position_history_window, *attr_position_history_points, position_history_time,
+                position_history);
+        // Both capture attributes of one request are served from the same buffer, which stays untouched by the
+        // capture thread until the next request.
+        if (captured)
+            capture->acquire();
     }
 
 
     void Axis::add_dynamic_attributes()
     {
+        for (const auto& channel : telemetry)
+        {
+            auto* attribute = new telemetryAttrib(channel.attribute);
+            Tango::UserDefaultAttrProp attribute_prop;
+            attribute_prop.set_description("Drive telemetry item, read at the telemetry_rate of the controller.");
+            // Defaults of the attribute, so the limits of telemetryItems are not written to the database.
+            if (channel.min_alarm)
+                attribute_prop.set_min_alarm(std::format("{}", *channel.min_alarm).c_str());
+            if (channel.max_alarm)
+                attribute_prop.set_max_alarm(std::format("{}", *channel.max_alarm).c_str());
+            attribute->set_default_properties(attribute_prop);
+            attribute->set_disp_level(Tango::OPERATOR);
+            add_attribute(attribute);
+        }
+    }
+
+    void Axis::watch_add(const Tango::DevVarStringArray* arg_in)
+    {
+        if (arg_in->length() != 2)
+            Tango::Except::throw_exception("InvalidArgument", "Expected [name, expression]", "Axis::watch_add()");
+        const std::string name((*arg_in)[0].in());
+        DEBUG_STREAM << "Axis::watch_add() " << name << ": " << (*arg_in)[1].in() << std::endl;
+        watches->add(name, (*arg_in)[1].in(), axisID,
+                     std::make_unique<watchAttrib>(Controller_ns::WatchSet::attribute_name(name)));
+    }
+
+    void Axis::watch_remove(const Tango::DevString name)
+    {
+        DEBUG_STREAM << "Axis::watch_remove() " << name << std::endl;
+        watches->remove(name);
+    }
+
+    Tango::DevVarStringArray* Axis::watch_list()
+    {
+        const auto entries = watches->list();
+        auto* argout = new Tango::DevVarStringArray();
+        argout->length(static_cast<CORBA::ULong>(entries.size()));
+        for (std::size_t i = 0; i < entries.size(); i++)
+            (*argout)[i] = Tango::string_dup(entries[i].c_str());
+        return argout;
+    }
+
+    bool Axis::is_watch_allowed(const CORBA::Any& type)
+    {
+        return init_error.empty();
+    }
+
+    void Axis::read_watch(Tango::Attribute& attribute)
+    {
+        watches->read(attribute);
+    }
+
+    void Axis::parse_telemetry_items()
+    {
+        telemetry.clear();
+        for (const auto& entry : telemetryItems)
+        {
+            std::vector<std::string> fields;
+            std::istringstream stream(entry);
+            for (std::string field; std::getline(stream, field, ':');)
+                fields.push_back(field);
+
+            const auto& items = Controller_ns::telemetry_items();
+            const auto item = fields.empty() ? items.end() : items.find(fields[0]);
+            if (item == items.end() || fields.size() > 3)
+                Tango::Except::throw_exception("InvalidProperty",
+                                               std::format("Invalid telemetry item '{}' of {}", entry, axisName),
+                                               "Axis::parse_telemetry_items()");
+            TelemetryChannel channel{telemetry_attribute_name(item->first), item->second};
+            if (std::ranges::find(telemetry, channel.attribute, &TelemetryChannel::attribute) != telemetry.end())
+                continue;
+            try
+            {
+                if (fields.size() > 1 && !fields[1].empty())
+                    channel.min_alarm = std::stod(fields[1]);
+                if (fields.size() > 2 && !fields[2].empty())
+                    channel.max_alarm = std::stod(fields[2]);
+            }
+            catch (const std::exception&)
+            {
+                Tango::Except::throw_exception("InvalidProperty",
+                                               std::format("Invalid alarm limit in telemetry item '{}' of {}", entry,
+                                                           axisName), "Axis::parse_telemetry_items()");
+            }
+            telemetry.push_back(channel);
+        }
+    }
+
+    void Axis::read_telemetry(Tango::Attribute& attribute)
+    {
+        const auto channel = std::ranges::find(telemetry, attribute.get_name(), &TelemetryChannel::attribute);
+        if (channel == telemetry.end())
+            Tango::Except::throw_exception("NotConfigured", attribute.get_name() + " is not in telemetryItems",
+                                           "Axis::read_telemetry()");
+        const auto value = Controller_ns::ControllerClass::instance()->telemetry.value(axisID, channel->item);
+        if (!value)
+        {
+            const auto error = Controller_ns::ControllerClass::instance()->telemetry.last_error();
+            Tango::Except::throw_exception("NoTelemetry", error.empty() ? "No telemetry sample available" : error,
+                                           "Axis::read_telemetry()");
+        }
+        channel->value = value->value;
+        attribute.set_value_date_quality(&channel->value, to_timeval(value->timestamp), Tango::ATTR_VALID);
     }
 
     void Axis::enable()
     {
-        DEBUG_STREAM << "Axis::enable()  - " << device_name << std::endl;
+        TRACE_SCOPE(Controller_ns::trace_calls, "Axis::enable", "axis", axisID);
         std::lock_guard<std::mutex> lk(Controller_ns::ControllerClass::instance()->mutex);
-        if (const auto response = Automation1_Command_Enable(Controller_ns::ControllerClass::instance()->controller,
-                                                             1, &axisID, 1); !response)
+        TRACE_SCOPE(Controller_ns::trace_calls, "Automation1_Command_Enable", "axis", axisID);
+        const auto response = Automation1_Command_Enable(Controller_ns::ControllerClass::instance()->controller,
+                                                         1, &axisID, 1);
+        record(Controller_ns::FlightCommand::Enable, {}, response);
+        if (!response)
         {
             char msg[100];
             Automation1_GetLastErrorMessage(msg, 100);
             ERROR_STREAM << msg << std::endl;
         }
+        Controller_ns::ControllerClass::instance()->sampler.invalidate(axisID);
     }
 
     void Axis::stop()
     {
-        DEBUG_STREAM << "Axis::stop()  - " << device_name << std::endl;
+        TRACE_SCOPE(Controller_ns::trace_calls, "Axis::stop", "axis", axisID);
+        // Streaming threads would keep sending motion after the stop.
+        trajectory->abort();
+        step_scan->abort();
+        retarget->abort();
+        velocity_stream->stop(false);
         std::lock_guard<std::mutex> lk(Controller_ns::ControllerClass::instance()->mutex);
-        if (const auto response = Automation1_Command_MoveFreerunStop(
-            Controller_ns::ControllerClass::instance()->controller, 1, &axisID, 1); !response)
+        TRACE_SCOPE(Controller_ns::trace_calls, "Automation1_Command_MoveFreerunStop", "axis", axisID);
+        const auto response = Automation1_Command_MoveFreerunStop(
+            Controller_ns::ControllerClass::instance()->controller, 1, &axisID, 1);
+        record(Controller_ns::FlightCommand::Stop, {}, response);
+        if (!response)
         {
             char msg[100];
             Automation1_GetLastErrorMessage(msg, 100);
             ERROR_STREAM << msg << std::endl;
         }
+        Controller_ns::ControllerClass::instance()->sampler.invalidate(axisID);
     }
 
     void Axis::home()
     {
-        DEBUG_STREAM << "Axis::home()  - " << device_name << std::endl;
+        TRACE_SCOPE(Controller_ns::trace_calls, "Axis::home", "axis", axisID);
         std::lock_guard<std::mutex> lk(Controller_ns::ControllerClass::instance()->mutex);
-        if (const auto response = Automation1_Command_HomeAsync(
-            Controller_ns::ControllerClass::instance()->controller, 1, &axisID, 1); !response)
+        TRACE_SCOPE(Controller_ns::trace_calls, "Automation1_Command_HomeAsync", "axis", axisID);
+        const auto response = Automation1_Command_HomeAsync(
+            Controller_ns::ControllerClass::instance()->controller, 1, &axisID, 1);
+        record(Controller_ns::FlightCommand::Home, {}, response);
+        if (!response)
         {
             char msg[100];
             Automation1_GetLastErrorMessage(msg, 100);
             ERROR_STREAM << msg << std::endl;
         }
+        Controller_ns::ControllerClass::instance()->sampler.invalidate(axisID);
     }
 
     void Axis::disable()
     {
-        DEBUG_STREAM << "Axis::home()  - " << device_name << std::endl;
+        TRACE_SCOPE(Controller_ns::trace_calls, "Axis::disable", "axis", axisID);
         std::lock_guard<std::mutex> lk(Controller_ns::ControllerClass::instance()->mutex);
-        if (const auto response = Automation1_Command_Disable(
-            Controller_ns::ControllerClass::instance()->controller, &axisID, 1); !response)
+        TRACE_SCOPE(Controller_ns::trace_calls, "Automation1_Command_Disable", "axis", axisID);
+        const auto response = Automation1_Command_Disable(
+            Controller_ns::ControllerClass::instance()->controller, &axisID, 1);
+        record(Controller_ns::FlightCommand::Disable, {}, response);
+        if (!response)
         {
             char msg[100];
             Automation1_GetLastErrorMessage(msg, 100);
             ERROR_STREAM << msg << std::endl;
         }
+        Controller_ns::ControllerClass::instance()->sampler.invalidate(axisID);
     }
 
     void Axis::fault_ack()
     {
-        DEBUG_STREAM << "Axis::fault_ack()  - " << device_name << std::endl;
+        TRACE_SCOPE(Controller_ns::trace_calls, "Axis::fault_ack", "axis", axisID);
         std::lock_guard<std::mutex> lk(Controller_ns::ControllerClass::instance()->mutex);
-        if (const auto response = Automation1_Command_FaultAcknowledge(
+        TRACE_SCOPE(Controller_ns::trace_calls, "Automation1_Command_FaultAcknowledge", "axis", axisID);
+        const auto response = Automation1_Command_FaultAcknowledge(
             Controller_ns::ControllerClass::instance()->controller,
-            1, &axisID, 1); !response)
+            1, &axisID, 1);
+        record(Controller_ns::FlightCommand::FaultAck, {}, response);
+        if (!response)
         {
             char msg[100];
             Automation1_GetLastErrorMessage(msg, 100);
@@ -213,15 +694,25 @@ namespace Axis_ns
         auto sub_axes = get_gantry_sub_axes();
         for (auto sub_axis : sub_axes)
         {
-            if (const auto response = Automation1_Command_FaultAcknowledge(
+            const auto sub_response = Automation1_Command_FaultAcknowledge(
                 Controller_ns::ControllerClass::instance()->controller,
-                1, &sub_axis, 1); !response)
+                1, &sub_axis, 1);
+            Controller_ns::ControllerClass::instance()->recorder.command(Controller_ns::FlightCommand::FaultAck,
+                                                                         sub_axis, {}, sub_response);
+            if (!sub_response)
             {
                 char msg[100];
                 Automation1_GetLastErrorMessage(msg, 100);
                 ERROR_STREAM << msg << std::endl;
             }
         }
+        Controller_ns::ControllerClass::instance()->sampler.invalidate(axisID);
+    }
+
+    void Axis::record(const Controller_ns::FlightCommand command, const std::initializer_list<double> arguments,
+                      const bool ok) const
+    {
+        Controller_ns::ControllerClass::instance()->recorder.command(command, axisID, arguments, ok);
     }
 
     void Axis::add_dynamic_commands()
@@ -230,65 +721,167 @@ namespace Axis_ns
 
     void Axis::read_position(Tango::Attribute& attribute) const
     {
-        std::lock_guard<std::mutex> lk(Controller_ns::ControllerClass::instance()->mutex);
-        if (Controller_ns::ControllerClass::instance()->controller == nullptr)
-            Tango::Except::throw_exception("Controller not connected", "The conctroller is not connected",
-                                           "read_position()");
-
-        double results[axisStates.size()];
-        Automation1_Status_GetResults(Controller_ns::ControllerClass::instance()->controller,
-                                      statusConfig,
-                                      results,
-                                      static_cast<int>(sizeof(results) / sizeof(double)));
-
-        *attr_position_read = results[axisStates.at(Automation1AxisStatusItem_ProgramPositionFeedback)];
-        attribute.set_value(attr_position_read);
+        const auto snapshot = get_snapshot();
+        *attr_position_read = snapshot.position_feedback;
+        attribute.set_value_date_quality(attr_position_read, to_timeval(snapshot.timestamp), Tango::ATTR_VALID);
     }
 
     void Axis::read_position_target(Tango::Attribute& attribute) const
     {
-        std::lock_guard<std::mutex> lk(Controller_ns::ControllerClass::instance()->mutex);
-        if (Controller_ns::ControllerClass::instance()->controller == nullptr)
-            Tango::Except::throw_exception("Controller not connected", "The conctroller is not connected",
-                                           "read_position_target()");
-
-        double results[axisStates.size()];
-        Automation1_Status_GetResults(Controller_ns::ControllerClass::instance()->controller,
-                                      statusConfig,
-                                      results,
-                                      static_cast<int>(sizeof(results) / sizeof(double)));
-
-        *attr_position_target_read = results[axisStates.at(Automation1AxisStatusItem_ProgramPositionCommand)];
-        attribute.set_value(attr_position_target_read);
+        const auto snapshot = get_snapshot();
+        *attr_position_target_read = snapshot.position_command;
+        attribute.set_value_date_quality(attr_position_target_read, to_timeval(snapshot.timestamp),
+                                         Tango::ATTR_VALID);
     }
 
     void Axis::write_position(Tango::WAttribute& attribute)
     {
-        std::lock_guard<std::mutex> lk(Controller_ns::ControllerClass::instance()->mutex);
         Tango::DevDouble w_val;
         attribute.get_write_value(w_val);
-        if (const auto response = Automation1_Command_MoveAbsolute(
-            Controller_ns::ControllerClass::instance()->controller, 1, &axisID, 1, &w_val,
-            1, attr_motion_velocity, 1); !response)
+        if (can_retarget())
+        {
+            try
+            {
+                retarget->move_to(axisID, w_val, *attr_motion_velocity, is_motion_finished);
+            }
+            catch (const Tango::DevFailed&)
+            {
+                record(Controller_ns::FlightCommand::Retarget, {w_val, *attr_motion_velocity}, false);
+                throw;
+            }
+            record(Controller_ns::FlightCommand::Retarget, {w_val, *attr_motion_velocity}, true);
+        }
+        else
+            move_absolute(w_val);
+    }
+
+    bool Axis::can_retarget()
+    {
+        if (!*attr_retarget_enabled || trajectory->is_running() || step_scan->is_running())
+            return false;
+        if (retarget->is_running())
+            return true;
+        return raw_state() == Tango::MOVING && !get_axis_status(get_snapshot()).homing;
+    }
+
+    void Axis::move_absolute(double position)
+    {
+        std::lock_guard<std::mutex> lk(Controller_ns::ControllerClass::instance()->mutex);
+        TRACE_SCOPE(Controller_ns::trace_calls, "Automation1_Command_MoveAbsolute", "axis", axisID);
+        const auto response = Automation1_Command_MoveAbsolute(
+            Controller_ns::ControllerClass::instance()->controller, 1, &axisID, 1, &position,
+            1, attr_motion_velocity, 1);
+        record(Controller_ns::FlightCommand::MoveAbsolute, {position, *attr_motion_velocity}, response);
+        if (!response)
         {
             ERROR_STREAM << "Motion not successful." << std::endl;
         }
+        Controller_ns::ControllerClass::instance()->sampler.invalidate(axisID);
+    }
+
+    bool Axis::is_motion_finished(const Controller_ns::AxisSnapshot& snapshot)
+    {
+        const auto [enabled, cw_end_of_travel_limit_input, ccw_end_of_travel_limit_input, emergency_stop_input,
+            accelerating, decelerating, move_active] = get_drive_status(snapshot);
+        const auto status = get_axis_status(snapshot);
+        return get_axis_faults(snapshot).anyFault || !enabled || (!status.homing && status.motion_done);
+    }
+
+    void Axis::notify_motion_done(const Tango::DevDouble timeout)
+    {
+        TRACE_SCOPE(Controller_ns::trace_calls, "Axis::notify_motion_done", "axis", axisID);
+        if (!(timeout > 0))
+            Tango::Except::throw_exception("InvalidArgument", "The timeout must be positive",
+                                           "notify_motion_done()");
+        cancel_motion_notification();
+        const auto generation = ++motion_generation;
+        // The result is posted to the event thread, which pushes it under the device monitor, i.e. not before this
+        // request returned.
+        motion_notification = Controller_ns::ControllerClass::instance()->sampler.notify_axis(
+            axisID, is_motion_finished, std::chrono::duration<double>(timeout),
+            [this, generation, timeout](const std::optional<Controller_ns::AxisSnapshot>& snapshot)
+            {
+                std::string result = "DONE";
+                if (!snapshot)
+                    result = std::format("TIMEOUT: motion of {} not done after {} s", axisName, timeout);
+                else if (get_axis_faults(*snapshot).anyFault)
+                    result = "FAULT";
+                else if (!get_drive_status(*snapshot).enabled)
+                    result = "DISABLED";
+                events->post("motion_done", [this, generation, result]
+                {
+                    if (generation != motion_generation)
+                        return;
+                    motion_notification.reset();
+                    motion_done = true;
+                    motion_result = result;
+                    push_motion_done();
+                });
+            });
+        motion_done = false;
+        motion_result.clear();
+        push_motion_done();
+    }
+
+    bool Axis::is_notify_motion_done_allowed(const CORBA::Any& type)
+    {
+        return init_error.empty();
+    }
+
+    void Axis::move_and_notify(const Tango::DevVarDoubleArray* arg_in)
+    {
+        if (arg_in->length() != 2)
+            Tango::Except::throw_exception("InvalidArgument", "Expected [position, timeout]", "move_and_notify()");
+        move_absolute((*arg_in)[0]);
+        notify_motion_done((*arg_in)[1]);
+    }
+
+    bool Axis::is_move_and_notify_allowed(const CORBA::Any& type)
+    {
+        return raw_state() == Tango::STANDBY;
+    }
+
+    void Axis::cancel_motion_notification()
+    {
+        if (motion_notification)
+            Controller_ns::ControllerClass::instance()->sampler.cancel_notify(*motion_notification);
+        motion_notification.reset();
+    }
+
+    void Axis::push_motion_done()
+    {
+        *attr_motion_done_read = motion_done;
+        push_change_event("motion_done", attr_motion_done_read);
+        *attr_motion_result_read = motion_result.data();
+        push_change_event("motion_result", attr_motion_result_read);
+    }
+
+    void Axis::read_motion_done(Tango::Attribute& attribute)
+    {
+        *attr_motion_done_read = motion_done;
+        attribute.set_value(attr_motion_done_read);
+    }
+
+    void Axis::read_motion_result(Tango::Attribute& attribute)
+    {
+        *attr_motion_result_read = motion_result.data();
+        attribute.set_value(attr_motion_result_read);
     }
 
     bool Axis::is_enable_allowed(const CORBA::Any& type)
     {
         return true;
-        return dev_state() == Tango::DISABLE;
+        return raw_state() == Tango::DISABLE;
     }
 
     bool Axis::is_home_allowed(const CORBA::Any& type)
     {
-        return dev_state() == Tango::STANDBY;
+        return raw_state() == Tango::STANDBY;
     }
 
     bool Axis::is_disable_allowed(const CORBA::Any& type)
     {
-        return dev_state() == Tango::STANDBY;
+        return raw_state() == Tango::STANDBY;
     }
 
     bool Axis::is_stop_allowed(const CORBA::Any& type)
@@ -298,7 +891,7 @@ namespace Axis_ns
 
     bool Axis::is_fault_ack_allowed(const CORBA::Any& type)
     {
-        return dev_state() == Tango::FAULT;
+        return raw_state() == Tango::FAULT;
     }
 
     bool Axis::is_position_allowed(const Tango::AttReqType type)
@@ -309,19 +902,19 @@ namespace Axis_ns
         }
         else
         {
-            return dev_state() == Tango::STANDBY;
+            return raw_state() == Tango::STANDBY || can_retarget();
         }
     }
 
     void Axis::read_positive_hard_limit(Tango::Attribute& att)
     {
+        const auto snapshot = get_snapshot();
+        auto [enabled, cw_end_of_travel_limit_input, ccw_end_of_travel_limit_input, emergency_stop_input, accelerating,
+            decelerating, move_active] = get_drive_status(snapshot);
         std::lock_guard lk(Controller_ns::ControllerClass::instance()->mutex);
         double motor_direction;
-        bool limit_switch;
         Automation1_Parameter_GetAxisValue(Controller_ns::ControllerClass::instance()->controller, axisID,
                                            Automation1AxisParameterId_ReverseMotionDirection, &motor_direction);
-        auto [enabled, cw_end_of_travel_limit_input, ccw_end_of_travel_limit_input, emergency_stop_input, accelerating,
-            decelerating, move_active] = get_drive_status();
         if (int(motor_direction) == 0)
         {
             *attr_positive_hard_limit_read = ccw_end_of_travel_limit_input;
@@ -331,28 +924,29 @@ namespace Axis_ns
             *attr_positive_hard_limit_read = cw_end_of_travel_limit_input;
         }
 
-        att.set_value(attr_positive_hard_limit_read);
+        att.set_value_date_quality(attr_positive_hard_limit_read, to_timeval(snapshot.timestamp), Tango::ATTR_VALID);
     }
 
 
     void Axis::read_negative_hard_limit(Tango::Attribute& att)
     {
+        const auto snapshot = get_snapshot();
+        auto [enabled, cw_end_of_travel_limit_input, ccw_end_of_travel_limit_input, emergency_stop_input, accelerating,
+            decelerating, move_active] = get_drive_status(snapshot);
         std::lock_guard lk(Controller_ns::ControllerClass::instance()->mutex);
         double motor_direction;
         Automation1_Parameter_GetAxisValue(Controller_ns::ControllerClass::instance()->controller, axisID,
                                            Automation1AxisParameterId_ReverseMotionDirection, &motor_direction);
-        auto [enabled, cw_end_of_travel_limit_input, ccw_end_of_travel_limit_input, emergency_stop_input, accelerating,
-            decelerating, move_active] = get_drive_status();
         if (static_cast<int>(motor_direction) == 0)
         {
-            *attr_positive_hard_limit_read = cw_end_of_travel_limit_input;
+            *attr_negative_hard_limit_read = cw_end_of_travel_limit_input;
         }
         else
         {
-            *attr_positive_hard_limit_read = ccw_end_of_travel_limit_input;
+            *attr_negative_hard_limit_read = ccw_end_of_travel_limit_input;
         }
 
-        att.set_value(attr_positive_hard_limit_read);
+        att.set_value_date_quality(attr_negative_hard_limit_read, to_timeval(snapshot.timestamp), Tango::ATTR_VALID);
     }
 
 
@@ -374,7 +968,7 @@ namespace Axis_ns
         }
         else
         {
-            return dev_state() == Tango::STANDBY;
+            return raw_state() == Tango::STANDBY;
         }
     }
 
@@ -467,20 +1061,491 @@ namespace Axis_ns
 
     bool Axis::is_freerun_allowed(const CORBA::Any& type)
     {
-        return dev_state() == Tango::STANDBY;
+        return raw_state() == Tango::STANDBY;
     }
 
     void Axis::freerun(Tango::DevDouble arg_in)
     {
         std::lock_guard lk(Controller_ns::ControllerClass::instance()->mutex);
-        if (const auto response = Automation1_Command_MoveFreerun(
+        TRACE_SCOPE(Controller_ns::trace_calls, "Automation1_Command_MoveFreerun", "axis", axisID);
+        const auto response = Automation1_Command_MoveFreerun(
             Controller_ns::ControllerClass::instance()->controller,
-            1, &axisID, 1, &arg_in, 1); !response)
+            1, &axisID, 1, &arg_in, 1);
+        record(Controller_ns::FlightCommand::MoveFreerun, {arg_in}, response);
+        if (!response)
         {
             char msg[100];
             Automation1_GetLastErrorMessage(msg, 100);
             ERROR_STREAM << msg << std::endl;
         }
+        Controller_ns::ControllerClass::instance()->sampler.invalidate(axisID);
+    }
+
+    void Axis::pso_configure(const Tango::DevVarDoubleArray* arg_in)
+    {
+        TRACE_SCOPE(Controller_ns::trace_calls, "Axis::pso_configure", "axis", axisID);
+        if (arg_in->length() < 5)
+            Tango::Except::throw_exception("InvalidArgument",
+                                           "Expected [mode, pulse_on_time, window_low, window_high, distance | "
+                                           "positions...]", "pso_configure()");
+
+        PsoConfig config;
+        config.mode = static_cast<PsoConfig::Mode>(static_cast<int>((*arg_in)[0]));
+        config.pulse_on_time = (*arg_in)[1];
+        config.window_low = (*arg_in)[2];
+        config.window_high = (*arg_in)[3];
+        if (config.mode == PsoConfig::Distance)
+        {
+            config.distance = (*arg_in)[4];
+            if (config.distance <= 0)
+                Tango::Except::throw_exception("InvalidArgument", "The PSO distance must be positive",
+                                               "pso_configure()");
+        }
+        else if (config.mode == PsoConfig::Array)
+        {
+            for (unsigned int i = 4; i < arg_in->length(); i++)
+                config.positions.push_back((*arg_in)[i]);
+            if (config.positions.size() > static_cast<std::size_t>(std::max<Tango::DevLong>(psoArraySize, 0)))
+                Tango::Except::throw_exception("InvalidArgument",
+                                               std::format("{} PSO positions exceed psoArraySize ({})",
+                                                           config.positions.size(), psoArraySize),
+                                               "pso_configure()");
+            check_array_regions("pso_configure()");
+        }
+        else
+            Tango::Except::throw_exception("InvalidArgument", "The PSO mode must be 0 (distance) or 1 (array)",
+                                           "pso_configure()");
+        if (config.pulse_on_time <= 0)
+            Tango::Except::throw_exception("InvalidArgument", "The pulse on time must be positive",
+                                           "pso_configure()");
+
+        const auto controller = Controller_ns::ControllerClass::instance()->controller;
+        std::lock_guard lk(Controller_ns::ControllerClass::instance()->mutex);
+        check_response(Automation1_Command_PsoReset(controller, 1, axisID), "pso_configure()");
+        check_response(Automation1_Command_PsoDistanceConfigureInputs(controller, 1, axisID, &psoInput, 1),
+                       "pso_configure()");
+        check_response(Automation1_Command_PsoWaveformConfigureMode(controller, 1, axisID,
+                                                                    Automation1PsoWaveformMode_Pulse),
+                       "pso_configure()");
+        check_response(Automation1_Command_PsoWaveformConfigurePulseFixedTotalTime(
+                           controller, 1, axisID, 2 * config.pulse_on_time), "pso_configure()");
+        check_response(Automation1_Command_PsoWaveformConfigurePulseFixedOnTime(
+                           controller, 1, axisID, config.pulse_on_time), "pso_configure()");
+        check_response(Automation1_Command_PsoWaveformConfigurePulseFixedCount(controller, 1, axisID, 1),
+                       "pso_configure()");
+        check_response(Automation1_Command_PsoWaveformApplyPulseConfiguration(controller, 1, axisID),
+                       "pso_configure()");
+        check_response(Automation1_Command_PsoWaveformOn(controller, 1, axisID), "pso_configure()");
+        check_response(Automation1_Command_PsoOutputConfigureOutput(controller, 1, axisID, psoOutput),
+                       "pso_configure()");
+        check_response(Automation1_Command_PsoOutputConfigureSource(controller, 1, axisID,
+                                                                    Automation1PsoOutputSource_Waveform),
+                       "pso_configure()");
+        pso = config;
+        *attr_pso_armed_read = false;
+    }
+
+    void Axis::pso_arm()
+    {
+        TRACE_SCOPE(Controller_ns::trace_calls, "Axis::pso_arm", "axis", axisID);
+        if (!pso)
+            Tango::Except::throw_exception("NotConfigured", "Call psoConfigure first", "pso_arm()");
+
+        // Window and array positions are given in absolute user units. The PSO counters start at zero when they are
+        // switched on, so everything is converted relative to the current position.
+        const auto position = get_snapshot().position_feedback;
+        const auto controller = Controller_ns::ControllerClass::instance()->controller;
+        std::lock_guard lk(Controller_ns::ControllerClass::instance()->mutex);
+        double countsPerUnit;
+        check_response(Automation1_Parameter_GetAxisValue(controller, axisID, Automation1AxisParameterId_CountsPerUnit,
+                                                          &countsPerUnit), "pso_arm()");
+
+        if (!std::isnan(pso->window_low) && !std::isnan(pso->window_high))
+        {
+            check_response(Automation1_Command_PsoWindowConfigureInput(controller, 1, axisID, 0, psoInput, false),
+                           "pso_arm()");
+            check_response(Automation1_Command_PsoWindowConfigureFixedRange(
+                               controller, 1, axisID, 0, (pso->window_low - position) * countsPerUnit,
+                               (pso->window_high - position) * countsPerUnit), "pso_arm()");
+            check_response(Automation1_Command_PsoEventConfigureMask(controller, 1, axisID,
+                                                                     Automation1PsoEventMask_WindowMask),
+                           "pso_arm()");
+            check_response(Automation1_Command_PsoWindowOn(controller, 1, axisID, 0), "pso_arm()");
+        }
+        else
+        {
+            check_response(Automation1_Command_PsoWindowOff(controller, 1, axisID, 0), "pso_arm()");
+            check_response(Automation1_Command_PsoEventConfigureMask(controller, 1, axisID, 0), "pso_arm()");
+        }
+
+        if (pso->mode == PsoConfig::Distance)
+        {
+            check_response(Automation1_Command_PsoDistanceConfigureFixedDistance(
+                               controller, 1, axisID, pso->distance * countsPerUnit), "pso_arm()");
+        }
+        else
+        {
+            std::vector<double> distances;
+            auto previous = position;
+            for (const auto target : pso->positions)
+            {
+                distances.push_back(std::abs(target - previous) * countsPerUnit);
+                previous = target;
+            }
+            check_response(Automation1_Command_DriveArrayWrite(controller, axisID, distances.data(), psoArrayAddress,
+                                                               static_cast<int>(distances.size())), "pso_arm()");
+            check_response(Automation1_Command_PsoDistanceConfigureArrayDistances(
+                               controller, 1, axisID, psoArrayAddress, static_cast<int>(distances.size()), false),
+                           "pso_arm()");
+        }
+        check_response(Automation1_Command_PsoDistanceCounterOn(controller, 1, axisID), "pso_arm()");
+        check_response(Automation1_Command_PsoDistanceEventsOn(controller, 1, axisID), "pso_arm()");
+        *attr_pso_armed_read = true;
+    }
+
+    void Axis::check_array_regions(const char* origin) const
+    {
+        if (psoArrayAddress < 0 || psoArraySize < 0)
+            Tango::Except::throw_exception("InvalidProperty", "psoArrayAddress and psoArraySize must not be negative",
+                                           origin);
+        if (psoArrayAddress < captureArrayAddress + captureArraySize &&
+            captureArrayAddress < psoArrayAddress + psoArraySize)
+            Tango::Except::throw_exception("InvalidProperty",
+                                           std::format("The PSO array [{}, {}) overlaps the capture array [{}, {})",
+                                                       psoArrayAddress, psoArrayAddress + psoArraySize,
+                                                       captureArrayAddress, captureArrayAddress + captureArraySize),
+                                           origin);
+    }
+
+    void Axis::pso_disarm()
+    {
+        TRACE_SCOPE(Controller_ns::trace_calls, "Axis::pso_disarm", "axis", axisID);
+        const auto controller = Controller_ns::ControllerClass::instance()->controller;
+        std::lock_guard lk(Controller_ns::ControllerClass::instance()->mutex);
+        check_response(Automation1_Command_PsoDistanceEventsOff(controller, 1, axisID), "pso_disarm()");
+        check_response(Automation1_Command_PsoDistanceCounterOff(controller, 1, axisID), "pso_disarm()");
+        check_response(Automation1_Command_PsoWindowOff(controller, 1, axisID, 0), "pso_disarm()");
+        *attr_pso_armed_read = false;
+    }
+
+    bool Axis::is_pso_allowed(const CORBA::Any& type)
+    {
+        return raw_state() != Tango::FAULT;
+    }
+
+    void Axis::read_pso_armed(Tango::Attribute& attribute)
+    {
+        attribute.set_value(attr_pso_armed_read);
+    }
+
+    void Axis::read_sampling_rate(Tango::Attribute& attribute)
+    {
+        *attr_sampling_rate_read = Controller_ns::ControllerClass::instance()->sampler.axis_rate(axisID);
+        attribute.set_value(attr_sampling_rate_read);
+    }
+
+    void Axis::trajectory_load(const Tango::DevVarDoubleArray* arg_in)
+    {
+        TRACE_SCOPE(Controller_ns::trace_calls, "Axis::trajectory_load", "axis", axisID);
+        if (arg_in->length() == 0 || arg_in->length() % 3 != 0)
+            Tango::Except::throw_exception("InvalidArgument",
+                                           "Expected [position, velocity, time, position, velocity, time, ...]",
+                                           "trajectory_load()");
+
+        std::vector<TrajectoryStreamer::Point> points;
+        points.reserve(arg_in->length() / 3);
+        for (unsigned int i = 0; i < arg_in->length(); i += 3)
+        {
+            if ((*arg_in)[i + 2] <= 0)
+                Tango::Except::throw_exception("InvalidArgument",
+                                               std::format("The time of point {} must be positive", i / 3),
+                                               "trajectory_load()");
+            points.push_back({(*arg_in)[i], (*arg_in)[i + 1], (*arg_in)[i + 2]});
+        }
+        trajectory->load(std::move(points));
+    }
+
+    void Axis::trajectory_start()
+    {
+        TRACE_SCOPE(Controller_ns::trace_calls, "Axis::trajectory_start", "axis", axisID);
+        try
+        {
+            trajectory->start(axisName, axisID, trajectoryTask, trajectoryQueueDepth);
+        }
+        catch (const Tango::DevFailed&)
+        {
+            record(Controller_ns::FlightCommand::TrajectoryStart, {}, false);
+            throw;
+        }
+        record(Controller_ns::FlightCommand::TrajectoryStart, {}, true);
+        Controller_ns::ControllerClass::instance()->sampler.invalidate(axisID);
+    }
+
+    void Axis::trajectory_abort()
+    {
+        TRACE_SCOPE(Controller_ns::trace_calls, "Axis::trajectory_abort", "axis", axisID);
+        trajectory->abort();
+        record(Controller_ns::FlightCommand::TrajectoryAbort, {}, true);
+        Controller_ns::ControllerClass::instance()->sampler.invalidate(axisID);
+    }
+
+    bool Axis::is_trajectory_allowed(const CORBA::Any& type)
+    {
+        return raw_state() == Tango::STANDBY;
+    }
+
+    void Axis::read_trajectory_progress(Tango::Attribute& attribute)
+    {
+        *attr_trajectory_progress_read = trajectory->progress();
+        attribute.set_value(attr_trajectory_progress_read);
+    }
+
+    void Axis::read_trajectory_underruns(Tango::Attribute& attribute)
+    {
+        *attr_trajectory_underruns_read = trajectory->underruns();
+        attribute.set_value(attr_trajectory_underruns_read);
+    }
+
+    void Axis::read_trajectory_status(Tango::Attribute& attribute)
+    {
+        trajectory_status = trajectory->status();
+        *attr_trajectory_status_read = trajectory_status.data();
+        attribute.set_value(attr_trajectory_status_read);
+    }
+
+    void Axis::step_scan_start(const Tango::DevVarDoubleArray* arg_in)
+    {
+        TRACE_SCOPE(Controller_ns::trace_calls, "Axis::step_scan_start", "axis", axisID);
+        if (arg_in->length() < 4)
+            Tango::Except::throw_exception("InvalidArgument",
+                                           "Expected [settle_time, trigger_output, trigger_time, position, ...]",
+                                           "step_scan_start()");
+        StepScanSettings settings;
+        settings.velocity = *attr_motion_velocity;
+        settings.settle_time = (*arg_in)[0];
+        settings.trigger_output = static_cast<int>((*arg_in)[1]);
+        settings.trigger_time = (*arg_in)[2];
+        for (unsigned int i = 3; i < arg_in->length(); i++)
+            settings.positions.push_back((*arg_in)[i]);
+
+        const auto points = static_cast<double>(settings.positions.size());
+        try
+        {
+            step_scan->start(axisID, std::move(settings), is_motion_finished,
+                             [name = axisName](const Controller_ns::AxisSnapshot& snapshot) -> std::string
+                             {
+                                 if (get_axis_faults(snapshot).anyFault)
+                                     return std::format("Axis {} faulted during motion", name);
+                                 if (!get_drive_status(snapshot).enabled)
+                                     return std::format("Axis {} got disabled during motion", name);
+                                 return {};
+                             });
+        }
+        catch (const Tango::DevFailed&)
+        {
+            record(Controller_ns::FlightCommand::StepScanStart, {points, *attr_motion_velocity}, false);
+            throw;
+        }
+        record(Controller_ns::FlightCommand::StepScanStart, {points, *attr_motion_velocity}, true);
+    }
+
+    void Axis::step_scan_abort()
+    {
+        TRACE_SCOPE(Controller_ns::trace_calls, "Axis::step_scan_abort", "axis", axisID);
+        step_scan->abort();
+        record(Controller_ns::FlightCommand::StepScanAbort, {}, true);
+        Controller_ns::ControllerClass::instance()->sampler.invalidate(axisID);
+    }
+
+    bool Axis::is_step_scan_start_allowed(const CORBA::Any& type)
+    {
+        return raw_state() == Tango::STANDBY;
+    }
+
+    void Axis::read_step_scan_progress(Tango::Attribute& attribute)
+    {
+        *attr_step_scan_progress_read = step_scan->progress();
+        attribute.set_value(attr_step_scan_progress_read);
+    }
+
+    void Axis::read_step_scan_status(Tango::Attribute& attribute)
+    {
+        step_scan_status = step_scan->status();
+        *attr_step_scan_status_read = step_scan_status.data();
+        attribute.set_value(attr_step_scan_status_read);
+    }
+
+    void Axis::read_step_scan_timestamps(Tango::Attribute& attribute)
+    {
+        step_scan_timestamps = step_scan->timestamps();
+        attribute.set_value(step_scan_timestamps.data(), static_cast<long>(step_scan_timestamps.size()));
+    }
+
+    void Axis::read_step_scan_positions(Tango::Attribute& attribute)
+    {
+        step_scan_positions = step_scan->positions();
+        attribute.set_value(step_scan_positions.data(), static_cast<long>(step_scan_positions.size()));
+    }
+
+    void Axis::capture_arm()
+    {
+        TRACE_SCOPE(Controller_ns::trace_calls, "Axis::capture_arm", "axis", axisID);
+        CaptureSettings settings;
+        settings.input = captureInput;
+        settings.trigger = captureTrigger;
+        settings.array_address = captureArrayAddress;
+        settings.array_size = captureArraySize;
+        settings.max_points = captureMaxPoints;
+        if (pso && pso->mode == PsoConfig::Array)
+            check_array_regions("capture_arm()");
+        capture->arm(axisID, settings);
+    }
+
+    void Axis::capture_disarm()
+    {
+        TRACE_SCOPE(Controller_ns::trace_calls, "Axis::capture_disarm", "axis", axisID);
+        capture->disarm();
+        if (const auto error = capture->error(); !error.empty())
+            Tango::Except::throw_exception("CaptureError", error, "capture_disarm()");
+    }
+
+    void Axis::read_captured_positions(Tango::Attribute& attribute)
+    {
+        auto& positions = capture->data().positions;
+        attribute.set_value(positions.data(), static_cast<long>(positions.size()), 0, false);
+    }
+
+    void Axis::read_captured_indices(Tango::Attribute& attribute)
+    {
+        auto& indices = capture->data().indices;
+        attribute.set_value(indices.data(), static_cast<long>(indices.size()), 0, false);
+    }
+
+    void Axis::read_capture_count(Tango::Attribute& attribute)
+    {
+        *attr_capture_count_read = capture->count();
+        attribute.set_value(attr_capture_count_read);
+    }
+
+    void Axis::read_capture_restarts(Tango::Attribute& attribute)
+    {
+        *attr_capture_restarts_read = capture->restarts();
+        attribute.set_value(attr_capture_restarts_read);
+    }
+
+    void Axis::read_capture_dropped(Tango::Attribute& attribute)
+    {
+        *attr_capture_dropped_read = capture->dropped();
+        attribute.set_value(attr_capture_dropped_read);
+    }
+
+    void Axis::read_capture_armed(Tango::Attribute& attribute)
+    {
+        *attr_capture_armed_read = capture->is_armed();
+        attribute.set_value(attr_capture_armed_read);
+    }
+
+    void Axis::read_position_history(Tango::Attribute& attribute)
+    {
+        attribute.set_value(position_history.data(), static_cast<long>(position_history.size()), 0, false);
+    }
+
+    void Axis::read_position_history_time(Tango::Attribute& attribute)
+    {
+        attribute.set_value(position_history_time.data(), static_cast<long>(position_history_time.size()), 0,
+                            false);
+    }
+
+    void Axis::read_position_history_window(Tango::Attribute& attribute)
+    {
+        attribute.set_value(attr_position_history_window);
+    }
+
+    void Axis::write_position_history_window(Tango::WAttribute& attribute)
+    {
+        Tango::DevDouble window;
+        attribute.get_write_value(window);
+        if (window <= 0)
+            Tango::Except::throw_exception("InvalidArgument", "The window must be positive",
+                                           "write_position_history_window()");
+        *attr_position_history_window = window;
+    }
+
+    void Axis::read_position_history_points(Tango::Attribute& attribute)
+    {
+        attribute.set_value(attr_position_history_points);
+    }
+
+    void Axis::write_position_history_points(Tango::WAttribute& attribute)
+    {
+        Tango::DevLong points;
+        attribute.get_write_value(points);
+        if (points < 2 || points > position_history_max_points)
+            Tango::Except::throw_exception("InvalidArgument",
+                                           std::format("The point count must be between 2 and {}",
+                                                       position_history_max_points),
+                                           "write_position_history_points()");
+        *attr_position_history_points = points;
+    }
+
+    void Axis::read_velocity_setpoint(Tango::Attribute& attribute)
+    {
+        *attr_velocity_setpoint_read = velocity_stream->velocity();
+        attribute.set_value(attr_velocity_setpoint_read);
+    }
+
+    void Axis::write_velocity_setpoint(Tango::WAttribute& attribute)
+    {
+        Tango::DevDouble velocity;
+        attribute.get_write_value(velocity);
+        if (!velocity_stream->is_running() && raw_state() != Tango::STANDBY)
+            Tango::Except::throw_exception("NotAllowed", "Velocity streaming needs an enabled axis at rest",
+                                           "write_velocity_setpoint()");
+        velocity_stream->set(axisID, velocity);
+        record(Controller_ns::FlightCommand::VelocitySetpoint, {velocity}, true);
+    }
+
+    void Axis::velocity_stream_stop()
+    {
+        TRACE_SCOPE(Controller_ns::trace_calls, "Axis::velocity_stream_stop", "axis", axisID);
+        velocity_stream->stop();
+        record(Controller_ns::FlightCommand::VelocityStreamStop, {}, true);
+    }
+
+    void Axis::read_velocity_stream_coalesced(Tango::Attribute& attribute)
+    {
+        *attr_velocity_stream_coalesced_read = velocity_stream->coalesced();
+        attribute.set_value(attr_velocity_stream_coalesced_read);
+    }
+
+    void Axis::read_velocity_stream_status(Tango::Attribute& attribute)
+    {
+        velocity_stream_status = velocity_stream->status();
+        *attr_velocity_stream_status_read = velocity_stream_status.data();
+        attribute.set_value(attr_velocity_stream_status_read);
+    }
+
+    void Axis::read_retarget_enabled(Tango::Attribute& attribute)
+    {
+        attribute.set_value(attr_retarget_enabled);
+    }
+
+    void Axis::write_retarget_enabled(Tango::WAttribute& attribute)
+    {
+        attribute.get_write_value(*attr_retarget_enabled);
+    }
+
+    void Axis::read_suppressed_state_changes(Tango::Attribute& attribute)
+    {
+        *attr_suppressed_state_changes_read = static_cast<Tango::DevLong64>(state_filter.suppressed());
+        attribute.set_value(attr_suppressed_state_changes_read);
+    }
+
+    void Axis::read_retarget_status(Tango::Attribute& attribute)
+    {
+        retarget_status = retarget->status();
+        *attr_retarget_status_read = retarget_status.data();
+        attribute.set_value(attr_retarget_status_read);
     }
 
     double Axis::counts_to_user_unit(const double counts) const
@@ -508,22 +1573,30 @@ namespace Axis_ns
 
     [[maybe_unused]] Tango::DevState Axis::dev_state()
     {
-        std::lock_guard lk(Controller_ns::ControllerClass::instance()->mutex);
+        return state_filter.filter(raw_state(), StateFilter::Clock::now());
+    }
+
+    Tango::DevState Axis::raw_state()
+    {
+        if (!init_error.empty())
+            return Tango::DevState::FAULT;
+        const auto snapshot = get_snapshot();
         auto [enabled, cw_end_of_travel_limit_input, ccw_end_of_travel_limit_input, emergency_stop_input, accelerating,
-            decelerating, move_active] = get_drive_status();
+            decelerating, move_active] = get_drive_status(snapshot);
         auto [homed, profiling, homing, jogging, not_virtual, motion_done, motion_clamped, gantry_aligned,
-            calibration_enabled_1d, calibration_enabled_2d] = get_axis_status();
+            calibration_enabled_1d, calibration_enabled_2d] = get_axis_status(snapshot);
         auto [anyFault, positionErrorFault, OverCurrentFault, CwEndOfTravelLimitFault, CcwEndOfTravelLimitFault,
             CwSoftwareLimitFault, CcwSoftwareLimitFault, AmplifierFault, FeedbackInput0Fault, FeedbackInput1Fault,
             HallSensorFault, MaxVelocityCommandFault, EmergencyStopFault, VelocityErrorFault, CommutationFault,
             ExternalFault, MotorTemperatureFault, AmplifierTemperatureFault, EncoderFault, GantryMisalignmentFault,
             FeedbackScalingFault, MarkerSearchFault, SafeZoneFault, InPositionTimeoutFault, VoltageClampFault,
-            MotorSupplyFault, InternalFault] = get_axis_faults();
+            MotorSupplyFault, InternalFault] = get_axis_faults(snapshot);
         if (anyFault)
             return Tango::DevState::FAULT;
         if (!enabled)
             return Tango::DevState::DISABLE;
-        if (homing)
+        if (homing || trajectory->is_running() || step_scan->is_running() || velocity_stream->is_running() ||
+            retarget->is_running())
             return Tango::DevState::MOVING;
         if (motion_done)
             return Tango::DevState::STANDBY;
@@ -532,11 +1605,13 @@ namespace Axis_ns
 
     const char* Axis::dev_status()
     {
-        std::lock_guard lk(Controller_ns::ControllerClass::instance()->mutex);
+        if (!init_error.empty())
+            return init_error.c_str();
+        const auto snapshot = get_snapshot();
         auto [enabled, cw_end_of_travel_limit_input, ccw_end_of_travel_limit_input, emergency_stop_input, accelerating,
-            decelerating, move_active] = get_drive_status();
+            decelerating, move_active] = get_drive_status(snapshot);
         auto [homed, profiling, homing, jogging, not_virtual, motion_done, motion_clamped, gantry_aligned,
-            calibration_enabled_1d, calibration_enabled_2d] = get_axis_status();
+            calibration_enabled_1d, calibration_enabled_2d] = get_axis_status(snapshot);
         status = std::format("enable: {}\ncw_end_of_travel_limit_input: {}\nccw_end_of_travel_limit_input: {}\n"
                              "emergency_stop_input: {}\naccelerating: {}\ndecelerating: {}\nhomed: {}\n"
                              "profiling: {}\nhoming: {}\njogging: {}\nnot_virtual: {}\nmotion_done: {}\n"
@@ -556,13 +1631,13 @@ namespace Axis_ns
 
     void Axis::read_faults(Tango::Attribute& att)
     {
-        std::lock_guard<std::mutex> lk(Controller_ns::ControllerClass::instance()->mutex);
+        const auto snapshot = get_snapshot();
         auto [anyFault, positionErrorFault, OverCurrentFault, CwEndOfTravelLimitFault, CcwEndOfTravelLimitFault,
             CwSoftwareLimitFault, CcwSoftwareLimitFault, AmplifierFault, FeedbackInput0Fault, FeedbackInput1Fault,
             HallSensorFault, MaxVelocityCommandFault, EmergencyStopFault, VelocityErrorFault, CommutationFault,
             ExternalFault, MotorTemperatureFault, AmplifierTemperatureFault, EncoderFault, GantryMisalignmentFault,
             FeedbackScalingFault, MarkerSearchFault, SafeZoneFault, InPositionTimeoutFault, VoltageClampFault,
-            MotorSupplyFault, InternalFault] = get_axis_faults();
+            MotorSupplyFault, InternalFault] = get_axis_faults(snapshot);
 
         std::string faults{};
         if (positionErrorFault) faults += "Position Error Fault\n";
@@ -593,16 +1668,16 @@ namespace Axis_ns
         if (InternalFault) faults += "Internal Fault\n";
 
         *attr_faults_read = Tango::string_dup(faults.c_str());
-        att.set_value(attr_faults_read);
+        att.set_value_date_quality(attr_faults_read, to_timeval(snapshot.timestamp), Tango::ATTR_VALID);
     }
 
     void Axis::read_accelerating(Tango::Attribute& att)
     {
-        std::lock_guard<std::mutex> lk(Controller_ns::ControllerClass::instance()->mutex);
+        const auto snapshot = get_snapshot();
         auto [enabled, cw_end_of_travel_limit_input, ccw_end_of_travel_limit_input, emergency_stop_input, accelerating,
-            decelerating, move_active] = get_drive_status();
+            decelerating, move_active] = get_drive_status(snapshot);
         *attr_accelerating_read = accelerating;
-        att.set_value(attr_accelerating_read);
+        att.set_value_date_quality(attr_accelerating_read, to_timeval(snapshot.timestamp), Tango::ATTR_VALID);
     }
 
     bool Axis::is_accelerating_allowed(Tango::AttReqType ty)
@@ -612,16 +1687,21 @@ namespace Axis_ns
 
     void Axis::fault_ack_all()
     {
+        TRACE_SCOPE(Controller_ns::trace_calls, "Axis::fault_ack_all");
         std::lock_guard lk(Controller_ns::ControllerClass::instance()->mutex);
-        DEBUG_STREAM << "Axis::fault_ack()  - " << device_name << std::endl;
-        if (const auto response = Automation1_Command_AcknowledgeAll(
+        TRACE_SCOPE(Controller_ns::trace_calls, "Automation1_Command_AcknowledgeAll");
+        const auto response = Automation1_Command_AcknowledgeAll(
             Controller_ns::ControllerClass::instance()->controller,
-            1); !response)
+            1);
+        Controller_ns::ControllerClass::instance()->recorder.command(Controller_ns::FlightCommand::FaultAckAll, -1, {},
+                                                                     response);
+        if (!response)
         {
             char msg[100];
             Automation1_GetLastErrorMessage(msg, 100);
             ERROR_STREAM << msg << std::endl;
         }
+        Controller_ns::ControllerClass::instance()->sampler.invalidate_all();
     }
 
     bool Axis::is_faultack_all_allowed(const CORBA::Any& any)
@@ -632,10 +1712,12 @@ namespace Axis_ns
     std::list<int> Axis::get_gantry_sub_axes()
     {
         double mask;
-        Automation1_Parameter_GetAxisValue(Controller_ns::ControllerClass::instance()->controller, axisID,
-                                           Automation1AxisParameterId_GantryAxisMask, &mask);
+        {
+            TRACE_SCOPE(Controller_ns::trace_calls, "Automation1_Parameter_GetAxisValue", "axis", axisID);
+            Automation1_Parameter_GetAxisValue(Controller_ns::ControllerClass::instance()->controller, axisID,
+                                               Automation1AxisParameterId_GantryAxisMask, &mask);
+        }
         const int axisMask = mask;
-        std::cout << axisName << '\t' << axisID << '\t' << axisMask << std::endl;
 
         std::list<int> axes;
         if (axisMask == 0)
@@ -651,19 +1733,17 @@ namespace Axis_ns
     }
 
 
-    AxisStatus Axis::get_axis_status() const
+    Controller_ns::AxisSnapshot Axis::get_snapshot() const
     {
-        double results[axisStates.size()];
         if (Controller_ns::ControllerClass::instance()->controller == nullptr)
             Tango::Except::throw_exception("Controller not connected", "The conctroller is not connected",
-                                           "get_axis_status()");
-        Automation1_Status_GetResults(Controller_ns::ControllerClass::instance()->controller,
-                                      statusConfig,
-                                      results,
-                                      static_cast<int>(axisStates.size()));
-
+                                           "get_snapshot()");
+        return Controller_ns::ControllerClass::instance()->sampler.axis(axisID);
+    }
 
-        const auto axis_status = static_cast<int>(results[axisStates.at(Automation1AxisStatusItem_AxisStatus)]);
+    AxisStatus Axis::get_axis_status(const Controller_ns::AxisSnapshot& snapshot)
+    {
+        const auto axis_status = static_cast<int>(snapshot.axis_status);
 
         return {
             .homed = static_cast<bool>(axis_status & Automation1AxisStatus::Automation1AxisStatus_Homed),
@@ -683,19 +1763,9 @@ namespace Axis_ns
         };;
     }
 
-    AxisFaults Axis::get_axis_faults() const
+    AxisFaults Axis::get_axis_faults(const Controller_ns::AxisSnapshot& snapshot)
     {
-        double results[axisStates.size()];
-        if (Controller_ns::ControllerClass::instance()->controller == nullptr)
-            Tango::Except::throw_exception("Controller not connected", "The conctroller is not connected",
-                                           "get_axis_status()");
-        Automation1_Status_GetResults(Controller_ns::ControllerClass::instance()->controller,
-                                      statusConfig,
-                                      results,
-                                      static_cast<int>(axisStates.size()));
-
-
-        const auto axis_faults = static_cast<int>(results[axisStates.at(Automation1AxisStatusItem_AxisFault)]);
+        const auto axis_faults = static_cast<int>(snapshot.axis_fault);
         return {
             .anyFault = static_cast<bool>(axis_faults),
             .positionErrorFault = static_cast<bool>(axis_faults &
@@ -749,18 +1819,9 @@ namespace Axis_ns
         };
     }
 
-    DriveStatus Axis::get_drive_status() const
+    DriveStatus Axis::get_drive_status(const Controller_ns::AxisSnapshot& snapshot)
     {
-        double results[axisStates.size()];
-        if (Controller_ns::ControllerClass::instance()->controller == nullptr)
-            Tango::Except::throw_exception("Controller not connected", "The conctroller is not connected",
-                                           "get_drive_status()");
-        Automation1_Status_GetResults(Controller_ns::ControllerClass::instance()->controller,
-                                      statusConfig,
-                                      results,
-                                      static_cast<int>(sizeof(results) / sizeof(double)));
-
-        const auto drive_status = static_cast<int>(results[axisStates.at(Automation1AxisStatusItem_DriveStatus)]);
+        const auto drive_status = static_cast<int>(snapshot.drive_status);
 
         return {
             .enabled = static_cast<bool>(drive_status & Automation1DriveStatus::Automation1DriveStatus_Enabled),
@@ -16,6 +16,8 @@
 */
 
 #include "AxisClass.h"
+#include "ControllerClass.h"
+#include "DeviceInit.h"
 
 extern "C" {
 Tango::DeviceClass* _create_Axis_class(const char* name)
@@ -122,6 +124,138 @@ namespace Axis_ns
         return new CORBA::Any();
     }
 
+    CORBA::Any* NotifyMotionDoneCommand::execute(Tango::DeviceImpl* dev, const CORBA::Any& any)
+    {
+        TANGO_LOG_DEBUG << "NotifyMotionDoneCommand::execute(): arrived" << std::endl;
+        Tango::DevDouble arg_in;
+        extract(any, arg_in);
+
+        dynamic_cast<Axis*>(dev)->notify_motion_done(arg_in);
+        return new CORBA::Any();
+    }
+
+    CORBA::Any* MoveAndNotifyCommand::execute(Tango::DeviceImpl* dev, const CORBA::Any& any)
+    {
+        TANGO_LOG_DEBUG << "MoveAndNotifyCommand::execute(): arrived" << std::endl;
+        const Tango::DevVarDoubleArray* arg_in;
+        extract(any, arg_in);
+
+        dynamic_cast<Axis*>(dev)->move_and_notify(arg_in);
+        return new CORBA::Any();
+    }
+
+    CORBA::Any* PsoConfigureCommand::execute(Tango::DeviceImpl* dev, const CORBA::Any& any)
+    {
+        TANGO_LOG_DEBUG << "PsoConfigureCommand::execute(): arrived" << std::endl;
+        const Tango::DevVarDoubleArray* arg_in;
+        extract(any, arg_in);
+
+        dynamic_cast<Axis*>(dev)->pso_configure(arg_in);
+        return new CORBA::Any();
+    }
+
+    CORBA::Any* PsoArmCommand::execute(Tango::DeviceImpl* dev, TANGO_UNUSED(const CORBA::Any &any))
+    {
+        TANGO_LOG_DEBUG << "PsoArmCommand::execute(): arrived" << std::endl;
+        ((dynamic_cast<Axis*>(dev))->pso_arm());
+        return new CORBA::Any();
+    }
+
+    CORBA::Any* PsoDisarmCommand::execute(Tango::DeviceImpl* dev, TANGO_UNUSED(const CORBA::Any &any))
+    {
+        TANGO_LOG_DEBUG << "PsoDisarmCommand::execute(): arrived" << std::endl;
+        ((dynamic_cast<Axis*>(dev))->pso_disarm());
+        return new CORBA::Any();
+    }
+
+    CORBA::Any* TrajectoryLoadCommand::execute(Tango::DeviceImpl* dev, const CORBA::Any& any)
+    {
+        TANGO_LOG_DEBUG << "TrajectoryLoadCommand::execute(): arrived" << std::endl;
+        const Tango::DevVarDoubleArray* arg_in;
+        extract(any, arg_in);
+
+        dynamic_cast<Axis*>(dev)->trajectory_load(arg_in);
+        return new CORBA::Any();
+    }
+
+    CORBA::Any* TrajectoryStartCommand::execute(Tango::DeviceImpl* dev, TANGO_UNUSED(const CORBA::Any &any))
+    {
+        TANGO_LOG_DEBUG << "TrajectoryStartCommand::execute(): arrived" << std::endl;
+        ((dynamic_cast<Axis*>(dev))->trajectory_start());
+        return new CORBA::Any();
+    }
+
+    CORBA::Any* TrajectoryAbortCommand::execute(Tango::DeviceImpl* dev, TANGO_UNUSED(const CORBA::Any &any))
+    {
+        TANGO_LOG_DEBUG << "TrajectoryAbortCommand::execute(): arrived" << std::endl;
+        ((dynamic_cast<Axis*>(dev))->trajectory_abort());
+        return new CORBA::Any();
+    }
+
+    CORBA::Any* StepScanStartCommand::execute(Tango::DeviceImpl* dev, const CORBA::Any& any)
+    {
+        TANGO_LOG_DEBUG << "StepScanStartCommand::execute(): arrived" << std::endl;
+        const Tango::DevVarDoubleArray* arg_in;
+        extract(any, arg_in);
+
+        dynamic_cast<Axis*>(dev)->step_scan_start(arg_in);
+        return new CORBA::Any();
+    }
+
+    CORBA::Any* StepScanAbortCommand::execute(Tango::DeviceImpl* dev, TANGO_UNUSED(const CORBA::Any &any))
+    {
+        TANGO_LOG_DEBUG << "StepScanAbortCommand::execute(): arrived" << std::endl;
+        ((dynamic_cast<Axis*>(dev))->step_scan_abort());
+        return new CORBA::Any();
+    }
+
+    CORBA::Any* CaptureArmCommand::execute(Tango::DeviceImpl* dev, TANGO_UNUSED(const CORBA::Any &any))
+    {
+        TANGO_LOG_DEBUG << "CaptureArmCommand::execute(): arrived" << std::endl;
+        ((dynamic_cast<Axis*>(dev))->capture_arm());
+        return new CORBA::Any();
+    }
+
+    CORBA::Any* CaptureDisarmCommand::execute(Tango::DeviceImpl* dev, TANGO_UNUSED(const CORBA::Any &any))
+    {
+        TANGO_LOG_DEBUG << "CaptureDisarmCommand::execute(): arrived" << std::endl;
+        ((dynamic_cast<Axis*>(dev))->capture_disarm());
+        return new CORBA::Any();
+    }
+
+    CORBA::Any* VelocityStreamStopCommand::execute(Tango::DeviceImpl* dev, TANGO_UNUSED(const CORBA::Any &any))
+    {
+        TANGO_LOG_DEBUG << "VelocityStreamStopCommand::execute(): arrived" << std::endl;
+        ((dynamic_cast<Axis*>(dev))->velocity_stream_stop());
+        return new CORBA::Any();
+    }
+
+    CORBA::Any* WatchAddCommand::execute(Tango::DeviceImpl* dev, const CORBA::Any& any)
+    {
+        TANGO_LOG_DEBUG << "WatchAddCommand::execute(): arrived" << std::endl;
+        const Tango::DevVarStringArray* arg_in;
+        extract(any, arg_in);
+
+        dynamic_cast<Axis*>(dev)->watch_add(arg_in);
+        return new CORBA::Any();
+    }
+
+    CORBA::Any* WatchRemoveCommand::execute(Tango::DeviceImpl* dev, const CORBA::Any& any)
+    {
+        TANGO_LOG_DEBUG << "WatchRemoveCommand::execute(): arrived" << std::endl;
+        Tango::DevString arg_in;
+        extract(any, arg_in);
+
+        dynamic_cast<Axis*>(dev)->watch_remove(arg_in);
+        return new CORBA::Any();
+    }
+
+    CORBA::Any* WatchListCommand::execute(Tango::DeviceImpl* dev, TANGO_UNUSED(const CORBA::Any &any))
+    {
+        TANGO_LOG_DEBUG << "WatchListCommand::execute(): arrived" << std::endl;
+        return insert(dynamic_cast<Axis*>(dev)->watch_list());
+    }
+
     Tango::DbDatum AxisClass::get_class_property(std::string& prop_name)
     {
         for (auto& i : cl_prop)
@@ -191,21 +325,39 @@ namespace Axis_ns
 
     void AxisClass::device_factory(const Tango::DevVarStringArray* devlist_ptr)
     {
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<Axis*> devices;
+        deferred_init = true;
         for (unsigned long i = 0; i < devlist_ptr->length(); i++)
         {
             TANGO_LOG_DEBUG << "Device name : " << (*devlist_ptr)[i].in() << std::endl;
-            device_list.push_back(new Axis(this, (*devlist_ptr)[i]));
+            devices.push_back(new Axis(this, (*devlist_ptr)[i]));
+            device_list.push_back(devices.back());
         }
+        deferred_init = false;
+
+        const auto errors = Controller_ns::init_devices(devices.size(), [&](const std::size_t i)
+        {
+            devices[i]->init_hardware();
+        });
+        for (std::size_t i = 0; i < devices.size(); i++)
+            if (!errors[i].empty())
+                devices[i]->set_init_error(errors[i]);
+
         erase_dynamic_attributes(devlist_ptr, get_class_attr()->get_attr_list());
         for (unsigned long i = 1; i <= devlist_ptr->length(); i++)
         {
             const auto dev = dynamic_cast<Axis*>(device_list[device_list.size() - i]);
-            Axis::add_dynamic_attributes();
+            dev->add_dynamic_attributes();
             if (Tango::Util::_UseDb && !Tango::Util::_FileDb)
                 export_device(dev);
             else
                 export_device(dev, dev->get_name().c_str());
         }
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        Controller_ns::ControllerClass::instance()->startup_time += elapsed.count();
+        TANGO_LOG_INFO << devices.size() << " Axis devices initialised in " << elapsed.count() << " s" << std::endl;
     }
 
     void AxisClass::attribute_factory(std::vector<Tango::Attr*>& att_list)
@@ -264,6 +416,182 @@ namespace Axis_ns
         motion_velocity->set_disp_level(Tango::OPERATOR);
         att_list.push_back(motion_velocity);
 
+        auto* sampling_rate = new samplingRateAttrib();
+        Tango::UserDefaultAttrProp sampling_rate_prop;
+        sampling_rate_prop.set_unit("Hz");
+        sampling_rate_prop.set_description("Effective status sampling rate of the axis.");
+        sampling_rate->set_default_properties(sampling_rate_prop);
+        sampling_rate->set_disp_level(Tango::EXPERT);
+        att_list.push_back(sampling_rate);
+
+        auto* pso_armed = new psoArmedAttrib();
+        Tango::UserDefaultAttrProp pso_armed_prop;
+        pso_armed->set_default_properties(pso_armed_prop);
+        pso_armed->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(pso_armed);
+
+        auto* trajectory_progress = new trajectoryProgressAttrib();
+        Tango::UserDefaultAttrProp trajectory_progress_prop;
+        trajectory_progress->set_default_properties(trajectory_progress_prop);
+        trajectory_progress->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(trajectory_progress);
+
+        auto* trajectory_underruns = new trajectoryUnderrunsAttrib();
+        Tango::UserDefaultAttrProp trajectory_underruns_prop;
+        trajectory_underruns->set_default_properties(trajectory_underruns_prop);
+        trajectory_underruns->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(trajectory_underruns);
+
+        auto* trajectory_status = new trajectoryStatusAttrib();
+        Tango::UserDefaultAttrProp trajectory_status_prop;
+        trajectory_status->set_default_properties(trajectory_status_prop);
+        trajectory_status->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(trajectory_status);
+
+        auto* step_scan_progress = new stepScanProgressAttrib();
+        Tango::UserDefaultAttrProp step_scan_progress_prop;
+        step_scan_progress->set_default_properties(step_scan_progress_prop);
+        step_scan_progress->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(step_scan_progress);
+
+        auto* step_scan_status = new stepScanStatusAttrib();
+        Tango::UserDefaultAttrProp step_scan_status_prop;
+        step_scan_status->set_default_properties(step_scan_status_prop);
+        step_scan_status->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(step_scan_status);
+
+        auto* step_scan_timestamps = new stepScanTimestampsAttrib();
+        Tango::UserDefaultAttrProp step_scan_timestamps_prop;
+        step_scan_timestamps->set_default_properties(step_scan_timestamps_prop);
+        step_scan_timestamps->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(step_scan_timestamps);
+
+        auto* step_scan_positions = new stepScanPositionsAttrib();
+        Tango::UserDefaultAttrProp step_scan_positions_prop;
+        step_scan_positions->set_default_properties(step_scan_positions_prop);
+        step_scan_positions->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(step_scan_positions);
+
+        auto* captured_positions = new capturedPositionsAttrib();
+        Tango::UserDefaultAttrProp captured_positions_prop;
+        captured_positions->set_default_properties(captured_positions_prop);
+        captured_positions->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(captured_positions);
+
+        auto* captured_indices = new capturedIndicesAttrib();
+        Tango::UserDefaultAttrProp captured_indices_prop;
+        captured_indices->set_default_properties(captured_indices_prop);
+        captured_indices->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(captured_indices);
+
+        auto* capture_count = new captureCountAttrib();
+        Tango::UserDefaultAttrProp capture_count_prop;
+        capture_count->set_default_properties(capture_count_prop);
+        capture_count->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(capture_count);
+
+        auto* capture_restarts = new captureRestartsAttrib();
+        Tango::UserDefaultAttrProp capture_restarts_prop;
+        capture_restarts->set_default_properties(capture_restarts_prop);
+        capture_restarts->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(capture_restarts);
+
+        auto* capture_dropped = new captureDroppedAttrib();
+        Tango::UserDefaultAttrProp capture_dropped_prop;
+        capture_dropped->set_default_properties(capture_dropped_prop);
+        capture_dropped->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(capture_dropped);
+
+        auto* capture_armed = new captureArmedAttrib();
+        Tango::UserDefaultAttrProp capture_armed_prop;
+        capture_armed->set_default_properties(capture_armed_prop);
+        capture_armed->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(capture_armed);
+
+        auto* position_history = new positionHistoryAttrib();
+        Tango::UserDefaultAttrProp position_history_prop;
+        position_history->set_default_properties(position_history_prop);
+        position_history->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(position_history);
+
+        auto* position_history_time = new positionHistoryTimeAttrib();
+        Tango::UserDefaultAttrProp position_history_time_prop;
+        position_history_time_prop.set_unit("s");
+        position_history_time->set_default_properties(position_history_time_prop);
+        position_history_time->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(position_history_time);
+
+        auto* position_history_window = new positionHistoryWindowAttrib();
+        Tango::UserDefaultAttrProp position_history_window_prop;
+        position_history_window_prop.set_unit("s");
+        position_history_window->set_default_properties(position_history_window_prop);
+        position_history_window->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(position_history_window);
+
+        auto* position_history_points = new positionHistoryPointsAttrib();
+        Tango::UserDefaultAttrProp position_history_points_prop;
+        position_history_points->set_default_properties(position_history_points_prop);
+        position_history_points->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(position_history_points);
+
+        auto* velocity_setpoint = new velocitySetpointAttrib();
+        Tango::UserDefaultAttrProp velocity_setpoint_prop;
+        velocity_setpoint->set_default_properties(velocity_setpoint_prop);
+        velocity_setpoint->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(velocity_setpoint);
+
+        auto* velocity_stream_coalesced = new velocityStreamCoalescedAttrib();
+        Tango::UserDefaultAttrProp velocity_stream_coalesced_prop;
+        velocity_stream_coalesced->set_default_properties(velocity_stream_coalesced_prop);
+        velocity_stream_coalesced->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(velocity_stream_coalesced);
+
+        auto* velocity_stream_status = new velocityStreamStatusAttrib();
+        Tango::UserDefaultAttrProp velocity_stream_status_prop;
+        velocity_stream_status->set_default_properties(velocity_stream_status_prop);
+        velocity_stream_status->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(velocity_stream_status);
+
+        auto* retarget_enabled = new retargetEnabledAttrib();
+        Tango::UserDefaultAttrProp retarget_enabled_prop;
+        retarget_enabled->set_default_properties(retarget_enabled_prop);
+        retarget_enabled->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(retarget_enabled);
+
+        auto* retarget_status = new retargetStatusAttrib();
+        Tango::UserDefaultAttrProp retarget_status_prop;
+        retarget_status->set_default_properties(retarget_status_prop);
+        retarget_status->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(retarget_status);
+
+        auto* suppressed_state_changes = new suppressedStateChangesAttrib();
+        Tango::UserDefaultAttrProp suppressed_state_changes_prop;
+        suppressed_state_changes_prop.set_description("State changes of the status bits that were not reported, "
+                                                      "see stateDebounce and stateMinDwell.");
+        suppressed_state_changes->set_default_properties(suppressed_state_changes_prop);
+        suppressed_state_changes->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(suppressed_state_changes);
+
+        // add motion_done attribute
+        auto* motion_done = new motionDoneAttrib();
+        Tango::UserDefaultAttrProp motion_done_prop;
+        motion_done_prop.set_description("False from notifyMotionDone or moveAndNotify until the motion is done. "
+                                         "Pushes change events.");
+        motion_done->set_default_properties(motion_done_prop);
+        motion_done->set_disp_level(Tango::OPERATOR);
+        motion_done->set_change_event(true, false);
+        att_list.push_back(motion_done);
+
+        // add motion_result attribute
+        auto* motion_result = new motionResultAttrib();
+        Tango::UserDefaultAttrProp motion_result_prop;
+        motion_result_prop.set_description("DONE, FAULT, DISABLED or TIMEOUT once motion_done is set again, empty "
+                                           "while waiting. Pushes change events.");
+        motion_result->set_default_properties(motion_result_prop);
+        motion_result->set_disp_level(Tango::OPERATOR);
+        motion_result->set_change_event(true, false);
+        att_list.push_back(motion_result);
+
         create_static_attribute_list(get_class_attr()->get_attr_list());
     }
 
@@ -329,6 +657,134 @@ namespace Axis_ns
                                "",
                                Tango::OPERATOR);
         command_list.push_back(pDisableCmd);
+
+        auto* pNotifyMotionDoneCmd =
+            new NotifyMotionDoneCommand("notifyMotionDone",
+                                        Tango::DEV_DOUBLE, Tango::DEV_VOID,
+                                        "Timeout in seconds",
+                                        "",
+                                        Tango::OPERATOR);
+        command_list.push_back(pNotifyMotionDoneCmd);
+
+        auto* pMoveAndNotifyCmd =
+            new MoveAndNotifyCommand("moveAndNotify",
+                                     Tango::DEVVAR_DOUBLEARRAY, Tango::DEV_VOID,
+                                     "[position, timeout in seconds]",
+                                     "",
+                                     Tango::OPERATOR);
+        command_list.push_back(pMoveAndNotifyCmd);
+
+        auto* pPsoConfigureCmd =
+            new PsoConfigureCommand("psoConfigure",
+                                    Tango::DEVVAR_DOUBLEARRAY, Tango::DEV_VOID,
+                                    "[mode, pulse_on_time, window_low, window_high, distance | positions...]",
+                                    "",
+                                    Tango::OPERATOR);
+        command_list.push_back(pPsoConfigureCmd);
+
+        auto* pPsoArmCmd =
+            new PsoArmCommand("psoArm",
+                              Tango::DEV_VOID, Tango::DEV_VOID,
+                              "",
+                              "",
+                              Tango::OPERATOR);
+        command_list.push_back(pPsoArmCmd);
+
+        auto* pPsoDisarmCmd =
+            new PsoDisarmCommand("psoDisarm",
+                                 Tango::DEV_VOID, Tango::DEV_VOID,
+                                 "",
+                                 "",
+                                 Tango::OPERATOR);
+        command_list.push_back(pPsoDisarmCmd);
+
+        auto* pTrajectoryLoadCmd =
+            new TrajectoryLoadCommand("trajectoryLoad",
+                                      Tango::DEVVAR_DOUBLEARRAY, Tango::DEV_VOID,
+                                      "[position, velocity, time, position, velocity, time, ...]",
+                                      "",
+                                      Tango::OPERATOR);
+        command_list.push_back(pTrajectoryLoadCmd);
+
+        auto* pTrajectoryStartCmd =
+            new TrajectoryStartCommand("trajectoryStart",
+                                       Tango::DEV_VOID, Tango::DEV_VOID,
+                                       "",
+                                       "",
+                                       Tango::OPERATOR);
+        command_list.push_back(pTrajectoryStartCmd);
+
+        auto* pTrajectoryAbortCmd =
+            new TrajectoryAbortCommand("trajectoryAbort",
+                                       Tango::DEV_VOID, Tango::DEV_VOID,
+                                       "",
+                                       "",
+                                       Tango::OPERATOR);
+        command_list.push_back(pTrajectoryAbortCmd);
+
+        auto* pStepScanStartCmd =
+            new StepScanStartCommand("stepScanStart",
+                                     Tango::DEVVAR_DOUBLEARRAY, Tango::DEV_VOID,
+                                     "[settle_time, trigger_output, trigger_time, position, position, ...]",
+                                     "",
+                                     Tango::OPERATOR);
+        command_list.push_back(pStepScanStartCmd);
+
+        auto* pStepScanAbortCmd =
+            new StepScanAbortCommand("stepScanAbort",
+                                     Tango::DEV_VOID, Tango::DEV_VOID,
+                                     "",
+                                     "",
+                                     Tango::OPERATOR);
+        command_list.push_back(pStepScanAbortCmd);
+
+        auto* pCaptureArmCmd =
+            new CaptureArmCommand("captureArm",
+                                  Tango::DEV_VOID, Tango::DEV_VOID,
+                                  "",
+                                  "",
+                                  Tango::OPERATOR);
+        command_list.push_back(pCaptureArmCmd);
+
+        auto* pCaptureDisarmCmd =
+            new CaptureDisarmCommand("captureDisarm",
+                                     Tango::DEV_VOID, Tango::DEV_VOID,
+                                     "",
+                                     "",
+                                     Tango::OPERATOR);
+        command_list.push_back(pCaptureDisarmCmd);
+
+        auto* pVelocityStreamStopCmd =
+            new VelocityStreamStopCommand("velocityStreamStop",
+                                          Tango::DEV_VOID, Tango::DEV_VOID,
+                                          "",
+                                          "",
+                                          Tango::OPERATOR);
+        command_list.push_back(pVelocityStreamStopCmd);
+
+        auto* pWatchAddCmd =
+            new WatchAddCommand("watchAdd",
+                                Tango::DEVVAR_STRINGARRAY, Tango::DEV_VOID,
+                                "[name, expression], e.g. [past_limit, position > 12.5]",
+                                "",
+                                Tango::OPERATOR);
+        command_list.push_back(pWatchAddCmd);
+
+        auto* pWatchRemoveCmd =
+            new WatchRemoveCommand("watchRemove",
+                                   Tango::DEV_STRING, Tango::DEV_VOID,
+                                   "Watch name",
+                                   "",
+                                   Tango::OPERATOR);
+        command_list.push_back(pWatchRemoveCmd);
+
+        auto* pWatchListCmd =
+            new WatchListCommand("watchList",
+                                 Tango::DEV_VOID, Tango::DEVVAR_STRINGARRAY,
+                                 "",
+                                 "name: expression per watch",
+                                 Tango::OPERATOR);
+        command_list.push_back(pWatchListCmd);
     }
 
     void AxisClass::create_static_attribute_list(std::vector<Tango::Attr*>& att_list)
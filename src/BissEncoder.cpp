@@ -19,6 +19,8 @@
 #include "BissEncoderClass.h"
 #include "ControllerClass.h"
 #include <Automation1.h>
+#include <algorithm>
+#include <cmath>
 #include <complex>
 #include <stdexcept>
 
@@ -42,6 +44,9 @@ namespace BissEncoder_ns {
 
     void BissEncoder::delete_device() {
         DEBUG_STREAM << "BissEncoder::delete_device() " << device_name << std::endl;
+        if (sampled)
+            Controller_ns::ControllerClass::instance()->sampler.remove_encoder(axisID);
+        sampled = false;
 
         delete attr_position_read;
 
@@ -51,22 +56,56 @@ namespace BissEncoder_ns {
         DEBUG_STREAM << "BissEncoder::init_device() create device " << device_name << std::endl;
         get_device_property();
 
-        Automation1_Controller_GetAxisIndexFromAxisName(Controller_ns::ControllerClass::instance()->controller,
-                                                        axisName.c_str(), &axisID);
-
-
+        attr_position_read = new Tango::DevDouble();
 
+        if (!dynamic_cast<BissEncoderClass *>(get_device_class())->deferred_init)
+            init_hardware();
+    }
 
-        attr_position_read = new Tango::DevDouble();
+    void BissEncoder::init_hardware() {
+        init_error.clear();
+        if (Controller_ns::ControllerClass::instance()->controller == nullptr)
+            Tango::Except::throw_exception("Controller not connected", "The controller is not connected",
+                                           "init_hardware()");
+
+        {
+            std::lock_guard lk(Controller_ns::ControllerClass::instance()->mutex);
+            if (!Automation1_Controller_GetAxisIndexFromAxisName(
+                    Controller_ns::ControllerClass::instance()->controller, axisName.c_str(), &axisID)) {
+                char msg[100];
+                Automation1_GetLastErrorMessage(msg, 100);
+                Tango::Except::throw_exception("AxisNotFound", std::format("Axis {}: {}", axisName, msg),
+                                               "init_hardware()");
+            }
+            if (!Automation1_Parameter_GetAxisValue(Controller_ns::ControllerClass::instance()->controller, axisID,
+                                                    Automation1AxisParameterId_CountsPerUnit, &countsPerUnit)) {
+                char msg[100];
+                Automation1_GetLastErrorMessage(msg, 100);
+                Tango::Except::throw_exception("ParameterError", std::format("Axis {}: {}", axisName, msg),
+                                               "init_hardware()");
+            }
+        }
+        Controller_ns::ControllerClass::instance()->sampler.add_encoder(
+                axisID, sampling_rate, static_cast<std::size_t>(std::max<Tango::DevLong>(filter_window, 1)),
+                std::max(ema_time_constant, 0.));
+        sampled = true;
 
         DEBUG_STREAM << "axis " << axisName << " with id " << axisID << " found." << std::endl;
     }
 
+    void BissEncoder::set_init_error(const std::string &error) {
+        init_error = error;
+        ERROR_STREAM << "BissEncoder::init_hardware() " << device_name << ": " << error << std::endl;
+    }
+
     void BissEncoder::get_device_property() {
         Tango::DbData dev_prop;
         dev_prop.emplace_back("axisName");
         dev_prop.emplace_back("scale");
         dev_prop.emplace_back("offset");
+        dev_prop.emplace_back("sampling_rate");
+        dev_prop.emplace_back("filter_window");
+        dev_prop.emplace_back("ema_time_constant");
 
 
         if (!dev_prop.empty()) {
@@ -103,6 +142,33 @@ namespace BissEncoder_ns {
                     def_prop >> offset;
             }
             if (!dev_prop[i].is_empty()) dev_prop[i] >> offset;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty())
+                cl_prop >> sampling_rate;
+            else {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty())
+                    def_prop >> sampling_rate;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> sampling_rate;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty())
+                cl_prop >> filter_window;
+            else {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty())
+                    def_prop >> filter_window;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> filter_window;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty())
+                cl_prop >> ema_time_constant;
+            else {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty())
+                    def_prop >> ema_time_constant;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> ema_time_constant;
         }
     }
 
@@ -112,8 +178,48 @@ namespace BissEncoder_ns {
     }
 
 
-    void BissEncoder::read_attr_hardware(TANGO_UNUSED(std::vector<long> &attr_list)) {
+    void BissEncoder::read_attr_hardware(std::vector<long> &attr_list) {
+        for (const auto index: attr_list) {
+            if (const auto &name = get_device_attr()->get_attr_by_ind(index).get_name(); name != "position") {
+                update_statistics();
+                break;
+            }
+        }
+    }
 
+    void BissEncoder::update_statistics() {
+        Controller_ns::ControllerClass::instance()->sampler.encoder_window(axisID, samples);
+        if (samples.empty())
+            Tango::Except::throw_exception("StatusError", "No encoder samples yet", "update_statistics()");
+
+        values.clear();
+        for (const auto &sample: samples)
+            values.push_back(counts_to_user_unit(sample.counts) * scale - offset);
+        const auto n = static_cast<double>(values.size());
+
+        double sum = 0;
+        for (const auto value: values)
+            sum += value;
+        statistics.mean = sum / n;
+        double squares = 0;
+        for (const auto value: values)
+            squares += (value - statistics.mean) * (value - statistics.mean);
+        statistics.std = values.size() > 1 ? std::sqrt(squares / (n - 1)) : 0.;
+
+        // The exponential moving average runs in the sampler over all samples, independent of the window.
+        statistics.ema = counts_to_user_unit(
+                Controller_ns::ControllerClass::instance()->sampler.encoder_ema(axisID)) * scale - offset;
+
+        const auto [min, max] = std::ranges::minmax(values);
+        statistics.min = min;
+        statistics.max = max;
+        statistics.count = static_cast<Tango::DevLong>(values.size());
+
+        const auto middle = values.begin() + static_cast<std::ptrdiff_t>(values.size() / 2);
+        std::ranges::nth_element(values, middle);
+        statistics.median = *middle;
+        if (values.size() % 2 == 0)
+            statistics.median = (statistics.median + *std::max_element(values.begin(), middle)) / 2;
     }
 
 
@@ -129,14 +235,44 @@ namespace BissEncoder_ns {
             Tango::Except::throw_exception("Controller not connected", "The controller is not connected",
                                            "read_position()");
 
-        double encoder_position = 0;
-        DEBUG_STREAM << "scale: " << scale << std::endl;
-        Automation1_Command_DriveGetItem(Controller_ns::ControllerClass::instance()->controller, 1, axisID, Automation1DriveItem_PrimaryBissAbsolutePosition, 0, &encoder_position);
-        DEBUG_STREAM << "encoder value: " <<  static_cast<int>(encoder_position) << std::endl;
-        *attr_position_read = counts_to_user_unit(encoder_position) * scale - offset;
-        attribute.set_value(attr_position_read);
+        const auto snapshot = Controller_ns::ControllerClass::instance()->sampler.encoder(axisID);
+        *attr_position_read = counts_to_user_unit(snapshot.counts) * scale - offset;
+        const auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+                snapshot.timestamp.time_since_epoch()).count();
+        Tango::TimeVal tv{};
+        tv.tv_sec = static_cast<decltype(tv.tv_sec)>(us / 1000000);
+        tv.tv_usec = static_cast<decltype(tv.tv_usec)>(us % 1000000);
+        attribute.set_value_date_quality(attr_position_read, tv, Tango::ATTR_VALID);
+    }
+
+
+    void BissEncoder::read_position_mean(Tango::Attribute &attribute) {
+        attribute.set_value(&statistics.mean);
     }
 
+    void BissEncoder::read_position_median(Tango::Attribute &attribute) {
+        attribute.set_value(&statistics.median);
+    }
+
+    void BissEncoder::read_position_min(Tango::Attribute &attribute) {
+        attribute.set_value(&statistics.min);
+    }
+
+    void BissEncoder::read_position_max(Tango::Attribute &attribute) {
+        attribute.set_value(&statistics.max);
+    }
+
+    void BissEncoder::read_position_std(Tango::Attribute &attribute) {
+        attribute.set_value(&statistics.std);
+    }
+
+    void BissEncoder::read_position_ema(Tango::Attribute &attribute) {
+        attribute.set_value(&statistics.ema);
+    }
+
+    void BissEncoder::read_sample_count(Tango::Attribute &attribute) {
+        attribute.set_value(&statistics.count);
+    }
 
     bool BissEncoder::is_position_allowed(const Tango::AttReqType type) {
         if (type == Tango::READ_REQ) {
@@ -149,29 +285,22 @@ namespace BissEncoder_ns {
 
 
     double BissEncoder::counts_to_user_unit(const double counts) const {
-        double countsPerUnitParam;
-
-        Automation1_Parameter_GetAxisValue(Controller_ns::ControllerClass::instance()->controller,
-                                           axisID,
-                                           Automation1AxisParameterId_CountsPerUnit,
-                                           &countsPerUnitParam);
-        return counts / countsPerUnitParam;
+        return counts / countsPerUnit;
     }
 
     double BissEncoder::user_unit_to_counts(const double user_unit) const {
-        double countsPerUnitParam;
-        Automation1_Parameter_GetAxisValue(Controller_ns::ControllerClass::instance()->controller,
-                                           axisID,
-                                           Automation1AxisParameterId_CountsPerUnit,
-                                           &countsPerUnitParam);
-        return user_unit * countsPerUnitParam;
+        return user_unit * countsPerUnit;
     }
 
     [[maybe_unused]] Tango::DevState BissEncoder::dev_state() {
+        if (!init_error.empty())
+            return Tango::DevState::FAULT;
         return Tango::DevState::STANDBY;
     }
 
     const char *BissEncoder::dev_status() {
+        if (!init_error.empty())
+            return init_error.c_str();
         return {"standby"};
     }
 
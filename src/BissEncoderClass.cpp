@@ -16,6 +16,8 @@
 */
 
 #include "BissEncoderClass.h"
+#include "ControllerClass.h"
+#include "DeviceInit.h"
 
 extern "C" {
 Tango::DeviceClass* _create_BissEncoder_class(const char* name)
@@ -139,11 +141,25 @@ namespace BissEncoder_ns
 
     void BissEncoderClass::device_factory(const Tango::DevVarStringArray* devlist_ptr)
     {
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<BissEncoder*> devices;
+        deferred_init = true;
         for (unsigned long i = 0; i < devlist_ptr->length(); i++)
         {
             TANGO_LOG_DEBUG << "Device name : " << (*devlist_ptr)[i].in() << std::endl;
-            device_list.push_back(new BissEncoder(this, (*devlist_ptr)[i]));
+            devices.push_back(new BissEncoder(this, (*devlist_ptr)[i]));
+            device_list.push_back(devices.back());
         }
+        deferred_init = false;
+
+        const auto errors = Controller_ns::init_devices(devices.size(), [&](const std::size_t i)
+        {
+            devices[i]->init_hardware();
+        });
+        for (std::size_t i = 0; i < devices.size(); i++)
+            if (!errors[i].empty())
+                devices[i]->set_init_error(errors[i]);
+
         erase_dynamic_attributes(devlist_ptr, get_class_attr()->get_attr_list());
         for (unsigned long i = 1; i <= devlist_ptr->length(); i++)
         {
@@ -154,6 +170,11 @@ namespace BissEncoder_ns
             else
                 export_device(dev, dev->get_name().c_str());
         }
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        Controller_ns::ControllerClass::instance()->startup_time += elapsed.count();
+        TANGO_LOG_INFO << devices.size() << " BissEncoder devices initialised in " << elapsed.count()
+                       << " s" << std::endl;
     }
 
     void BissEncoderClass::attribute_factory(std::vector<Tango::Attr*>& att_list)
@@ -164,6 +185,48 @@ namespace BissEncoder_ns
         position->set_disp_level(Tango::OPERATOR);
         att_list.push_back(position);
 
+        auto* position_mean = new positionMeanAttrib();
+        Tango::UserDefaultAttrProp position_mean_prop;
+        position_mean->set_default_properties(position_mean_prop);
+        position_mean->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(position_mean);
+
+        auto* position_median = new positionMedianAttrib();
+        Tango::UserDefaultAttrProp position_median_prop;
+        position_median->set_default_properties(position_median_prop);
+        position_median->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(position_median);
+
+        auto* position_min = new positionMinAttrib();
+        Tango::UserDefaultAttrProp position_min_prop;
+        position_min->set_default_properties(position_min_prop);
+        position_min->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(position_min);
+
+        auto* position_max = new positionMaxAttrib();
+        Tango::UserDefaultAttrProp position_max_prop;
+        position_max->set_default_properties(position_max_prop);
+        position_max->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(position_max);
+
+        auto* position_std = new positionStdAttrib();
+        Tango::UserDefaultAttrProp position_std_prop;
+        position_std->set_default_properties(position_std_prop);
+        position_std->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(position_std);
+
+        auto* position_ema = new positionEmaAttrib();
+        Tango::UserDefaultAttrProp position_ema_prop;
+        position_ema->set_default_properties(position_ema_prop);
+        position_ema->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(position_ema);
+
+        auto* sample_count = new sampleCountAttrib();
+        Tango::UserDefaultAttrProp sample_count_prop;
+        sample_count->set_default_properties(sample_count_prop);
+        sample_count->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(sample_count);
+
 
         create_static_attribute_list(get_class_attr()->get_attr_list());
     }
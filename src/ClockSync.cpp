@@ -0,0 +1,105 @@
+/*
+* Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ClockSync.h"
+#include <algorithm>
+
+
+namespace Controller_ns
+{
+    // Number of samples the fit is based on.
+    constexpr std::size_t window = 256;
+
+    // Minimum samples and controller time span before the clock rate is estimated.
+    constexpr std::size_t min_points = 16;
+    constexpr double min_span = 2.;
+
+    // Samples with a delay up to this much above the shortest one are used for the fit.
+    constexpr double delay_tolerance = 200e-6;
+
+    namespace
+    {
+        double to_seconds(const ClockSync::Clock::time_point time)
+        {
+            return std::chrono::duration<double>(time.time_since_epoch()).count();
+        }
+    }
+
+    ClockSync::Clock::time_point ClockSync::update(const double controller_time, const Clock::time_point before,
+                                                   const Clock::time_point after)
+    {
+        const auto midpoint = before + (after - before) / 2;
+        // The controller was restarted or its timer wrapped.
+        if (!points.empty() && controller_time < points.back().controller + reference_controller)
+        {
+            points.clear();
+            locked = false;
+        }
+        if (points.empty())
+        {
+            reference_controller = controller_time;
+            reference_host = to_seconds(midpoint);
+        }
+
+        points.push_back({
+            controller_time - reference_controller, to_seconds(midpoint) - reference_host,
+            std::chrono::duration<double>(after - before).count()
+        });
+        if (points.size() > window)
+            points.pop_front();
+        fit();
+
+        latest_offset = reference_host + intercept + (rate - 1.) * (controller_time - reference_controller) -
+            reference_controller;
+
+        // The sample was taken while the query was in flight, so the mapped time can never be outside the window.
+        const auto mapped = Clock::time_point(std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(reference_host + intercept +
+                rate * (controller_time - reference_controller))));
+        return std::clamp(mapped, before, after);
+    }
+
+    void ClockSync::fit()
+    {
+        const auto shortest = std::min_element(points.begin(), points.end(), [](const Point& a, const Point& b)
+        {
+            return a.delay < b.delay;
+        })->delay;
+
+        double n = 0, sx = 0, sy = 0, sxx = 0, sxy = 0;
+        for (const auto& [x, y, delay] : points)
+        {
+            if (delay > shortest + delay_tolerance)
+                continue;
+            n++;
+            sx += x;
+            sy += y;
+            sxx += x * x;
+            sxy += x * y;
+        }
+
+        const double span = points.back().controller - points.front().controller;
+        if (points.size() >= min_points && span >= min_span && n >= 2 && n * sxx - sx * sx > 0)
+        {
+            rate = (n * sxy - sx * sy) / (n * sxx - sx * sx);
+            locked = true;
+        }
+        else if (!locked)
+            rate = 1.;
+        intercept = (sy - rate * sx) / n;
+    }
+}
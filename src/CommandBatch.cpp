@@ -0,0 +1,209 @@
+/*
+* Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "CommandBatch.h"
+#include <tango/tango.h>
+#include <algorithm>
+#include <map>
+#include <sstream>
+
+
+namespace Controller_ns
+{
+    namespace
+    {
+        const std::map<std::string, BatchOperation::Kind> kinds = {
+            {"enable", BatchOperation::Enable},
+            {"disable", BatchOperation::Disable},
+            {"fault_ack", BatchOperation::FaultAck},
+            {"move", BatchOperation::Move},
+            {"param", BatchOperation::Parameter}
+        };
+
+        // Flight recorder codes of the axis command kinds.
+        const std::map<BatchOperation::Kind, FlightCommand> flight_commands = {
+            {BatchOperation::Enable, FlightCommand::Enable},
+            {BatchOperation::Disable, FlightCommand::Disable},
+            {BatchOperation::FaultAck, FlightCommand::FaultAck},
+            {BatchOperation::Move, FlightCommand::MoveAbsolute}
+        };
+
+        const std::map<std::string, Automation1AxisParameterId> parameters = {
+            {"SoftwareLimitSetup", Automation1AxisParameterId_SoftwareLimitSetup},
+            {"SoftwareLimitLow", Automation1AxisParameterId_SoftwareLimitLow},
+            {"SoftwareLimitHigh", Automation1AxisParameterId_SoftwareLimitHigh},
+            {"ReverseMotionDirection", Automation1AxisParameterId_ReverseMotionDirection}
+        };
+
+        std::string last_error()
+        {
+            char msg[100];
+            Automation1_GetLastErrorMessage(msg, 100);
+            return std::format("ERROR: {}", msg);
+        }
+
+        double to_number(const std::string& text)
+        {
+            std::size_t end;
+            const auto value = std::stod(text, &end);
+            if (end != text.size())
+                throw std::invalid_argument(text);
+            return value;
+        }
+    }
+
+    CommandBatch::CommandBatch(const Automation1Controller controller, const std::vector<std::string>& operations) :
+        controller(controller), result(operations.size())
+    {
+        for (std::size_t i = 0; i < operations.size(); i++)
+        {
+            try
+            {
+                ops.push_back(parse(operations[i]));
+                index.push_back(i);
+            }
+            catch (Tango::DevFailed& e)
+            {
+                result[i] = "ERROR: " + std::string(e.errors[0].desc);
+            }
+        }
+    }
+
+    BatchOperation CommandBatch::parse(const std::string& text) const
+    {
+        std::istringstream stream(text);
+        std::vector<std::string> words;
+        for (std::string word; stream >> word;)
+            words.push_back(word);
+
+        BatchOperation op;
+        if (words.size() < 2 || !kinds.contains(words[0]))
+            Tango::Except::throw_exception("InvalidArgument", std::format("Invalid operation '{}'", text),
+                                           "CommandBatch::parse()");
+        op.kind = kinds.at(words[0]);
+        const std::size_t expected = op.kind == BatchOperation::Move || op.kind == BatchOperation::Parameter ? 4 : 2;
+        if (words.size() != expected)
+            Tango::Except::throw_exception("InvalidArgument",
+                                           std::format("'{}' expects {} arguments", words[0], expected - 1),
+                                           "CommandBatch::parse()");
+
+        if (!Automation1_Controller_GetAxisIndexFromAxisName(controller, words[1].c_str(), &op.axisID))
+            Tango::Except::throw_exception("AxisNotFound", std::format("Unknown axis {}", words[1]),
+                                           "CommandBatch::parse()");
+        try
+        {
+            if (op.kind == BatchOperation::Move)
+            {
+                op.position = to_number(words[2]);
+                op.velocity = to_number(words[3]);
+            }
+            else if (op.kind == BatchOperation::Parameter)
+            {
+                op.parameter = parameters.contains(words[2])
+                                   ? parameters.at(words[2])
+                                   : static_cast<Automation1AxisParameterId>(static_cast<int>(to_number(words[2])));
+                op.value = to_number(words[3]);
+            }
+        }
+        catch (std::logic_error&)
+        {
+            Tango::Except::throw_exception("InvalidArgument", std::format("Invalid number in '{}'", text),
+                                           "CommandBatch::parse()");
+        }
+        return op;
+    }
+
+    void CommandBatch::execute(FlightRecorder& recorder)
+    {
+        std::vector<int> axisIDs;
+        std::vector<double> positions;
+        std::vector<double> velocities;
+
+        std::size_t i = 0;
+        bool failed = ops.size() != result.size();
+        while (i < ops.size())
+        {
+            const auto kind = ops[i].kind;
+            std::size_t end = i + 1;
+            // An axis can only appear once in a multi-axis call.
+            if (kind != BatchOperation::Parameter)
+                while (end < ops.size() && ops[end].kind == kind &&
+                    std::none_of(ops.begin() + i, ops.begin() + end, [&](const BatchOperation& op)
+                    {
+                        return op.axisID == ops[end].axisID;
+                    }))
+                    end++;
+            if (failed)
+            {
+                for (auto j = i; j < end; j++)
+                    result[index[j]] = "SKIPPED";
+                i = end;
+                continue;
+            }
+
+            axisIDs.clear();
+            positions.clear();
+            velocities.clear();
+            for (auto j = i; j < end; j++)
+            {
+                axisIDs.push_back(ops[j].axisID);
+                positions.push_back(ops[j].position);
+                velocities.push_back(ops[j].velocity);
+                touched.insert(ops[j].axisID);
+            }
+            const auto count = static_cast<int>(axisIDs.size());
+
+            bool ok = false;
+            switch (kind)
+            {
+            case BatchOperation::Enable:
+                ok = Automation1_Command_Enable(controller, 1, axisIDs.data(), count);
+                break;
+            case BatchOperation::Disable:
+                ok = Automation1_Command_Disable(controller, axisIDs.data(), count);
+                break;
+            case BatchOperation::FaultAck:
+                ok = Automation1_Command_FaultAcknowledge(controller, 1, axisIDs.data(), count);
+                break;
+            case BatchOperation::Move:
+                ok = Automation1_Command_MoveAbsolute(controller, 1, axisIDs.data(), count, positions.data(), count,
+                                                      velocities.data(), count);
+                break;
+            case BatchOperation::Parameter:
+                ok = Automation1_Parameter_SetAxisValue(controller, ops[i].axisID, ops[i].parameter, ops[i].value);
+                break;
+            }
+
+            if (const auto command = flight_commands.find(kind); command != flight_commands.end())
+            {
+                for (auto j = i; j < end; j++)
+                {
+                    if (kind == BatchOperation::Move)
+                        recorder.command(command->second, ops[j].axisID, {ops[j].position, ops[j].velocity}, ok);
+                    else
+                        recorder.command(command->second, ops[j].axisID, {}, ok);
+                }
+            }
+
+            const auto status = ok ? std::string("OK") : last_error();
+            for (auto j = i; j < end; j++)
+                result[index[j]] = status;
+            failed = !ok;
+            i = end;
+        }
+    }
+}
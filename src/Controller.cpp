@@ -18,7 +18,11 @@
 #include "Controller.h"
 #include "ControllerClass.h"
 #include "Automation1.h"
+#include "CommandBatch.h"
+#include "Trace.h"
+#include <filesystem>
 #include <format>
+#include <optional>
 
 
 namespace Controller_ns
@@ -51,7 +55,26 @@ namespace Controller_ns
         delete attr_available_axis_count_read;
         delete attr_available_task_count_read;
         delete attr_is_running_read;
+        delete attr_startup_time_read;
+        delete attr_status_query_rate_read;
+        delete attr_clock_offset_read;
+        delete attr_clock_drift_read;
+        delete attr_servo_loop_utilization_read;
+        delete attr_cpu_utilization_read;
+        delete attr_data_collection_usage_read;
+        delete attr_controller_response_time_read;
+        delete attr_tracing_read;
+        delete attr_trace_dropped_read;
 
+        stop_global_watch();
+        watches.reset();
+        events.reset();
+        ControllerClass::instance()->telemetry.stop();
+        ControllerClass::instance()->io.stop();
+        ControllerClass::instance()->sampler.stop();
+        if (task_config != nullptr)
+            Automation1_StatusConfig_Destroy(task_config);
+        task_config = nullptr;
         Automation1_Disconnect(ControllerClass::instance()->controller);
     }
 
@@ -64,15 +87,79 @@ namespace Controller_ns
         attr_available_axis_count_read = new Tango::DevShort();
         attr_available_task_count_read = new Tango::DevShort();
         attr_is_running_read = new Tango::DevBoolean();
+        attr_startup_time_read = new Tango::DevDouble();
+        attr_status_query_rate_read = new Tango::DevDouble();
+        attr_clock_offset_read = new Tango::DevDouble();
+        attr_clock_drift_read = new Tango::DevDouble();
+        attr_servo_loop_utilization_read = new Tango::DevDouble();
+        attr_cpu_utilization_read = new Tango::DevDouble();
+        attr_data_collection_usage_read = new Tango::DevDouble();
+        attr_controller_response_time_read = new Tango::DevDouble();
+        attr_tracing_read = new Tango::DevBoolean();
+        attr_trace_dropped_read = new Tango::DevLong64();
 
         connect();
+        ControllerClass::instance()->programs.reset_uploads();
+        global_real_range.resize(2);
+        global_integer_range.resize(2);
+        ControllerClass::instance()->global_reals.configure(global_real_range[0], global_real_range[1]);
+        ControllerClass::instance()->global_integers.configure(global_integer_range[0], global_integer_range[1]);
+        set_change_event("global_reals", true, false);
+        set_change_event("global_integers", true, false);
+        events = std::make_unique<EventPusher>(*this);
+        start_global_watch();
+        watches = std::make_unique<WatchSet>(*this, *events, ControllerClass::instance()->controller,
+                                             ControllerClass::instance()->mutex, ControllerClass::instance()->sampler);
+        open_flight_recorder();
+        ControllerClass::instance()->sampler.start(fast_sampling_rate, slow_sampling_rate,
+                                                   flight_recorder_snapshot_period);
+        int task_count;
+        {
+            std::lock_guard lk(ControllerClass::instance()->mutex);
+            task_count = Automation1_Controller_AvailableTaskCount(ControllerClass::instance()->controller);
+        }
+        ControllerClass::instance()->telemetry.start(telemetry_rate, task_count);
+        ControllerClass::instance()->io.start(io_poll_rate);
         set_state(Tango::STANDBY);
     }
 
+    void Controller::open_flight_recorder()
+    {
+        try
+        {
+            const auto path = flight_recorder_file.empty()
+                                  ? FlightRecorder::default_path(get_name())
+                                  : std::filesystem::path(flight_recorder_file);
+            ControllerClass::instance()->recorder.open(path,
+                                                       static_cast<std::size_t>(std::max(1, flight_recorder_records)));
+        }
+        catch (const Tango::DevFailed& e)
+        {
+            // The server keeps running without the journal.
+            ERROR_STREAM << "Controller::open_flight_recorder() " << e.errors[0].desc << std::endl;
+        }
+        catch (const std::filesystem::filesystem_error& e)
+        {
+            ERROR_STREAM << "Controller::open_flight_recorder() " << e.what() << std::endl;
+        }
+    }
+
     void Controller::get_device_property()
     {
         Tango::DbData dev_prop;
         dev_prop.emplace_back("ip_address");
+        dev_prop.emplace_back("fast_sampling_rate");
+        dev_prop.emplace_back("slow_sampling_rate");
+        dev_prop.emplace_back("program_cache_dir");
+        dev_prop.emplace_back("global_real_range");
+        dev_prop.emplace_back("global_integer_range");
+        dev_prop.emplace_back("global_poll_rate");
+        dev_prop.emplace_back("telemetry_rate");
+        dev_prop.emplace_back("io_poll_rate");
+        dev_prop.emplace_back("flight_recorder_file");
+        dev_prop.emplace_back("flight_recorder_records");
+        dev_prop.emplace_back("flight_recorder_snapshot_period");
+        dev_prop.emplace_back("trace_export_dir");
 
         if (!dev_prop.empty())
         {
@@ -91,22 +178,133 @@ namespace Controller_ns
                     is_empty()) def_prop >> ip_address;
             }
             if (!dev_prop[i].is_empty()) dev_prop[i] >> ip_address;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty()) cl_prop
+                >> fast_sampling_rate;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty()) def_prop >> fast_sampling_rate;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> fast_sampling_rate;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty()) cl_prop
+                >> slow_sampling_rate;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty()) def_prop >> slow_sampling_rate;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> slow_sampling_rate;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty()) cl_prop
+                >> program_cache_dir;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty()) def_prop >> program_cache_dir;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> program_cache_dir;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty()) cl_prop
+                >> global_real_range;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty()) def_prop >> global_real_range;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> global_real_range;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty()) cl_prop
+                >> global_integer_range;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty()) def_prop >> global_integer_range;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> global_integer_range;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty()) cl_prop
+                >> global_poll_rate;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty()) def_prop >> global_poll_rate;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> global_poll_rate;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty()) cl_prop
+                >> telemetry_rate;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty()) def_prop >> telemetry_rate;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> telemetry_rate;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty()) cl_prop
+                >> io_poll_rate;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty()) def_prop >> io_poll_rate;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> io_poll_rate;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty()) cl_prop
+                >> flight_recorder_file;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty()) def_prop >> flight_recorder_file;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> flight_recorder_file;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty()) cl_prop
+                >> flight_recorder_records;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty()) def_prop >> flight_recorder_records;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> flight_recorder_records;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty()) cl_prop
+                >> flight_recorder_snapshot_period;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty()) def_prop >> flight_recorder_snapshot_period;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> flight_recorder_snapshot_period;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty()) cl_prop
+                >> trace_export_dir;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty()) def_prop >> trace_export_dir;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> trace_export_dir;
         }
+        if (!program_cache_dir.empty())
+            ControllerClass::instance()->programs.set_directory(program_cache_dir);
     }
 
     void Controller::always_executed_hook()
     {
-        DEBUG_STREAM << "Controller::always_executed_hook()  " << device_name << std::endl;
+        TRACE_INSTANT(trace_detail, "Controller::always_executed_hook");
     }
 
     void Controller::read_attr_hardware(TANGO_UNUSED(std::vector<long> &attr_list))
     {
-        DEBUG_STREAM << "Controller::read_attr_hardware(std::vector<long> &attr_list) entering... " << std::endl;
+        TRACE_SCOPE(trace_calls, "Controller::read_attr_hardware", "attributes", attr_list.size());
+        load = ControllerClass::instance()->telemetry.load();
     }
 
     void Controller::write_attr_hardware(TANGO_UNUSED(std::vector<long> &attr_list))
     {
-        DEBUG_STREAM << "Controller::write_attr_hardware(std::vector<long> &attr_list) entering... " << std::endl;
+        TRACE_INSTANT(trace_detail, "Controller::write_attr_hardware", "attributes", attr_list.size());
     }
 
 
@@ -145,11 +343,438 @@ namespace Controller_ns
             Tango::Except::throw_exception("ConnectionError", "Controller not connected", "read_is_running");
         }
 
-        *attr_available_task_count_read = 0;
+        *attr_available_task_count_read = static_cast<short>(Automation1_Controller_AvailableTaskCount(
+            ControllerClass::instance()->controller));
         att.set_value(attr_available_task_count_read);
     }
 
 
+    void Controller::read_startup_time(Tango::Attribute& att) const
+    {
+        *attr_startup_time_read = ControllerClass::instance()->startup_time;
+        att.set_value(attr_startup_time_read);
+    }
+
+    void Controller::read_status_query_rate(Tango::Attribute& att) const
+    {
+        *attr_status_query_rate_read = ControllerClass::instance()->sampler.calls_per_second();
+        att.set_value(attr_status_query_rate_read);
+    }
+
+    Tango::DevVarStringArray* Controller::execute_batch(const Tango::DevVarStringArray* arg_in)
+    {
+        TRACE_SCOPE(trace_calls, "Controller::execute_batch", "operations", arg_in->length());
+        std::vector<std::string> operations;
+        for (unsigned int i = 0; i < arg_in->length(); i++)
+            operations.emplace_back((*arg_in)[i].in());
+
+        std::optional<CommandBatch> batch;
+        {
+            std::lock_guard lk(ControllerClass::instance()->mutex);
+            batch.emplace(ControllerClass::instance()->controller, operations);
+            batch->execute(ControllerClass::instance()->recorder);
+        }
+        for (const auto axisID : batch->axes())
+            ControllerClass::instance()->sampler.invalidate(axisID);
+
+        const auto& results = batch->results();
+        auto* argout = new Tango::DevVarStringArray();
+        argout->length(static_cast<CORBA::ULong>(results.size()));
+        for (std::size_t i = 0; i < results.size(); i++)
+        {
+            (*argout)[i] = Tango::string_dup(results[i].c_str());
+            if (results[i] != "OK")
+                ERROR_STREAM << "Controller::execute_batch() " << operations[i] << ": " << results[i] << std::endl;
+        }
+        return argout;
+    }
+
+    bool Controller::is_execute_batch_allowed(TANGO_UNUSED(const CORBA::Any &any))
+    {
+        return ControllerClass::instance()->controller != nullptr;
+    }
+
+    std::pair<int, std::string> Controller::get_program_argument(const Tango::DevVarLongStringArray* arg_in)
+    {
+        if (arg_in->lvalue.length() != 1 || arg_in->svalue.length() != 1)
+            Tango::Except::throw_exception("InvalidArgument", "Expected [task], [AeroScript source]",
+                                           "get_program_argument()");
+        const int task = arg_in->lvalue[0];
+        check_task(task);
+        return {task, std::string(arg_in->svalue[0].in())};
+    }
+
+    void Controller::check_task(const int task)
+    {
+        if (task < 1 || task >= Automation1_Controller_AvailableTaskCount(ControllerClass::instance()->controller))
+            Tango::Except::throw_exception("InvalidArgument", std::format("Invalid task {}", task), "check_task()");
+    }
+
+    Tango::DevString Controller::program_compile(const Tango::DevString source)
+    {
+        TRACE_SCOPE(trace_calls, "Controller::program_compile");
+        ControllerClass::instance()->programs.compile(source);
+        return Tango::string_dup(ProgramCache::key(source).c_str());
+    }
+
+    void Controller::program_load(const Tango::DevVarLongStringArray* arg_in)
+    {
+        const auto [task, source] = get_program_argument(arg_in);
+        TRACE_SCOPE(trace_calls, "Controller::program_load", "task", task);
+        auto& programs = ControllerClass::instance()->programs;
+        const auto compiled = programs.compile(source);
+
+        std::lock_guard lk(ControllerClass::instance()->mutex);
+        const auto file = programs.upload(ControllerClass::instance()->controller, compiled);
+        if (!Automation1_Task_ProgramLoad(ControllerClass::instance()->controller, task, file.c_str()))
+        {
+            char msg[100];
+            Automation1_GetLastErrorMessage(msg, 100);
+            Tango::Except::throw_exception("ProgramError", msg, "program_load()");
+        }
+    }
+
+    void Controller::program_run(const Tango::DevVarLongStringArray* arg_in)
+    {
+        const auto [task, source] = get_program_argument(arg_in);
+        TRACE_SCOPE(trace_calls, "Controller::program_run", "task", task);
+        auto& programs = ControllerClass::instance()->programs;
+        const auto compiled = programs.compile(source);
+
+        std::lock_guard lk(ControllerClass::instance()->mutex);
+        const auto file = programs.upload(ControllerClass::instance()->controller, compiled);
+        const bool ok = Automation1_Task_ProgramRun(ControllerClass::instance()->controller, task, file.c_str());
+        ControllerClass::instance()->recorder.command(FlightCommand::ProgramRun, -1, {static_cast<double>(task)}, ok);
+        if (!ok)
+        {
+            char msg[100];
+            Automation1_GetLastErrorMessage(msg, 100);
+            Tango::Except::throw_exception("ProgramError", msg, "program_run()");
+        }
+    }
+
+    void Controller::program_start(const Tango::DevLong task)
+    {
+        TRACE_SCOPE(trace_calls, "Controller::program_start", "task", task);
+        check_task(task);
+        std::lock_guard lk(ControllerClass::instance()->mutex);
+        const bool ok = Automation1_Task_ProgramStart(ControllerClass::instance()->controller, task);
+        ControllerClass::instance()->recorder.command(FlightCommand::ProgramStart, -1, {static_cast<double>(task)},
+                                                      ok);
+        if (!ok)
+        {
+            char msg[100];
+            Automation1_GetLastErrorMessage(msg, 100);
+            Tango::Except::throw_exception("ProgramError", msg, "program_start()");
+        }
+    }
+
+    void Controller::program_stop(const Tango::DevLong task)
+    {
+        TRACE_SCOPE(trace_calls, "Controller::program_stop", "task", task);
+        check_task(task);
+        std::lock_guard lk(ControllerClass::instance()->mutex);
+        const bool ok = Automation1_Task_ProgramStop(ControllerClass::instance()->controller, task, 1000);
+        ControllerClass::instance()->recorder.command(FlightCommand::ProgramStop, -1, {static_cast<double>(task)}, ok);
+        if (!ok)
+        {
+            char msg[100];
+            Automation1_GetLastErrorMessage(msg, 100);
+            Tango::Except::throw_exception("ProgramError", msg, "program_stop()");
+        }
+    }
+
+    bool Controller::is_program_allowed(TANGO_UNUSED(const CORBA::Any &any))
+    {
+        return ControllerClass::instance()->controller != nullptr;
+    }
+
+    void Controller::read_task_status(Tango::Attribute& att)
+    {
+        static const std::map<int, std::string> states = {
+            {Automation1TaskState_Unavailable, "Unavailable"},
+            {Automation1TaskState_Inactive, "Inactive"},
+            {Automation1TaskState_Idle, "Idle"},
+            {Automation1TaskState_ProgramReady, "ProgramReady"},
+            {Automation1TaskState_ProgramRunning, "ProgramRunning"},
+            {Automation1TaskState_ProgramFeedhold, "ProgramFeedhold"},
+            {Automation1TaskState_ProgramPaused, "ProgramPaused"},
+            {Automation1TaskState_ProgramComplete, "ProgramComplete"},
+            {Automation1TaskState_Error, "Error"},
+            {Automation1TaskState_QueueRunning, "QueueRunning"},
+            {Automation1TaskState_QueuePaused, "QueuePaused"}
+        };
+        constexpr int nItems = 3;
+
+        const auto controller = ControllerClass::instance()->controller;
+        if (!controller)
+            Tango::Except::throw_exception("ConnectionError", "Controller not connected", "read_task_status");
+
+        std::vector<double> results;
+        {
+            std::lock_guard lk(ControllerClass::instance()->mutex);
+            // Task 0 is the library task and never runs programs.
+            const int count = Automation1_Controller_AvailableTaskCount(controller);
+            if (task_config == nullptr || count != task_config_count)
+            {
+                if (task_config != nullptr)
+                    Automation1_StatusConfig_Destroy(task_config);
+                Automation1_StatusConfig_Create(&task_config);
+                for (int task = 1; task < count; task++)
+                {
+                    Automation1_StatusConfig_AddTaskStatusItem(task_config, task,
+                                                               Automation1TaskStatusItem_TaskState, 0);
+                    Automation1_StatusConfig_AddTaskStatusItem(task_config, task,
+                                                               Automation1TaskStatusItem_TaskErrorCode, 0);
+                    Automation1_StatusConfig_AddTaskStatusItem(task_config, task,
+                                                               Automation1TaskStatusItem_ProgramLineNumber, 0);
+                }
+                task_config_count = count;
+            }
+            results.resize(static_cast<std::size_t>(std::max(count - 1, 0) * nItems));
+            if (!Automation1_Status_GetResults(controller, task_config, results.data(),
+                                               static_cast<int>(results.size())))
+            {
+                char msg[100];
+                Automation1_GetLastErrorMessage(msg, 100);
+                Tango::Except::throw_exception("StatusError", msg, "read_task_status");
+            }
+        }
+
+        task_status.clear();
+        for (std::size_t i = 0; i < results.size() / nItems; i++)
+        {
+            const auto state = static_cast<int>(results[i * nItems]);
+            task_status.push_back(std::format("task={} state={} error={} line={}", i + 1,
+                                              states.contains(state) ? states.at(state) : std::to_string(state),
+                                              static_cast<int>(results[i * nItems + 1]),
+                                              static_cast<int>(results[i * nItems + 2])));
+        }
+        task_status_read.clear();
+        for (auto& status : task_status)
+            task_status_read.push_back(status.data());
+        att.set_value(task_status_read.data(), static_cast<long>(task_status_read.size()));
+    }
+
+    void Controller::check_load() const
+    {
+        if (load.valid)
+            return;
+        const auto error = ControllerClass::instance()->telemetry.last_error();
+        Tango::Except::throw_exception("NoTelemetry", error.empty() ? "No telemetry sample available" : error,
+                                       "Controller::check_load()");
+    }
+
+    void Controller::read_servo_loop_utilization(Tango::Attribute& att)
+    {
+        check_load();
+        *attr_servo_loop_utilization_read = load.servo_loop_utilization;
+        att.set_value(attr_servo_loop_utilization_read);
+    }
+
+    void Controller::read_cpu_utilization(Tango::Attribute& att)
+    {
+        check_load();
+        *attr_cpu_utilization_read = load.cpu_utilization;
+        att.set_value(attr_cpu_utilization_read);
+    }
+
+    void Controller::read_data_collection_usage(Tango::Attribute& att)
+    {
+        check_load();
+        *attr_data_collection_usage_read = load.data_collection_usage;
+        att.set_value(attr_data_collection_usage_read);
+    }
+
+    void Controller::read_controller_response_time(Tango::Attribute& att)
+    {
+        check_load();
+        *attr_controller_response_time_read = load.query_time * 1e3;
+        att.set_value(attr_controller_response_time_read);
+    }
+
+    void Controller::read_task_queue_depth(Tango::Attribute& att)
+    {
+        check_load();
+        task_queue_depth_read.assign(load.queue_depth.begin(), load.queue_depth.end());
+        att.set_value(task_queue_depth_read.data(), static_cast<long>(task_queue_depth_read.size()));
+    }
+
+    void Controller::read_task_queue_capacity(Tango::Attribute& att)
+    {
+        check_load();
+        task_queue_capacity_read.assign(load.queue_capacity.begin(), load.queue_capacity.end());
+        att.set_value(task_queue_capacity_read.data(), static_cast<long>(task_queue_capacity_read.size()));
+    }
+
+    void Controller::watch_add(const Tango::DevVarStringArray* arg_in)
+    {
+        if (arg_in->length() != 2)
+            Tango::Except::throw_exception("InvalidArgument", "Expected [name, expression]",
+                                           "Controller::watch_add()");
+        const std::string name((*arg_in)[0].in());
+        DEBUG_STREAM << "Controller::watch_add() " << name << ": " << (*arg_in)[1].in() << std::endl;
+        watches->add(name, (*arg_in)[1].in(), std::nullopt,
+                     std::make_unique<watchAttrib>(WatchSet::attribute_name(name)));
+    }
+
+    void Controller::watch_remove(const Tango::DevString name)
+    {
+        DEBUG_STREAM << "Controller::watch_remove() " << name << std::endl;
+        watches->remove(name);
+    }
+
+    Tango::DevVarStringArray* Controller::watch_list()
+    {
+        const auto entries = watches->list();
+        auto* argout = new Tango::DevVarStringArray();
+        argout->length(static_cast<CORBA::ULong>(entries.size()));
+        for (std::size_t i = 0; i < entries.size(); i++)
+            (*argout)[i] = Tango::string_dup(entries[i].c_str());
+        return argout;
+    }
+
+    bool Controller::is_watch_allowed(TANGO_UNUSED(const CORBA::Any &any))
+    {
+        return ControllerClass::instance()->controller != nullptr;
+    }
+
+    void Controller::read_watch(Tango::Attribute& att)
+    {
+        watches->read(att);
+    }
+
+    void Controller::read_tracing(Tango::Attribute& att)
+    {
+        *attr_tracing_read = Tracer::instance().enabled();
+        att.set_value(attr_tracing_read);
+    }
+
+    void Controller::write_tracing(Tango::WAttribute& att)
+    {
+        Tango::DevBoolean value;
+        att.get_write_value(value);
+        Tracer::instance().set_enabled(value);
+    }
+
+    void Controller::read_trace_dropped(Tango::Attribute& att)
+    {
+        *attr_trace_dropped_read = static_cast<Tango::DevLong64>(Tracer::instance().dropped());
+        att.set_value(attr_trace_dropped_read);
+    }
+
+    Tango::DevLong Controller::trace_export(const Tango::DevString file_name)
+    {
+        DEBUG_STREAM << "Controller::trace_export() " << file_name << std::endl;
+        // Clients only choose the name, the server writes nowhere but the configured directory.
+        const std::string name(file_name);
+        if (name.empty() || name == "." || name == ".." || name.find('/') != std::string::npos)
+            Tango::Except::throw_exception("InvalidArgument", "Expected a file name without a directory",
+                                           "Controller::trace_export()");
+        const auto directory = trace_export_dir.empty()
+                                   ? std::filesystem::temp_directory_path()
+                                   : std::filesystem::path(trace_export_dir);
+        return static_cast<Tango::DevLong>(Tracer::instance().export_chrome(directory / name));
+    }
+
+    void Controller::read_global_reals(Tango::Attribute& att)
+    {
+        ControllerClass::instance()->global_reals.read(global_reals_read);
+        att.set_value(global_reals_read.data(), static_cast<long>(global_reals_read.size()));
+    }
+
+    void Controller::write_global_reals(Tango::WAttribute& att)
+    {
+        const Tango::DevDouble* values;
+        att.get_write_value(values);
+        ControllerClass::instance()->global_reals.write(values, static_cast<int>(att.get_write_value_length()));
+    }
+
+    void Controller::read_global_integers(Tango::Attribute& att)
+    {
+        ControllerClass::instance()->global_integers.read(global_integers_values);
+        global_integers_read.assign(global_integers_values.begin(), global_integers_values.end());
+        att.set_value(global_integers_read.data(), static_cast<long>(global_integers_read.size()));
+    }
+
+    void Controller::write_global_integers(Tango::WAttribute& att)
+    {
+        const Tango::DevLong64* values;
+        att.get_write_value(values);
+        const std::vector<std::int64_t> converted(values, values + att.get_write_value_length());
+        ControllerClass::instance()->global_integers.write(converted.data(), static_cast<int>(converted.size()));
+    }
+
+    void Controller::start_global_watch()
+    {
+        if (global_poll_rate <= 0 || (ControllerClass::instance()->global_reals.size() == 0 &&
+            ControllerClass::instance()->global_integers.size() == 0))
+            return;
+        global_watch = true;
+        global_thread = std::thread(&Controller::watch_globals, this);
+    }
+
+    void Controller::stop_global_watch()
+    {
+        {
+            std::lock_guard lk(global_mutex);
+            global_watch = false;
+        }
+        global_cv.notify_all();
+        if (global_thread.joinable())
+            global_thread.join();
+    }
+
+    void Controller::watch_globals()
+    {
+        const auto period = std::chrono::duration<double>(1. / global_poll_rate);
+        std::vector<double> reals;
+        std::vector<std::int64_t> integers;
+        std::string last_error;
+        std::unique_lock lk(global_mutex);
+        while (!global_cv.wait_for(lk, period, [this] { return !global_watch; }))
+        {
+            lk.unlock();
+            try
+            {
+                // The only place that detects changes, the events are pushed under the device monitor.
+                if (ControllerClass::instance()->global_reals.poll(reals))
+                    events->post("global_reals", [this, values = reals]() mutable
+                    {
+                        push_change_event("global_reals", values.data(), static_cast<long>(values.size()));
+                    });
+                if (ControllerClass::instance()->global_integers.poll(integers))
+                    events->post("global_integers", [this, values = std::vector<Tango::DevLong64>(
+                                     integers.begin(), integers.end())]() mutable
+                    {
+                        push_change_event("global_integers", values.data(), static_cast<long>(values.size()));
+                    });
+            }
+            catch (Tango::DevFailed& e)
+            {
+                // Only log when the error changes, the watch keeps retrying at its rate.
+                if (const std::string error(e.errors[0].desc); error != last_error)
+                {
+                    ERROR_STREAM << "Controller::watch_globals() " << error << std::endl;
+                    last_error = error;
+                }
+            }
+            lk.lock();
+        }
+    }
+
+    void Controller::read_clock_offset(Tango::Attribute& att) const
+    {
+        *attr_clock_offset_read = ControllerClass::instance()->sampler.clock_offset_drift().first;
+        att.set_value(attr_clock_offset_read);
+    }
+
+    void Controller::read_clock_drift(Tango::Attribute& att) const
+    {
+        *attr_clock_drift_read = ControllerClass::instance()->sampler.clock_offset_drift().second * 1e6;
+        att.set_value(attr_clock_drift_read);
+    }
+
     void Controller::connect()
     {
         DEBUG_STREAM << "Controller::connect entering... " << std::endl;
@@ -167,7 +792,7 @@ namespace Controller_ns
 
     void Controller::read_is_running(Tango::Attribute& attr)
     {
-        DEBUG_STREAM << "Controller::read_is_running(Tango::Attribute &attr) entering... " << std::endl;
+        TRACE_SCOPE(trace_calls, "Controller::read_is_running");
         if (!ControllerClass::instance()->controller)
         {
             Tango::Except::throw_exception("ConnectionError", "Controller not connected", "read_is_running");
@@ -100,8 +100,175 @@ namespace Controller_ns
     {
         std::vector<std::string> vect_data;
 
-        const std::string prop_name = "ip_address";
-        const std::string prop_desc;
+        std::string prop_name = "ip_address";
+        std::string prop_desc;
+        vect_data.clear();
+        if (const std::string prop_def; !prop_def.empty())
+        {
+            Tango::DbDatum data(prop_name);
+            data << vect_data;
+            dev_def_prop.push_back(data);
+            add_wiz_dev_prop(prop_name, prop_desc, prop_def);
+        }
+        else
+            add_wiz_dev_prop(prop_name, prop_desc);
+
+        prop_name = "fast_sampling_rate";
+        prop_desc = "Status sampling rate in Hz of moving and homing axes.";
+        vect_data.clear();
+        vect_data.emplace_back("50");
+        if (const std::string prop_def = "50"; !prop_def.empty())
+        {
+            Tango::DbDatum data(prop_name);
+            data << vect_data;
+            dev_def_prop.push_back(data);
+            add_wiz_dev_prop(prop_name, prop_desc, prop_def);
+        }
+        else
+            add_wiz_dev_prop(prop_name, prop_desc);
+
+        prop_name = "slow_sampling_rate";
+        prop_desc = "Status sampling rate in Hz of idle and disabled axes.";
+        vect_data.clear();
+        vect_data.emplace_back("2");
+        if (const std::string prop_def = "2"; !prop_def.empty())
+        {
+            Tango::DbDatum data(prop_name);
+            data << vect_data;
+            dev_def_prop.push_back(data);
+            add_wiz_dev_prop(prop_name, prop_desc, prop_def);
+        }
+        else
+            add_wiz_dev_prop(prop_name, prop_desc);
+
+        prop_name = "program_cache_dir";
+        prop_desc = "Directory of the compiled AeroScript program cache. Empty uses the system temp directory.";
+        vect_data.clear();
+        if (const std::string prop_def; !prop_def.empty())
+        {
+            Tango::DbDatum data(prop_name);
+            data << vect_data;
+            dev_def_prop.push_back(data);
+            add_wiz_dev_prop(prop_name, prop_desc, prop_def);
+        }
+        else
+            add_wiz_dev_prop(prop_name, prop_desc);
+
+        prop_name = "global_real_range";
+        prop_desc = "First index and number of the controller global reals mapped to global_reals.";
+        vect_data.clear();
+        vect_data.emplace_back("0");
+        vect_data.emplace_back("0");
+        if (const std::string prop_def = "0\n0"; !prop_def.empty())
+        {
+            Tango::DbDatum data(prop_name);
+            data << vect_data;
+            dev_def_prop.push_back(data);
+            add_wiz_dev_prop(prop_name, prop_desc, prop_def);
+        }
+        else
+            add_wiz_dev_prop(prop_name, prop_desc);
+
+        prop_name = "global_integer_range";
+        prop_desc = "First index and number of the controller global integers mapped to global_integers.";
+        vect_data.clear();
+        vect_data.emplace_back("0");
+        vect_data.emplace_back("0");
+        if (const std::string prop_def = "0\n0"; !prop_def.empty())
+        {
+            Tango::DbDatum data(prop_name);
+            data << vect_data;
+            dev_def_prop.push_back(data);
+            add_wiz_dev_prop(prop_name, prop_desc, prop_def);
+        }
+        else
+            add_wiz_dev_prop(prop_name, prop_desc);
+
+        prop_name = "global_poll_rate";
+        prop_desc = "Rate in Hz the global variables are checked for changes to push change events. 0 disables it.";
+        vect_data.clear();
+        vect_data.emplace_back("10");
+        if (const std::string prop_def = "10"; !prop_def.empty())
+        {
+            Tango::DbDatum data(prop_name);
+            data << vect_data;
+            dev_def_prop.push_back(data);
+            add_wiz_dev_prop(prop_name, prop_desc, prop_def);
+        }
+        else
+            add_wiz_dev_prop(prop_name, prop_desc);
+
+        prop_name = "telemetry_rate";
+        prop_desc = "Rate in Hz the drive telemetry items of the axes are read. 0 disables it.";
+        vect_data.clear();
+        vect_data.emplace_back("1");
+        if (const std::string prop_def = "1"; !prop_def.empty())
+        {
+            Tango::DbDatum data(prop_name);
+            data << vect_data;
+            dev_def_prop.push_back(data);
+            add_wiz_dev_prop(prop_name, prop_desc, prop_def);
+        }
+        else
+            add_wiz_dev_prop(prop_name, prop_desc);
+
+        prop_name = "io_poll_rate";
+        prop_desc = "Rate in Hz the inputs and outputs of the IO devices are read.";
+        vect_data.clear();
+        vect_data.emplace_back("20");
+        if (const std::string prop_def = "20"; !prop_def.empty())
+        {
+            Tango::DbDatum data(prop_name);
+            data << vect_data;
+            dev_def_prop.push_back(data);
+            add_wiz_dev_prop(prop_name, prop_desc, prop_def);
+        }
+        else
+            add_wiz_dev_prop(prop_name, prop_desc);
+
+        prop_name = "flight_recorder_file";
+        prop_desc = "Journal file of the flight recorder. Empty uses a per device file in a private temp directory.";
+        vect_data.clear();
+        if (const std::string prop_def; !prop_def.empty())
+        {
+            Tango::DbDatum data(prop_name);
+            data << vect_data;
+            dev_def_prop.push_back(data);
+            add_wiz_dev_prop(prop_name, prop_desc, prop_def);
+        }
+        else
+            add_wiz_dev_prop(prop_name, prop_desc);
+
+        prop_name = "flight_recorder_records";
+        prop_desc = "Number of 64 byte records kept in the flight recorder journal.";
+        vect_data.clear();
+        vect_data.emplace_back("262144");
+        if (const std::string prop_def = "262144"; !prop_def.empty())
+        {
+            Tango::DbDatum data(prop_name);
+            data << vect_data;
+            dev_def_prop.push_back(data);
+            add_wiz_dev_prop(prop_name, prop_desc, prop_def);
+        }
+        else
+            add_wiz_dev_prop(prop_name, prop_desc);
+
+        prop_name = "flight_recorder_snapshot_period";
+        prop_desc = "Seconds between the status snapshots of an axis in the flight recorder. 0 disables them.";
+        vect_data.clear();
+        vect_data.emplace_back("1");
+        if (const std::string prop_def = "1"; !prop_def.empty())
+        {
+            Tango::DbDatum data(prop_name);
+            data << vect_data;
+            dev_def_prop.push_back(data);
+            add_wiz_dev_prop(prop_name, prop_desc, prop_def);
+        }
+        else
+            add_wiz_dev_prop(prop_name, prop_desc);
+
+        prop_name = "trace_export_dir";
+        prop_desc = "Directory traceExport writes to. Empty uses the system temp directory.";
         vect_data.clear();
         if (const std::string prop_def; !prop_def.empty())
         {
@@ -187,6 +354,41 @@ namespace Controller_ns
         available_axis_count->set_disp_level(Tango::OPERATOR);
         att_list.push_back(available_axis_count);
 
+        // add status_query_rate attribute
+        auto* status_query_rate = new status_query_rateAttrib();
+        Tango::UserDefaultAttrProp status_query_rate_prop;
+        status_query_rate_prop.set_unit("Hz");
+        status_query_rate_prop.set_description("Batched status queries sent to the controller per second.");
+        status_query_rate->set_default_properties(status_query_rate_prop);
+        status_query_rate->set_disp_level(Tango::EXPERT);
+        att_list.push_back(status_query_rate);
+
+        // add startup_time attribute
+        auto* startup_time = new startup_timeAttrib();
+        Tango::UserDefaultAttrProp startup_time_prop;
+        startup_time_prop.set_unit("s");
+        startup_time->set_default_properties(startup_time_prop);
+        startup_time->set_disp_level(Tango::EXPERT);
+        att_list.push_back(startup_time);
+
+        // add clock_offset attribute
+        auto* clock_offset = new clock_offsetAttrib();
+        Tango::UserDefaultAttrProp clock_offset_prop;
+        clock_offset_prop.set_unit("s");
+        clock_offset_prop.set_description("Host minus controller time of the status sample timestamps.");
+        clock_offset->set_default_properties(clock_offset_prop);
+        clock_offset->set_disp_level(Tango::EXPERT);
+        att_list.push_back(clock_offset);
+
+        // add clock_drift attribute
+        auto* clock_drift = new clock_driftAttrib();
+        Tango::UserDefaultAttrProp clock_drift_prop;
+        clock_drift_prop.set_unit("ppm");
+        clock_drift_prop.set_description("Rate difference of the host and the controller clock.");
+        clock_drift->set_default_properties(clock_drift_prop);
+        clock_drift->set_disp_level(Tango::EXPERT);
+        att_list.push_back(clock_drift);
+
         // add is_running attribute
         auto* is_running = new is_runningAttrib();
         Tango::UserDefaultAttrProp is_running_prop;
@@ -194,6 +396,98 @@ namespace Controller_ns
         is_running->set_disp_level(Tango::OPERATOR);
         att_list.push_back(is_running);
 
+        // add task_status attribute
+        auto* task_status = new task_statusAttrib();
+        Tango::UserDefaultAttrProp task_status_prop;
+        task_status_prop.set_description("State, error code and program line of every controller task.");
+        task_status->set_default_properties(task_status_prop);
+        task_status->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(task_status);
+
+        // add servo_loop_utilization attribute
+        auto* servo_loop_utilization = new servo_loop_utilizationAttrib();
+        Tango::UserDefaultAttrProp servo_loop_utilization_prop;
+        servo_loop_utilization_prop.set_unit("%");
+        servo_loop_utilization_prop.set_description("Percent of the servo loop period used by the controller.");
+        servo_loop_utilization->set_default_properties(servo_loop_utilization_prop);
+        servo_loop_utilization->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(servo_loop_utilization);
+
+        // add cpu_utilization attribute
+        auto* cpu_utilization = new cpu_utilizationAttrib();
+        Tango::UserDefaultAttrProp cpu_utilization_prop;
+        cpu_utilization_prop.set_unit("%");
+        cpu_utilization_prop.set_description("CPU utilization of the controller.");
+        cpu_utilization->set_default_properties(cpu_utilization_prop);
+        cpu_utilization->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(cpu_utilization);
+
+        // add data_collection_usage attribute
+        auto* data_collection_usage = new data_collection_usageAttrib();
+        Tango::UserDefaultAttrProp data_collection_usage_prop;
+        data_collection_usage_prop.set_unit("%");
+        data_collection_usage_prop.set_description("Percent of the controller data collection buffer in use.");
+        data_collection_usage->set_default_properties(data_collection_usage_prop);
+        data_collection_usage->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(data_collection_usage);
+
+        // add controller_response_time attribute
+        auto* controller_response_time = new controller_response_timeAttrib();
+        Tango::UserDefaultAttrProp controller_response_time_prop;
+        controller_response_time_prop.set_unit("ms");
+        controller_response_time_prop.set_description("Duration of the last telemetry status query.");
+        controller_response_time->set_default_properties(controller_response_time_prop);
+        controller_response_time->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(controller_response_time);
+
+        // add task_queue_depth attribute
+        auto* task_queue_depth = new task_queue_depthAttrib();
+        Tango::UserDefaultAttrProp task_queue_depth_prop;
+        task_queue_depth_prop.set_description("Commands queued in the command queue of every task (1 to n - 1).");
+        task_queue_depth->set_default_properties(task_queue_depth_prop);
+        task_queue_depth->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(task_queue_depth);
+
+        // add task_queue_capacity attribute
+        auto* task_queue_capacity = new task_queue_capacityAttrib();
+        Tango::UserDefaultAttrProp task_queue_capacity_prop;
+        task_queue_capacity_prop.set_description("Command queue capacity of every task (1 to n - 1).");
+        task_queue_capacity->set_default_properties(task_queue_capacity_prop);
+        task_queue_capacity->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(task_queue_capacity);
+
+        // add global_reals attribute
+        auto* global_reals = new global_realsAttrib();
+        Tango::UserDefaultAttrProp global_reals_prop;
+        global_reals_prop.set_description("Controller global reals of global_real_range.");
+        global_reals->set_default_properties(global_reals_prop);
+        global_reals->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(global_reals);
+
+        // add global_integers attribute
+        auto* global_integers = new global_integersAttrib();
+        Tango::UserDefaultAttrProp global_integers_prop;
+        global_integers_prop.set_description("Controller global integers of global_integer_range.");
+        global_integers->set_default_properties(global_integers_prop);
+        global_integers->set_disp_level(Tango::OPERATOR);
+        att_list.push_back(global_integers);
+
+        // add tracing attribute
+        auto* tracing = new tracingAttrib();
+        Tango::UserDefaultAttrProp tracing_prop;
+        tracing_prop.set_description("Record trace events of command and controller call paths.");
+        tracing->set_default_properties(tracing_prop);
+        tracing->set_disp_level(Tango::EXPERT);
+        att_list.push_back(tracing);
+
+        // add trace_dropped attribute
+        auto* trace_dropped = new trace_droppedAttrib();
+        Tango::UserDefaultAttrProp trace_dropped_prop;
+        trace_dropped_prop.set_description("Trace events dropped because a thread buffer was full.");
+        trace_dropped->set_default_properties(trace_dropped_prop);
+        trace_dropped->set_disp_level(Tango::EXPERT);
+        att_list.push_back(trace_dropped);
+
 
         create_static_attribute_list(get_class_attr()->get_attr_list());
     }
@@ -202,8 +496,180 @@ namespace Controller_ns
     {
     }
 
+    CORBA::Any* ExecuteBatchCommand::execute(Tango::DeviceImpl* dev, const CORBA::Any& any)
+    {
+        TANGO_LOG_DEBUG << "ExecuteBatchCommand::execute(): arrived" << std::endl;
+        const Tango::DevVarStringArray* arg_in;
+        extract(any, arg_in);
+
+        return insert(dynamic_cast<Controller*>(dev)->execute_batch(arg_in));
+    }
+
+    CORBA::Any* ProgramCompileCommand::execute(Tango::DeviceImpl* dev, const CORBA::Any& any)
+    {
+        TANGO_LOG_DEBUG << "ProgramCompileCommand::execute(): arrived" << std::endl;
+        Tango::DevString arg_in;
+        extract(any, arg_in);
+
+        return insert(dynamic_cast<Controller*>(dev)->program_compile(arg_in));
+    }
+
+    CORBA::Any* ProgramLoadCommand::execute(Tango::DeviceImpl* dev, const CORBA::Any& any)
+    {
+        TANGO_LOG_DEBUG << "ProgramLoadCommand::execute(): arrived" << std::endl;
+        const Tango::DevVarLongStringArray* arg_in;
+        extract(any, arg_in);
+
+        dynamic_cast<Controller*>(dev)->program_load(arg_in);
+        return new CORBA::Any();
+    }
+
+    CORBA::Any* ProgramRunCommand::execute(Tango::DeviceImpl* dev, const CORBA::Any& any)
+    {
+        TANGO_LOG_DEBUG << "ProgramRunCommand::execute(): arrived" << std::endl;
+        const Tango::DevVarLongStringArray* arg_in;
+        extract(any, arg_in);
+
+        dynamic_cast<Controller*>(dev)->program_run(arg_in);
+        return new CORBA::Any();
+    }
+
+    CORBA::Any* ProgramStartCommand::execute(Tango::DeviceImpl* dev, const CORBA::Any& any)
+    {
+        TANGO_LOG_DEBUG << "ProgramStartCommand::execute(): arrived" << std::endl;
+        Tango::DevLong arg_in;
+        extract(any, arg_in);
+
+        dynamic_cast<Controller*>(dev)->program_start(arg_in);
+        return new CORBA::Any();
+    }
+
+    CORBA::Any* ProgramStopCommand::execute(Tango::DeviceImpl* dev, const CORBA::Any& any)
+    {
+        TANGO_LOG_DEBUG << "ProgramStopCommand::execute(): arrived" << std::endl;
+        Tango::DevLong arg_in;
+        extract(any, arg_in);
+
+        dynamic_cast<Controller*>(dev)->program_stop(arg_in);
+        return new CORBA::Any();
+    }
+
+    CORBA::Any* WatchAddCommand::execute(Tango::DeviceImpl* dev, const CORBA::Any& any)
+    {
+        TANGO_LOG_DEBUG << "WatchAddCommand::execute(): arrived" << std::endl;
+        const Tango::DevVarStringArray* arg_in;
+        extract(any, arg_in);
+
+        dynamic_cast<Controller*>(dev)->watch_add(arg_in);
+        return new CORBA::Any();
+    }
+
+    CORBA::Any* WatchRemoveCommand::execute(Tango::DeviceImpl* dev, const CORBA::Any& any)
+    {
+        TANGO_LOG_DEBUG << "WatchRemoveCommand::execute(): arrived" << std::endl;
+        Tango::DevString arg_in;
+        extract(any, arg_in);
+
+        dynamic_cast<Controller*>(dev)->watch_remove(arg_in);
+        return new CORBA::Any();
+    }
+
+    CORBA::Any* WatchListCommand::execute(Tango::DeviceImpl* dev, TANGO_UNUSED(const CORBA::Any &any))
+    {
+        TANGO_LOG_DEBUG << "WatchListCommand::execute(): arrived" << std::endl;
+        return insert(dynamic_cast<Controller*>(dev)->watch_list());
+    }
+
+    CORBA::Any* TraceExportCommand::execute(Tango::DeviceImpl* dev, const CORBA::Any& any)
+    {
+        TANGO_LOG_DEBUG << "TraceExportCommand::execute(): arrived" << std::endl;
+        Tango::DevString arg_in;
+        extract(any, arg_in);
+
+        return insert(dynamic_cast<Controller*>(dev)->trace_export(arg_in));
+    }
+
     void ControllerClass::command_factory()
     {
+        auto* pExecuteBatchCmd =
+            new ExecuteBatchCommand("executeBatch",
+                                    Tango::DEVVAR_STRINGARRAY, Tango::DEVVAR_STRINGARRAY,
+                                    "Operations, e.g. [\"fault_ack X\", \"enable X\", \"move X 10 5\"]",
+                                    "Status per operation: OK, SKIPPED or ERROR: <reason>",
+                                    Tango::OPERATOR);
+        command_list.push_back(pExecuteBatchCmd);
+
+        auto* pProgramCompileCmd =
+            new ProgramCompileCommand("programCompile",
+                                      Tango::DEV_STRING, Tango::DEV_STRING,
+                                      "AeroScript source",
+                                      "Cache key of the compiled program",
+                                      Tango::OPERATOR);
+        command_list.push_back(pProgramCompileCmd);
+
+        auto* pProgramLoadCmd =
+            new ProgramLoadCommand("programLoad",
+                                   Tango::DEVVAR_LONGSTRINGARRAY, Tango::DEV_VOID,
+                                   "[task], [AeroScript source]",
+                                   "",
+                                   Tango::OPERATOR);
+        command_list.push_back(pProgramLoadCmd);
+
+        auto* pProgramRunCmd =
+            new ProgramRunCommand("programRun",
+                                  Tango::DEVVAR_LONGSTRINGARRAY, Tango::DEV_VOID,
+                                  "[task], [AeroScript source]",
+                                  "",
+                                  Tango::OPERATOR);
+        command_list.push_back(pProgramRunCmd);
+
+        auto* pProgramStartCmd =
+            new ProgramStartCommand("programStart",
+                                    Tango::DEV_LONG, Tango::DEV_VOID,
+                                    "Task",
+                                    "",
+                                    Tango::OPERATOR);
+        command_list.push_back(pProgramStartCmd);
+
+        auto* pProgramStopCmd =
+            new ProgramStopCommand("programStop",
+                                   Tango::DEV_LONG, Tango::DEV_VOID,
+                                   "Task",
+                                   "",
+                                   Tango::OPERATOR);
+        command_list.push_back(pProgramStopCmd);
+
+        auto* pWatchAddCmd =
+            new WatchAddCommand("watchAdd",
+                                Tango::DEVVAR_STRINGARRAY, Tango::DEV_VOID,
+                                "[name, expression], e.g. [any_limit, X.cw_limit or X.ccw_limit]",
+                                "",
+                                Tango::OPERATOR);
+        command_list.push_back(pWatchAddCmd);
+
+        auto* pWatchRemoveCmd =
+            new WatchRemoveCommand("watchRemove",
+                                   Tango::DEV_STRING, Tango::DEV_VOID,
+                                   "Watch name",
+                                   "",
+                                   Tango::OPERATOR);
+        command_list.push_back(pWatchRemoveCmd);
+
+        auto* pWatchListCmd =
+            new WatchListCommand("watchList",
+                                 Tango::DEV_VOID, Tango::DEVVAR_STRINGARRAY,
+                                 "",
+                                 "name: expression per watch",
+                                 Tango::OPERATOR);
+        command_list.push_back(pWatchListCmd);
+
+        auto* pTraceExportCmd =
+            new TraceExportCommand("traceExport",
+                                   Tango::DEV_STRING, Tango::DEV_LONG,
+                                   "File name of the Chrome trace JSON file in trace_export_dir",
+                                   "Number of exported events",
+                                   Tango::EXPERT);
+        command_list.push_back(pTraceExportCmd);
     }
 
     void ControllerClass::create_static_attribute_list(std::vector<Tango::Attr*>& att_list)
@@ -0,0 +1,48 @@
+/*
+ * Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "DeviceInit.h"
+#include <tango/tango.h>
+
+
+namespace Controller_ns
+{
+    std::vector<std::string> init_devices(const std::size_t count, const std::function<void(std::size_t)>& task)
+    {
+        std::vector<std::string> errors(count);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            try
+            {
+                task(i);
+            }
+            catch (Tango::DevFailed& e)
+            {
+                errors[i] = e.errors.length() > 0 ? std::string(e.errors[0].desc) : "Unknown Tango error";
+            }
+            catch (std::exception& e)
+            {
+                errors[i] = e.what();
+            }
+            catch (...)
+            {
+                errors[i] = "Unknown error";
+            }
+        }
+        return errors;
+    }
+}
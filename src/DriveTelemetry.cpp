@@ -0,0 +1,228 @@
+/*
+* Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "DriveTelemetry.h"
+#include "Trace.h"
+#include <ranges>
+
+
+namespace Controller_ns
+{
+    const std::map<std::string, Automation1AxisStatusItem>& telemetry_items()
+    {
+        static const std::map<std::string, Automation1AxisStatusItem> items = {
+            {"CurrentCommand", Automation1AxisStatusItem_CurrentCommand},
+            {"CurrentFeedback", Automation1AxisStatusItem_CurrentFeedback},
+            {"AmplifierTemperature", Automation1AxisStatusItem_AmplifierTemperature},
+            {"BusVoltage", Automation1AxisStatusItem_BusVoltage},
+            {"PositionError", Automation1AxisStatusItem_PositionError}
+        };
+        return items;
+    }
+
+    namespace
+    {
+        // System status items of ControllerLoad, read last in every query, after the axis and task items.
+        constexpr Automation1SystemStatusItem load_items[] = {
+            Automation1SystemStatusItem_ServoLoopUtilization,
+            Automation1SystemStatusItem_CpuUtilization,
+            Automation1SystemStatusItem_DataCollectionBufferUsage
+        };
+
+        // Task status items of ControllerLoad per task, read after the axis items.
+        constexpr Automation1TaskStatusItem task_items[] = {
+            Automation1TaskStatusItem_QueueLineCount,
+            Automation1TaskStatusItem_QueueLineCapacity
+        };
+    }
+
+    DriveTelemetry::DriveTelemetry(Automation1Controller& controller, std::mutex& controller_mutex) :
+        controller(controller), controller_mutex(controller_mutex)
+    {
+    }
+
+    DriveTelemetry::~DriveTelemetry()
+    {
+        stop();
+    }
+
+    void DriveTelemetry::start(const double rate, const int task_count)
+    {
+        std::lock_guard lk(mutex);
+        if (running || rate <= 0)
+            return;
+        period = std::chrono::duration<double>(1. / rate);
+        this->task_count = task_count;
+        config_dirty = true;
+        running = true;
+        thread = std::thread(&DriveTelemetry::run, this);
+    }
+
+    void DriveTelemetry::stop()
+    {
+        {
+            std::lock_guard lk(mutex);
+            running = false;
+        }
+        cv.notify_all();
+        if (thread.joinable())
+            thread.join();
+        if (config != nullptr)
+            Automation1_StatusConfig_Destroy(config);
+        config = nullptr;
+        config_keys.clear();
+    }
+
+    void DriveTelemetry::add(const int axisID, const Automation1AxisStatusItem item)
+    {
+        {
+            std::lock_guard lk(mutex);
+            if (channels[{axisID, item}].references++ == 0)
+                config_dirty = true;
+        }
+        cv.notify_all();
+    }
+
+    void DriveTelemetry::remove(const int axisID, const Automation1AxisStatusItem item)
+    {
+        std::lock_guard lk(mutex);
+        const auto it = channels.find({axisID, item});
+        if (it == channels.end())
+            return;
+        if (--it->second.references <= 0)
+        {
+            channels.erase(it);
+            config_dirty = true;
+        }
+    }
+
+    std::optional<TelemetryValue> DriveTelemetry::value(const int axisID, const Automation1AxisStatusItem item)
+    {
+        std::lock_guard lk(mutex);
+        const auto it = channels.find({axisID, item});
+        if (it == channels.end())
+            return std::nullopt;
+        return it->second.latest;
+    }
+
+    ControllerLoad DriveTelemetry::load()
+    {
+        std::lock_guard lk(mutex);
+        return controller_load;
+    }
+
+    std::string DriveTelemetry::last_error()
+    {
+        std::lock_guard lk(mutex);
+        return error;
+    }
+
+    void DriveTelemetry::run()
+    {
+        std::vector<double> results;
+        auto next = SampleClock::now();
+
+        std::unique_lock lk(mutex);
+        while (running)
+        {
+            if (config_dirty)
+            {
+                rebuild_config();
+                config_dirty = false;
+            }
+            if (SampleClock::now() < next)
+            {
+                cv.wait_until(lk, next);
+                continue;
+            }
+
+            // Only this thread changes the configuration, so it stays valid while the lock is released.
+            const auto tasks = static_cast<std::size_t>(std::max(task_count - 1, 0));
+            results.assign(config_keys.size() + tasks * std::size(task_items) + std::size(load_items), 0.);
+            lk.unlock();
+
+            bool ok = false;
+            SampleClock::time_point before;
+            SampleClock::time_point after;
+            std::string query_error;
+            {
+                std::lock_guard controller_lk(controller_mutex);
+                before = SampleClock::now();
+                if (controller != nullptr)
+                {
+                    TRACE_SCOPE(trace_calls, "Automation1_Status_GetResults", "items", results.size());
+                    ok = Automation1_Status_GetResults(controller, config, results.data(),
+                                                       static_cast<int>(results.size()));
+                }
+                after = SampleClock::now();
+                if (!ok)
+                {
+                    char msg[100];
+                    Automation1_GetLastErrorMessage(msg, 100);
+                    query_error = msg;
+                }
+            }
+
+            lk.lock();
+            const auto timestamp = before + (after - before) / 2;
+            next = timestamp + std::chrono::duration_cast<SampleClock::duration>(period);
+            error = query_error;
+            if (!ok)
+                continue;
+            const auto first_task = config_keys.size();
+            const auto first_load = first_task + tasks * std::size(task_items);
+            controller_load.servo_loop_utilization = results[first_load];
+            controller_load.cpu_utilization = results[first_load + 1];
+            controller_load.data_collection_usage = results[first_load + 2];
+            controller_load.queue_depth.resize(tasks);
+            controller_load.queue_capacity.resize(tasks);
+            for (std::size_t i = 0; i < tasks; i++)
+            {
+                controller_load.queue_depth[i] = results[first_task + i * std::size(task_items)];
+                controller_load.queue_capacity[i] = results[first_task + i * std::size(task_items) + 1];
+            }
+            controller_load.query_time = std::chrono::duration<double>(after - before).count();
+            controller_load.timestamp = timestamp;
+            controller_load.valid = true;
+            for (std::size_t i = 0; i < config_keys.size(); i++)
+                if (const auto it = channels.find(config_keys[i]); it != channels.end())
+                    it->second.latest = TelemetryValue{results[i], timestamp};
+        }
+    }
+
+    void DriveTelemetry::rebuild_config()
+    {
+        if (config != nullptr)
+            Automation1_StatusConfig_Destroy(config);
+        config = nullptr;
+        config_keys.clear();
+
+        // The results come back grouped by category, axis items first and system items last (see Sampler), so the
+        // items are added in that order.
+        Automation1_StatusConfig_Create(&config);
+        for (const auto& key : channels | std::views::keys)
+        {
+            Automation1_StatusConfig_AddAxisStatusItem(config, key.first, key.second, 0);
+            config_keys.push_back(key);
+        }
+        for (int task = 1; task < task_count; task++)
+            for (const auto item : task_items)
+                Automation1_StatusConfig_AddTaskStatusItem(config, task, item, 0);
+        for (const auto item : load_items)
+            Automation1_StatusConfig_AddSystemStatusItem(config, item, 0);
+    }
+}
@@ -0,0 +1,123 @@
+/*
+* Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "EventPusher.h"
+#include <iterator>
+#include <ranges>
+
+
+namespace Controller_ns
+{
+    EventPusher::EventPusher(Tango::DeviceImpl& device) : device(device)
+    {
+        thread = std::thread(&EventPusher::run, this);
+    }
+
+    EventPusher::~EventPusher()
+    {
+        stop();
+    }
+
+    void EventPusher::post(const std::string& attribute, std::function<void()> push)
+    {
+        queue(attribute, std::move(push), false);
+    }
+
+    void EventPusher::append(const std::string& attribute, std::function<void()> push)
+    {
+        queue(attribute, std::move(push), true);
+    }
+
+    void EventPusher::queue(const std::string& attribute, std::function<void()> push, const bool keep_all)
+    {
+        {
+            std::lock_guard lk(mutex);
+            if (stopping)
+                return;
+            auto& entry = pending[attribute];
+            if (!keep_all)
+                entry.pushes.clear();
+            entry.pushes.push_back(std::move(push));
+            entry.keep_all = keep_all;
+        }
+        cv.notify_one();
+    }
+
+    void EventPusher::stop()
+    {
+        {
+            std::lock_guard lk(mutex);
+            stopping = true;
+            pending.clear();
+        }
+        cv.notify_one();
+        if (thread.joinable())
+            thread.join();
+    }
+
+    void EventPusher::run()
+    {
+        // The Tango monitor identifies its owner by the omni thread.
+        omni_thread::ensure_self self;
+        std::unique_lock lk(mutex);
+        while (true)
+        {
+            cv.wait(lk, [this] { return stopping || !pending.empty(); });
+            if (stopping)
+                return;
+            auto batch = std::move(pending);
+            pending.clear();
+            lk.unlock();
+            try
+            {
+                Tango::AutoTangoMonitor monitor(&device);
+                // stop() is called with the monitor held, so it cannot run while the batch is pushed.
+                if (!stopping)
+                {
+                    for (const auto& entry : batch | std::views::values)
+                    {
+                        for (const auto& push : entry.pushes)
+                        {
+                            try
+                            {
+                                push();
+                            }
+                            catch (const Tango::DevFailed&)
+                            {
+                                // e.g. the attribute was removed meanwhile
+                            }
+                        }
+                    }
+                }
+                batch.clear();
+            }
+            catch (const Tango::DevFailed&)
+            {
+                // The monitor was not available within its timeout, the batch is retried. Newer posted pushes of the
+                // same attributes replace it, appended ones are queued after it.
+            }
+            lk.lock();
+            for (auto& [attribute, entry] : batch)
+            {
+                const auto [it, inserted] = pending.try_emplace(attribute, std::move(entry));
+                if (!inserted && it->second.keep_all)
+                    it->second.pushes.insert(it->second.pushes.begin(), std::make_move_iterator(entry.pushes.begin()),
+                                             std::make_move_iterator(entry.pushes.end()));
+            }
+        }
+    }
+}
@@ -0,0 +1,163 @@
+/*
+* Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "FlightRecorder.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <format>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <tango/tango.h>
+#include "Sampler.h"
+
+
+namespace Controller_ns
+{
+    FlightRecorder::~FlightRecorder()
+    {
+        if (auto* mapped = header.exchange(nullptr))
+            munmap(mapped, mapped_size);
+    }
+
+    void FlightRecorder::open(const std::filesystem::path& path, const std::size_t count)
+    {
+        std::lock_guard lk(open_mutex);
+        if (header.load() != nullptr)
+            return;
+
+        const auto size = sizeof(FlightRecordHeader) + std::max<std::size_t>(count, 1) * sizeof(FlightRecord);
+        // Never follows a link planted in place of the journal.
+        const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_NOFOLLOW | O_CLOEXEC, 0600);
+        if (fd < 0)
+            Tango::Except::throw_exception("FlightRecorderError",
+                                           std::format("Cannot open {}: {}", path.string(), std::strerror(errno)),
+                                           "FlightRecorder::open()");
+        struct stat file_stat{};
+        const bool same_size = fstat(fd, &file_stat) == 0 && static_cast<std::size_t>(file_stat.st_size) == size;
+        if (!same_size && (ftruncate(fd, 0) != 0 || ftruncate(fd, static_cast<off_t>(size)) != 0))
+        {
+            const auto error = std::strerror(errno);
+            ::close(fd);
+            Tango::Except::throw_exception("FlightRecorderError",
+                                           std::format("Cannot resize {}: {}", path.string(), error),
+                                           "FlightRecorder::open()");
+        }
+        void* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED)
+            Tango::Except::throw_exception("FlightRecorderError",
+                                           std::format("Cannot map {}: {}", path.string(), std::strerror(errno)),
+                                           "FlightRecorder::open()");
+
+        auto* mapped_header = static_cast<FlightRecordHeader*>(mapped);
+        const auto record_count = (size - sizeof(FlightRecordHeader)) / sizeof(FlightRecord);
+        if (mapped_header->magic != flight_record_magic || mapped_header->version != flight_record_version ||
+            mapped_header->record_size != sizeof(FlightRecord) || mapped_header->capacity != record_count)
+        {
+            std::memset(mapped, 0, size);
+            mapped_header->magic = flight_record_magic;
+            mapped_header->version = flight_record_version;
+            mapped_header->record_size = sizeof(FlightRecord);
+            mapped_header->capacity = record_count;
+        }
+        records = reinterpret_cast<FlightRecord*>(mapped_header + 1);
+        capacity = record_count;
+        mapped_size = size;
+        header.store(mapped_header, std::memory_order_release);
+        write(FlightRecordType::Start, 0, -1, {});
+    }
+
+    std::filesystem::path FlightRecorder::default_path(const std::string& device_name)
+    {
+        const auto directory = std::filesystem::temp_directory_path() / std::format("automation1-{}", geteuid());
+        if (mkdir(directory.c_str(), 0700) != 0 && errno != EEXIST)
+            Tango::Except::throw_exception("FlightRecorderError",
+                                           std::format("Cannot create {}: {}", directory.string(),
+                                                       std::strerror(errno)),
+                                           "FlightRecorder::default_path()");
+        struct stat directory_stat{};
+        if (lstat(directory.c_str(), &directory_stat) != 0 || !S_ISDIR(directory_stat.st_mode) ||
+            directory_stat.st_uid != geteuid() || (directory_stat.st_mode & (S_IWGRP | S_IWOTH)) != 0)
+            Tango::Except::throw_exception("FlightRecorderError",
+                                           std::format("{} is not a private directory of the server user",
+                                                       directory.string()),
+                                           "FlightRecorder::default_path()");
+
+        std::string name = device_name;
+        std::ranges::replace_if(name, [](const char c)
+        {
+            return !std::isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '_' && c != '.';
+        }, '_');
+        return directory / (name + ".journal");
+    }
+
+    void FlightRecorder::command(const FlightCommand command, const int axisID,
+                                 const std::initializer_list<double> arguments, const bool ok)
+    {
+        const auto nan = std::nan("");
+        const auto* argument = arguments.begin();
+        const auto next = [&] { return argument != arguments.end() ? *argument++ : nan; };
+        const double first = next();
+        const double second = next();
+        const double third = next();
+        write(FlightRecordType::Command, static_cast<std::uint16_t>(command), axisID,
+              {first, second, third, ok ? 1. : 0.});
+    }
+
+    void FlightRecorder::fault_change(const int axisID, const double previous_fault, const AxisSnapshot& snapshot)
+    {
+        write(FlightRecordType::FaultChange, 0, axisID,
+              {previous_fault, snapshot.axis_fault, snapshot.axis_status, snapshot.drive_status,
+               snapshot.position_feedback});
+    }
+
+    void FlightRecorder::snapshot(const int axisID, const AxisSnapshot& snapshot)
+    {
+        write(FlightRecordType::Snapshot, 0, axisID,
+              {snapshot.axis_status, snapshot.drive_status, snapshot.axis_fault, snapshot.position_feedback,
+               snapshot.velocity_feedback});
+    }
+
+    void FlightRecorder::write(const FlightRecordType type, const std::uint16_t code, const int axisID,
+                               const std::initializer_list<double> values)
+    {
+        auto* mapped_header = header.load(std::memory_order_acquire);
+        if (mapped_header == nullptr)
+            return;
+        const auto sequence = std::atomic_ref(mapped_header->head).fetch_add(1, std::memory_order_relaxed) + 1;
+        auto& record = records[(sequence - 1) % capacity];
+        std::atomic_ref record_sequence(record.sequence);
+        record_sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        record.time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        record.type = type;
+        record.code = code;
+        record.axisID = axisID;
+        std::ranges::fill(record.values, 0.);
+        std::ranges::copy(values.begin(), values.begin() + std::min(values.size(), std::size(record.values)),
+                          record.values);
+        record_sequence.store(sequence, std::memory_order_release);
+    }
+}
@@ -0,0 +1,114 @@
+/*
+* Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "GlobalVariables.h"
+#include "Trace.h"
+#include <tango/tango.h>
+
+
+namespace Controller_ns
+{
+    namespace
+    {
+        bool get(const Automation1Controller controller, const int first, double* values, const int count)
+        {
+            TRACE_SCOPE(trace_calls, "Automation1_Variables_GetGlobalReals", "count", count);
+            return Automation1_Variables_GetGlobalReals(controller, first, values, count);
+        }
+
+        bool get(const Automation1Controller controller, const int first, std::int64_t* values, const int count)
+        {
+            TRACE_SCOPE(trace_calls, "Automation1_Variables_GetGlobalIntegers", "count", count);
+            return Automation1_Variables_GetGlobalIntegers(controller, first, values, count);
+        }
+
+        bool set(const Automation1Controller controller, const int first, const double* values, const int count)
+        {
+            TRACE_SCOPE(trace_calls, "Automation1_Variables_SetGlobalReals", "count", count);
+            return Automation1_Variables_SetGlobalReals(controller, first, values, count);
+        }
+
+        bool set(const Automation1Controller controller, const int first, const std::int64_t* values, const int count)
+        {
+            TRACE_SCOPE(trace_calls, "Automation1_Variables_SetGlobalIntegers", "count", count);
+            return Automation1_Variables_SetGlobalIntegers(controller, first, values, count);
+        }
+
+        void throw_last_error(const char* origin)
+        {
+            char msg[100];
+            Automation1_GetLastErrorMessage(msg, 100);
+            Tango::Except::throw_exception("VariableError", msg, origin);
+        }
+    }
+
+    template <typename T>
+    void GlobalVariableRange<T>::configure(const int first, const int count)
+    {
+        std::lock_guard lk(mutex);
+        this->first = std::max(first, 0);
+        this->count = std::max(count, 0);
+        last.clear();
+        valid = false;
+    }
+
+    template <typename T>
+    void GlobalVariableRange<T>::read(std::vector<T>& values)
+    {
+        std::lock_guard lk(mutex);
+        values.resize(count);
+        if (count == 0)
+            return;
+        std::lock_guard controller_lk(controller_mutex);
+        if (!get(controller, first, values.data(), count))
+            throw_last_error("GlobalVariableRange::read()");
+    }
+
+    template <typename T>
+    bool GlobalVariableRange<T>::poll(std::vector<T>& values)
+    {
+        std::lock_guard lk(mutex);
+        values.resize(count);
+        if (count == 0)
+            return false;
+        {
+            std::lock_guard controller_lk(controller_mutex);
+            if (!get(controller, first, values.data(), count))
+                throw_last_error("GlobalVariableRange::poll()");
+        }
+        const bool changed = !valid || values != last;
+        last = values;
+        valid = true;
+        return changed;
+    }
+
+    template <typename T>
+    void GlobalVariableRange<T>::write(const T* values, const int length)
+    {
+        std::lock_guard lk(mutex);
+        if (length > count)
+            Tango::Except::throw_exception("InvalidArgument",
+                                           std::format("{} values given, the range has {}", length, count),
+                                           "GlobalVariableRange::write()");
+        std::lock_guard controller_lk(controller_mutex);
+        if (!set(controller, first, values, length))
+            throw_last_error("GlobalVariableRange::write()");
+    }
+
+    template class GlobalVariableRange<double>;
+    template class GlobalVariableRange<std::int64_t>;
+}
@@ -0,0 +1,404 @@
+/*
+* Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "IO.h"
+#include "IOClass.h"
+#include "ControllerClass.h"
+#include "Trace.h"
+#include <Automation1.h>
+#include <cmath>
+#include <sstream>
+
+
+namespace IO_ns
+{
+    namespace
+    {
+        Tango::TimeVal to_timeval(const Controller_ns::SampleClock::time_point time)
+        {
+            const auto us = std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+            Tango::TimeVal tv{};
+            tv.tv_sec = static_cast<decltype(tv.tv_sec)>(us / 1000000);
+            tv.tv_usec = static_cast<decltype(tv.tv_usec)>(us % 1000000);
+            return tv;
+        }
+    }
+
+    IO::IO(Tango::DeviceClass* cl, const std::string& s) : TANGO_BASE_CLASS(cl, s.c_str())
+    {
+        IO::init_device();
+    }
+
+    IO::IO(Tango::DeviceClass* cl, const char* s) : TANGO_BASE_CLASS(cl, s)
+    {
+        IO::init_device();
+    }
+
+    IO::IO(Tango::DeviceClass* cl, const char* s, const char* d) : TANGO_BASE_CLASS(cl, s, d)
+    {
+        IO::init_device();
+    }
+
+    IO::~IO()
+    {
+        IO::delete_device();
+    }
+
+    void IO::delete_device()
+    {
+        DEBUG_STREAM << "IO::delete_device() " << device_name << std::endl;
+        if (subscription)
+            Controller_ns::ControllerClass::instance()->io.unsubscribe(*subscription);
+        subscription.reset();
+        events.reset();
+        for (const auto& io : mappings)
+        {
+            try
+            {
+                remove_attribute(io.name, false, false);
+            }
+            catch (const Tango::DevFailed&)
+            {
+                // not added, e.g. init_hardware() failed
+            }
+        }
+    }
+
+    void IO::init_device()
+    {
+        DEBUG_STREAM << "IO::init_device() create device " << device_name << std::endl;
+        get_device_property();
+        events = std::make_unique<Controller_ns::EventPusher>(*this);
+
+        if (!dynamic_cast<IOClass*>(get_device_class())->deferred_init)
+        {
+            init_hardware();
+            add_dynamic_attributes();
+            start_scan();
+        }
+    }
+
+    void IO::init_hardware()
+    {
+        init_error.clear();
+        parse_mappings();
+        if (Controller_ns::ControllerClass::instance()->controller == nullptr)
+            Tango::Except::throw_exception("Controller not connected", "The controller is not connected",
+                                           "init_hardware()");
+
+        std::map<std::string, int> axisIDs;
+        for (auto& io : mappings)
+        {
+            if (!axisIDs.contains(io.axisName))
+            {
+                int axisID;
+                std::lock_guard lk(Controller_ns::ControllerClass::instance()->mutex);
+                if (!Automation1_Controller_GetAxisIndexFromAxisName(
+                    Controller_ns::ControllerClass::instance()->controller, io.axisName.c_str(), &axisID))
+                {
+                    char msg[100];
+                    Automation1_GetLastErrorMessage(msg, 100);
+                    Tango::Except::throw_exception("AxisNotFound", std::format("Axis {}: {}", io.axisName, msg),
+                                                   "init_hardware()");
+                }
+                axisIDs[io.axisName] = axisID;
+            }
+            io.channel.axisID = axisIDs[io.axisName];
+        }
+    }
+
+    void IO::start_scan()
+    {
+        if (!init_error.empty())
+            return;
+        std::vector<Controller_ns::IoChannel> channels;
+        for (const auto& io : mappings)
+            channels.push_back(io.channel);
+        pushed.clear();
+        subscription = Controller_ns::ControllerClass::instance()->io.subscribe(
+            channels, [this](const Controller_ns::IoSample& sample) { push_changes(sample); });
+    }
+
+    void IO::set_init_error(const std::string& error)
+    {
+        init_error = error;
+        ERROR_STREAM << "IO::init_hardware() " << device_name << ": " << error << std::endl;
+    }
+
+    void IO::get_device_property()
+    {
+        Tango::DbData dev_prop;
+        dev_prop.emplace_back("inputs");
+        dev_prop.emplace_back("outputs");
+
+        if (!dev_prop.empty())
+        {
+            if (Tango::Util::_UseDb)
+                get_db_device()->get_property(dev_prop);
+
+            const auto ds_class =
+                (dynamic_cast<IOClass*>(get_device_class()));
+            int i = -1;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty())
+                cl_prop >> inputs;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty())
+                    def_prop >> inputs;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> inputs;
+
+            if (Tango::DbDatum cl_prop = ds_class->get_class_property(dev_prop[++i].name); !cl_prop.is_empty())
+                cl_prop >> outputs;
+            else
+            {
+                if (Tango::DbDatum def_prop = ds_class->get_default_device_property(dev_prop[i].name); !def_prop.
+                    is_empty())
+                    def_prop >> outputs;
+            }
+            if (!dev_prop[i].is_empty()) dev_prop[i] >> outputs;
+        }
+    }
+
+    void IO::parse_mappings()
+    {
+        mappings.clear();
+        for (const bool output : {false, true})
+        {
+            for (const auto& entry : output ? outputs : inputs)
+            {
+                std::vector<std::string> fields;
+                std::istringstream stream(entry);
+                for (std::string field; std::getline(stream, field, ':');)
+                    fields.push_back(field);
+
+                IoMapping io;
+                bool valid = fields.size() == 4 && !fields[0].empty() && (fields[2] == "digital" || fields[2] ==
+                    "analog");
+                if (valid)
+                {
+                    io.name = fields[0];
+                    io.axisName = fields[1];
+                    const bool digital = fields[2] == "digital";
+                    io.channel.kind = digital
+                                          ? (output
+                                                 ? Controller_ns::IoChannel::DigitalOutput
+                                                 : Controller_ns::IoChannel::DigitalInput)
+                                          : (output
+                                                 ? Controller_ns::IoChannel::AnalogOutput
+                                                 : Controller_ns::IoChannel::AnalogInput);
+                    try
+                    {
+                        io.channel.index = std::stoi(fields[3]);
+                    }
+                    catch (const std::exception&)
+                    {
+                        valid = false;
+                    }
+                    valid = valid && io.channel.index >= 0 && (!digital || io.channel.index < 64);
+                }
+                if (!valid)
+                    Tango::Except::throw_exception("InvalidProperty",
+                                                   std::format("Invalid I/O '{}', expected "
+                                                               "name:axis:digital|analog:index", entry),
+                                                   "IO::parse_mappings()");
+                if (std::ranges::find(mappings, io.name, &IoMapping::name) != mappings.end())
+                    Tango::Except::throw_exception("InvalidProperty", std::format("Duplicate I/O name {}", io.name),
+                                                   "IO::parse_mappings()");
+                mappings.push_back(io);
+            }
+        }
+    }
+
+    IoMapping& IO::mapping(const std::string& name)
+    {
+        const auto io = std::ranges::find(mappings, name, &IoMapping::name);
+        if (io == mappings.end())
+            Tango::Except::throw_exception("UnknownIO", std::format("No I/O named {}", name), "IO::mapping()");
+        return *io;
+    }
+
+    void IO::always_executed_hook()
+    {
+    }
+
+    void IO::read_attr_hardware(TANGO_UNUSED(std::vector<long>& attr_list))
+    {
+        if (subscription)
+            sample = Controller_ns::ControllerClass::instance()->io.read(*subscription);
+    }
+
+    void IO::add_dynamic_attributes()
+    {
+        for (const auto& io : mappings)
+        {
+            auto* attribute = new ioAttrib(io.name, io.channel.is_digital() ? Tango::DEV_BOOLEAN : Tango::DEV_DOUBLE,
+                                           io.channel.is_output() ? Tango::READ_WRITE : Tango::READ);
+            Tango::UserDefaultAttrProp attribute_prop;
+            attribute_prop.set_description(std::format("{} {} {} of axis {}",
+                                                        io.channel.is_digital() ? "Digital" : "Analog",
+                                                        io.channel.is_output() ? "output" : "input",
+                                                        io.channel.index, io.axisName).c_str());
+            attribute->set_default_properties(attribute_prop);
+            attribute->set_disp_level(Tango::OPERATOR);
+            add_attribute(attribute);
+            // Digital changes are edges and always pushed, analog ones are filtered by the change event properties.
+            set_change_event(io.name, true, !io.channel.is_digital());
+        }
+    }
+
+    void IO::add_dynamic_commands()
+    {
+    }
+
+    void IO::read_io(Tango::Attribute& attribute)
+    {
+        auto& io = mapping(attribute.get_name());
+        const auto index = static_cast<std::size_t>(&io - mappings.data());
+        if (!sample.valid || index >= sample.values.size())
+        {
+            const auto error = Controller_ns::ControllerClass::instance()->io.last_error();
+            Tango::Except::throw_exception("NoSample", error.empty() ? "No I/O sample available" : error,
+                                           "IO::read_io()");
+        }
+        const auto tv = to_timeval(sample.timestamp);
+        if (io.channel.is_digital())
+        {
+            io.digital = sample.values[index] != 0;
+            attribute.set_value_date_quality(&io.digital, tv, Tango::ATTR_VALID);
+        }
+        else
+        {
+            io.analog = sample.values[index];
+            attribute.set_value_date_quality(&io.analog, tv, Tango::ATTR_VALID);
+        }
+    }
+
+    void IO::write_io(Tango::WAttribute& attribute)
+    {
+        const auto& io = mapping(attribute.get_name());
+        double value;
+        if (io.channel.is_digital())
+        {
+            Tango::DevBoolean digital;
+            attribute.get_write_value(digital);
+            value = digital ? 1. : 0.;
+        }
+        else
+            attribute.get_write_value(value);
+        write_outputs({{&io, value}});
+    }
+
+    bool IO::is_io_allowed(const Tango::AttReqType type)
+    {
+        return type == Tango::READ_REQ || init_error.empty();
+    }
+
+    void IO::set_outputs(const Tango::DevVarDoubleStringArray* arg_in)
+    {
+        TRACE_SCOPE(Controller_ns::trace_calls, "IO::set_outputs", "outputs", arg_in->svalue.length());
+        if (arg_in->svalue.length() != arg_in->dvalue.length())
+            Tango::Except::throw_exception("InvalidArgument", "Expected one value per output name",
+                                           "IO::set_outputs()");
+        std::vector<std::pair<const IoMapping*, double>> values;
+        for (unsigned int i = 0; i < arg_in->svalue.length(); i++)
+        {
+            const auto& io = mapping(arg_in->svalue[i].in());
+            if (!io.channel.is_output())
+                Tango::Except::throw_exception("InvalidArgument", std::format("{} is not an output", io.name),
+                                               "IO::set_outputs()");
+            values.emplace_back(&io, arg_in->dvalue[i]);
+        }
+        write_outputs(values);
+    }
+
+    bool IO::is_set_outputs_allowed(TANGO_UNUSED(const CORBA::Any& any))
+    {
+        return init_error.empty();
+    }
+
+    void IO::write_outputs(const std::vector<std::pair<const IoMapping*, double>>& outputs)
+    {
+        const auto controller = Controller_ns::ControllerClass::instance()->controller;
+        std::lock_guard lk(Controller_ns::ControllerClass::instance()->mutex);
+        for (const auto& [io, value] : outputs)
+        {
+            TRACE_SCOPE(Controller_ns::trace_calls, "IO::write_output", "axis", io->channel.axisID);
+            const bool ok = io->channel.is_digital()
+                                ? Automation1_Command_DigitalOutputSet(controller, 1, io->channel.axisID,
+                                                                       io->channel.index, value != 0 ? 1 : 0)
+                                : Automation1_Command_AnalogOutputSet(controller, 1, io->channel.axisID,
+                                                                      io->channel.index, value);
+            if (!ok)
+            {
+                char msg[100];
+                Automation1_GetLastErrorMessage(msg, 100);
+                Tango::Except::throw_exception("CommandFailed", std::format("{}: {}", io->name, msg),
+                                               "IO::write_outputs()");
+            }
+        }
+    }
+
+    void IO::push_changes(const Controller_ns::IoSample& sample)
+    {
+        if (pushed.size() != sample.values.size())
+            pushed.assign(sample.values.size(), NAN);
+        const auto tv = to_timeval(sample.timestamp);
+        for (std::size_t i = 0; i < sample.values.size() && i < mappings.size(); i++)
+        {
+            if (sample.values[i] == pushed[i])
+                continue;
+            const auto& name = mappings[i].name;
+            if (mappings[i].channel.is_digital())
+            {
+                events->append(name, [this, name, tv, value = Tango::DevBoolean(sample.values[i] != 0)]() mutable
+                {
+                    push_change_event(name, &value, tv, Tango::ATTR_VALID);
+                });
+            }
+            else
+            {
+                events->post(name, [this, name, tv, value = Tango::DevDouble(sample.values[i])]() mutable
+                {
+                    push_change_event(name, &value, tv, Tango::ATTR_VALID);
+                });
+            }
+            pushed[i] = sample.values[i];
+        }
+    }
+
+    Tango::DevState IO::dev_state()
+    {
+        if (!init_error.empty())
+            return Tango::DevState::FAULT;
+        if (!Controller_ns::ControllerClass::instance()->io.last_error().empty())
+            return Tango::DevState::ALARM;
+        return Tango::DevState::STANDBY;
+    }
+
+    const char* IO::dev_status()
+    {
+        if (!init_error.empty())
+            return init_error.c_str();
+        status = Controller_ns::ControllerClass::instance()->io.last_error();
+        if (status.empty())
+            status = "standby";
+        return status.c_str();
+    }
+}
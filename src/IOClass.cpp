@@ -0,0 +1,262 @@
+/*
+* Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "IOClass.h"
+#include "ControllerClass.h"
+#include "DeviceInit.h"
+
+extern "C" {
+Tango::DeviceClass* _create_IO_class(const char* name)
+{
+    return IO_ns::IOClass::init(name);
+}
+}
+
+namespace IO_ns
+{
+    IOClass* IOClass::_instance = nullptr;
+
+    IOClass::IOClass(const std::string& s) : Tango::DeviceClass(s)
+    {
+        TANGO_LOG_INFO << "Entering IOClass constructor" << std::endl;
+        set_default_property();
+        write_class_property();
+        TANGO_LOG_INFO << "Leaving IOClass constructor" << std::endl;
+    }
+
+    IOClass::~IOClass()
+    {
+        _instance = nullptr;
+    }
+
+    IOClass* IOClass::init(const char* name)
+    {
+        if (_instance == nullptr)
+        {
+            try
+            {
+                const std::string s(name);
+                _instance = new IOClass(s);
+            }
+            catch (std::bad_alloc&)
+            {
+                throw;
+            }
+        }
+        return _instance;
+    }
+
+
+    IOClass* IOClass::instance()
+    {
+        if (_instance == nullptr)
+        {
+            std::cerr << "Class is not initialised !!" << std::endl;
+            exit(-1);
+        }
+        return _instance;
+    }
+
+
+    Tango::DbDatum IOClass::get_class_property(std::string& prop_name)
+    {
+        for (auto& i : cl_prop)
+            if (i.name == prop_name)
+                return i;
+        //	if not found, returns  an empty DbDatum
+        return {prop_name};
+    }
+
+
+    Tango::DbDatum IOClass::get_default_device_property(std::string& prop_name)
+    {
+        for (auto& i : dev_def_prop)
+            if (i.name == prop_name)
+                return i;
+        return {prop_name};
+    }
+
+
+    Tango::DbDatum IOClass::get_default_class_property(std::string& prop_name)
+    {
+        for (auto& i : cl_def_prop)
+            if (i.name == prop_name)
+                return i;
+        return {prop_name};
+    }
+
+    void IOClass::set_default_property()
+    {
+        std::string prop_name;
+        std::string prop_desc;
+        std::string prop_def;
+        std::vector<std::string> vect_data;
+    }
+
+    void IOClass::write_class_property()
+    {
+        if (!Tango::Util::_UseDb)
+            return;
+
+        Tango::DbData data;
+        std::string classname = get_name();
+        std::string header;
+
+        Tango::DbDatum title("ProjectTitle");
+        std::string str_title;
+        title << str_title;
+        data.push_back(title);
+
+        Tango::DbDatum description("Description");
+        std::vector<std::string> str_desc;
+        str_desc.emplace_back("");
+        description << str_desc;
+        data.push_back(description);
+
+
+        Tango::DbDatum inher_datum("InheritedFrom");
+        std::vector<std::string> inheritance;
+        inheritance.emplace_back("TANGO_BASE_CLASS");
+        inher_datum << inheritance;
+        data.push_back(inher_datum);
+
+
+        get_db_class()->put_property(data);
+    }
+
+
+    void IOClass::device_factory(const Tango::DevVarStringArray* devlist_ptr)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<IO*> devices;
+        deferred_init = true;
+        for (unsigned long i = 0; i < devlist_ptr->length(); i++)
+        {
+            TANGO_LOG_DEBUG << "Device name : " << (*devlist_ptr)[i].in() << std::endl;
+            devices.push_back(new IO(this, (*devlist_ptr)[i]));
+            device_list.push_back(devices.back());
+        }
+        deferred_init = false;
+
+        const auto errors = Controller_ns::init_devices(devices.size(), [&](const std::size_t i)
+        {
+            devices[i]->init_hardware();
+        });
+        for (std::size_t i = 0; i < devices.size(); i++)
+            if (!errors[i].empty())
+                devices[i]->set_init_error(errors[i]);
+
+        erase_dynamic_attributes(devlist_ptr, get_class_attr()->get_attr_list());
+        for (unsigned long i = 1; i <= devlist_ptr->length(); i++)
+        {
+            const auto dev = dynamic_cast<IO*>(device_list[device_list.size() - i]);
+            dev->add_dynamic_attributes();
+            dev->start_scan();
+            if (Tango::Util::_UseDb && !Tango::Util::_FileDb)
+                export_device(dev);
+            else
+                export_device(dev, dev->get_name().c_str());
+        }
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        Controller_ns::ControllerClass::instance()->startup_time += elapsed.count();
+        TANGO_LOG_INFO << devices.size() << " IO devices initialised in " << elapsed.count()
+                       << " s" << std::endl;
+    }
+
+    void IOClass::attribute_factory(TANGO_UNUSED(std::vector<Tango::Attr*>& att_list))
+    {
+        // The I/O attributes are dynamic, see IO::add_dynamic_attributes().
+        create_static_attribute_list(get_class_attr()->get_attr_list());
+    }
+
+    void IOClass::pipe_factory()
+    {
+    }
+
+    CORBA::Any* SetOutputsCommand::execute(Tango::DeviceImpl* dev, const CORBA::Any& any)
+    {
+        TANGO_LOG_DEBUG << "SetOutputsCommand::execute(): arrived" << std::endl;
+        const Tango::DevVarDoubleStringArray* arg_in;
+        extract(any, arg_in);
+
+        dynamic_cast<IO*>(dev)->set_outputs(arg_in);
+        return new CORBA::Any();
+    }
+
+    void IOClass::command_factory()
+    {
+        auto* pSetOutputsCmd =
+            new SetOutputsCommand("set_outputs",
+                                  Tango::DEVVAR_DOUBLESTRINGARRAY, Tango::DEV_VOID,
+                                  "[values], [output names]",
+                                  "",
+                                  Tango::OPERATOR);
+        command_list.push_back(pSetOutputsCmd);
+    }
+
+    void IOClass::create_static_attribute_list(std::vector<Tango::Attr*>& att_list)
+    {
+        for (const auto& i : att_list)
+        {
+            std::string att_name(i->get_name());
+            std::ranges::transform(att_name, att_name.begin(), ::tolower);
+            defaultAttList.push_back(att_name);
+        }
+
+        TANGO_LOG_INFO << defaultAttList.size() << " attributes in default list" << std::endl;
+    }
+
+    void IOClass::erase_dynamic_attributes(const Tango::DevVarStringArray* devlist_ptr,
+                                           const std::vector<Tango::Attr*>& att_list)
+    {
+        Tango::Util* tg = Tango::Util::instance();
+
+        for (unsigned long i = 0; i < devlist_ptr->length(); i++)
+        {
+            Tango::DeviceImpl* dev_impl = tg->get_device_by_name(static_cast<std::string>((*devlist_ptr)[i]).c_str());
+            const auto dev = dynamic_cast<IO*>(dev_impl);
+
+            std::vector<Tango::Attribute*>& dev_att_list = dev->get_device_attr()->get_attribute_list();
+            std::vector<Tango::Attribute*>::iterator ite_att;
+            for (ite_att = dev_att_list.begin(); ite_att != dev_att_list.end(); ++ite_att)
+            {
+                std::string att_name((*ite_att)->get_name_lower());
+                if ((att_name == "state") || (att_name == "status"))
+                    continue;
+                if (auto ite_str = std::ranges::find(defaultAttList, att_name); ite_str == defaultAttList.end())
+                {
+                    TANGO_LOG_INFO << att_name << " is a UNWANTED dynamic attribute for device " << (*devlist_ptr)[i]
+                                   << std::endl;
+                    Tango::Attribute& att = dev->get_device_attr()->get_attr_by_name(att_name.c_str());
+                    dev->remove_attribute(att_list[att.get_attr_idx()], true, false);
+                    --ite_att;
+                }
+            }
+        }
+    }
+
+    Tango::Attr* IOClass::get_attr_object_by_name(std::vector<Tango::Attr*>& att_list,
+                                                  const std::string& attname)
+    {
+        for (auto it = att_list.begin(); it < att_list.end(); ++it)
+            if ((*it)->get_name() == attname)
+                return (*it);
+        //	Attr does not exist
+        return nullptr;
+    }
+} //	namespace
@@ -0,0 +1,232 @@
+/*
+* Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "IoScanner.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cstdint>
+#include <ranges>
+#include <set>
+
+
+namespace Controller_ns
+{
+    IoScanner::IoScanner(Automation1Controller& controller, std::mutex& controller_mutex) :
+        controller(controller), controller_mutex(controller_mutex)
+    {
+    }
+
+    IoScanner::~IoScanner()
+    {
+        stop();
+    }
+
+    void IoScanner::start(const double rate)
+    {
+        std::lock_guard lk(mutex);
+        if (running)
+            return;
+        period = std::chrono::duration<double>(1. / std::max(rate, 0.1));
+        config_dirty = true;
+        running = true;
+        thread = std::thread(&IoScanner::run, this);
+    }
+
+    void IoScanner::stop()
+    {
+        {
+            std::lock_guard lk(mutex);
+            running = false;
+        }
+        cv.notify_all();
+        if (thread.joinable())
+            thread.join();
+        if (config != nullptr)
+            Automation1_StatusConfig_Destroy(config);
+        config = nullptr;
+        config_items.clear();
+    }
+
+    int IoScanner::subscribe(const std::vector<IoChannel>& channels, Callback on_change)
+    {
+        int id;
+        {
+            std::lock_guard callback_lk(callback_mutex);
+            std::lock_guard lk(mutex);
+            id = next_id++;
+            subscriptions.emplace(id, Subscription{channels, std::move(on_change)});
+            config_dirty = true;
+        }
+        cv.notify_all();
+        return id;
+    }
+
+    void IoScanner::unsubscribe(const int id)
+    {
+        std::lock_guard callback_lk(callback_mutex);
+        std::lock_guard lk(mutex);
+        if (subscriptions.erase(id) > 0)
+            config_dirty = true;
+    }
+
+    IoSample IoScanner::read(const int id)
+    {
+        std::lock_guard lk(mutex);
+        const auto it = subscriptions.find(id);
+        if (it == subscriptions.end())
+            return {};
+        return it->second.sample;
+    }
+
+    std::string IoScanner::last_error()
+    {
+        std::lock_guard lk(mutex);
+        return error;
+    }
+
+    IoScanner::Item IoScanner::item_of(const IoChannel& channel)
+    {
+        switch (channel.kind)
+        {
+        case IoChannel::DigitalInput:
+            return {channel.axisID, Automation1AxisStatusItem_DigitalInputs, 0};
+        case IoChannel::DigitalOutput:
+            return {channel.axisID, Automation1AxisStatusItem_DigitalOutputs, 0};
+        case IoChannel::AnalogInput:
+            return {channel.axisID, Automation1AxisStatusItem_AnalogInput, channel.index};
+        case IoChannel::AnalogOutput:
+        default:
+            return {channel.axisID, Automation1AxisStatusItem_AnalogOutput, channel.index};
+        }
+    }
+
+    void IoScanner::run()
+    {
+        std::vector<double> results;
+        std::vector<double> values;
+        std::vector<int> changed;
+        auto next = SampleClock::now();
+
+        std::unique_lock lk(mutex);
+        while (running)
+        {
+            if (config_dirty)
+            {
+                rebuild_config();
+                config_dirty = false;
+            }
+            if (config_items.empty())
+            {
+                cv.wait(lk);
+                continue;
+            }
+            if (SampleClock::now() < next)
+            {
+                cv.wait_until(lk, next);
+                continue;
+            }
+
+            // Only this thread changes the configuration, so it stays valid while the lock is released.
+            results.assign(config_items.size(), 0.);
+            lk.unlock();
+
+            bool ok = false;
+            SampleClock::time_point before;
+            SampleClock::time_point after;
+            std::string query_error;
+            {
+                std::lock_guard controller_lk(controller_mutex);
+                before = SampleClock::now();
+                if (controller != nullptr)
+                {
+                    TRACE_SCOPE(trace_calls, "Automation1_Status_GetResults", "items", results.size());
+                    ok = Automation1_Status_GetResults(controller, config, results.data(),
+                                                       static_cast<int>(results.size()));
+                }
+                after = SampleClock::now();
+                if (!ok)
+                {
+                    char msg[100];
+                    Automation1_GetLastErrorMessage(msg, 100);
+                    query_error = msg;
+                }
+            }
+
+            // Same lock order as subscribe() and unsubscribe().
+            std::unique_lock callback_lk(callback_mutex);
+            lk.lock();
+            const auto timestamp = before + (after - before) / 2;
+            next = timestamp + std::chrono::duration_cast<SampleClock::duration>(period);
+            error = query_error;
+            if (!ok || config_dirty)
+                continue;
+
+            changed.clear();
+            for (auto& [id, subscription] : subscriptions)
+            {
+                values.clear();
+                for (const auto& channel : subscription.channels)
+                {
+                    const auto item = std::ranges::lower_bound(config_items, item_of(channel));
+                    const double raw = results[static_cast<std::size_t>(item - config_items.begin())];
+                    values.push_back(channel.is_digital()
+                                         ? static_cast<double>((static_cast<std::uint64_t>(raw) >> channel.index) & 1)
+                                         : raw);
+                }
+                auto& sample = subscription.sample;
+                if (!sample.valid || values != sample.values)
+                    changed.push_back(id);
+                sample.values = values;
+                sample.timestamp = timestamp;
+                sample.valid = true;
+            }
+            lk.unlock();
+
+            // The subscriptions can not change while the callback lock is held.
+            for (const auto id : changed)
+            {
+                const auto& subscription = subscriptions.at(id);
+                if (subscription.on_change)
+                    subscription.on_change(subscription.sample);
+            }
+            callback_lk.unlock();
+            lk.lock();
+        }
+    }
+
+    void IoScanner::rebuild_config()
+    {
+        if (config != nullptr)
+            Automation1_StatusConfig_Destroy(config);
+        config = nullptr;
+        config_items.clear();
+
+        std::set<Item> items;
+        for (const auto& subscription : subscriptions | std::views::values)
+            for (const auto& channel : subscription.channels)
+                items.insert(item_of(channel));
+        if (items.empty())
+            return;
+
+        Automation1_StatusConfig_Create(&config);
+        for (const auto& item : items)
+        {
+            Automation1_StatusConfig_AddAxisStatusItem(config, item.axisID, item.item, item.argument);
+            config_items.push_back(item);
+        }
+    }
+}
@@ -19,10 +19,12 @@
 #include "ControllerClass.h"
 #include "AxisClass.h"
 #include "BissEncoderClass.h"
+#include "IOClass.h"
 
 void Tango::DServer::class_factory()
 {
     add_class(Controller_ns::ControllerClass::init("Controller"));
     add_class(Axis_ns::AxisClass::init("Axis"));
     add_class(BissEncoder_ns::BissEncoderClass::init("BissEncoder"));
+    add_class(IO_ns::IOClass::init("IO"));
 }
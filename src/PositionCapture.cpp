@@ -0,0 +1,242 @@
+/*
+* Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "PositionCapture.h"
+#include <tango/tango.h>
+#include <algorithm>
+
+
+namespace Axis_ns
+{
+    // Interval in which the drive array is drained while the capture is armed.
+    constexpr auto drain_period = std::chrono::milliseconds(50);
+
+    // Capture channel of the drive used for the position capture.
+    constexpr int captureIndex = 0;
+
+    PositionCapture::PositionCapture(Automation1Controller& controller, std::mutex& controller_mutex) :
+        controller(controller), controller_mutex(controller_mutex)
+    {
+    }
+
+    PositionCapture::~PositionCapture()
+    {
+        disarm();
+    }
+
+    void PositionCapture::check(const bool response, const char* origin) const
+    {
+        if (!response)
+        {
+            char msg[100];
+            Automation1_GetLastErrorMessage(msg, 100);
+            Tango::Except::throw_exception("CaptureError", msg, origin);
+        }
+    }
+
+    void PositionCapture::capture_on()
+    {
+        check(Automation1_Command_DriveDataCaptureConfigureArray(controller, 1, axisID, captureIndex,
+                                                                  settings.array_address, settings.array_size),
+              "PositionCapture::capture_on()");
+        check(Automation1_Command_DriveDataCaptureOn(controller, 1, axisID, captureIndex),
+              "PositionCapture::capture_on()");
+        drained = 0;
+    }
+
+    void PositionCapture::capture_off()
+    {
+        check(Automation1_Command_DriveDataCaptureOff(controller, 1, axisID, captureIndex),
+              "PositionCapture::capture_off()");
+    }
+
+    void PositionCapture::arm(const int axisID, const CaptureSettings& settings)
+    {
+        if (armed)
+            Tango::Except::throw_exception("Busy", "The capture is armed", "PositionCapture::arm()");
+        if (settings.array_size <= 0)
+            Tango::Except::throw_exception("InvalidArgument", "The capture array size must be positive",
+                                           "PositionCapture::arm()");
+        if (thread.joinable())
+            thread.join();
+
+        this->axisID = axisID;
+        this->settings = settings;
+        {
+            std::lock_guard lk(mutex);
+            last_error.clear();
+        }
+        capture.positions.clear();
+        capture.indices.clear();
+        capture.generation++;
+        publish();
+        restart_count = 0;
+        dropped_count = 0;
+        index_offset = 0;
+
+        {
+            std::lock_guard lk(controller_mutex);
+            check(Automation1_Parameter_GetAxisValue(controller, axisID, Automation1AxisParameterId_CountsPerUnit,
+                                                     &countsPerUnit), "PositionCapture::arm()");
+            if (status_config == nullptr)
+            {
+                Automation1_StatusConfig_Create(&status_config);
+                Automation1_StatusConfig_AddAxisStatusItem(status_config, axisID,
+                                                           Automation1AxisStatusItem_DriveDataCaptureSamples,
+                                                           captureIndex);
+            }
+            check(Automation1_Command_DriveDataCaptureConfigureInput(
+                      controller, 1, axisID, captureIndex,
+                      static_cast<Automation1DriveDataCaptureInput>(settings.input)), "PositionCapture::arm()");
+            check(Automation1_Command_DriveDataCaptureConfigureTrigger(
+                      controller, 1, axisID, captureIndex,
+                      static_cast<Automation1DriveDataCaptureTrigger>(settings.trigger)), "PositionCapture::arm()");
+            capture_on();
+        }
+        armed = true;
+        thread = std::thread(&PositionCapture::run, this);
+    }
+
+    void PositionCapture::disarm()
+    {
+        {
+            std::lock_guard lk(mutex);
+            armed = false;
+        }
+        cv.notify_all();
+        if (thread.joinable())
+            thread.join();
+        if (status_config != nullptr)
+        {
+            Automation1_StatusConfig_Destroy(status_config);
+            status_config = nullptr;
+        }
+    }
+
+    bool PositionCapture::is_armed() const
+    {
+        return armed;
+    }
+
+    void PositionCapture::acquire()
+    {
+        published.acquire();
+    }
+
+    CaptureData& PositionCapture::data()
+    {
+        return published.front();
+    }
+
+    long PositionCapture::count() const
+    {
+        return captured;
+    }
+
+    void PositionCapture::publish()
+    {
+        auto& back = published.back();
+        if (back.generation != capture.generation)
+        {
+            back.positions.clear();
+            back.indices.clear();
+            back.generation = capture.generation;
+        }
+        back.positions.insert(back.positions.end(), capture.positions.begin() + back.positions.size(),
+                              capture.positions.end());
+        back.indices.insert(back.indices.end(), capture.indices.begin() + back.indices.size(),
+                            capture.indices.end());
+        published.publish();
+        captured = static_cast<long>(capture.positions.size());
+    }
+
+    long PositionCapture::restarts() const
+    {
+        return restart_count;
+    }
+
+    long PositionCapture::dropped() const
+    {
+        return dropped_count;
+    }
+
+    std::string PositionCapture::error()
+    {
+        std::lock_guard lk(mutex);
+        return last_error;
+    }
+
+    void PositionCapture::drain()
+    {
+        double samples;
+        check(Automation1_Status_GetResults(controller, status_config, &samples, 1), "PositionCapture::drain()");
+        const int available = std::min(static_cast<int>(samples), settings.array_size);
+        if (available > drained)
+        {
+            std::vector<double> values(available - drained);
+            check(Automation1_Command_DriveArrayRead(controller, axisID, values.data(),
+                                                     settings.array_address + drained,
+                                                     static_cast<int>(values.size())), "PositionCapture::drain()");
+            for (std::size_t i = 0; i < values.size(); i++)
+            {
+                if (capture.positions.size() >= settings.max_points)
+                {
+                    dropped_count++;
+                    continue;
+                }
+                capture.positions.push_back(values[i] / countsPerUnit);
+                capture.indices.push_back(index_offset + drained + static_cast<long long>(i));
+            }
+            drained = available;
+            publish();
+        }
+
+        // The drive array is full: restart the capture at the start of the array.
+        if (drained >= settings.array_size)
+        {
+            capture_off();
+            index_offset += drained;
+            capture_on();
+            restart_count++;
+        }
+    }
+
+    void PositionCapture::run()
+    {
+        std::unique_lock lk(mutex);
+        while (true)
+        {
+            const bool stop = cv.wait_for(lk, drain_period, [this] { return !armed; });
+            lk.unlock();
+            try
+            {
+                std::lock_guard controller_lk(controller_mutex);
+                drain();
+                if (stop)
+                    capture_off();
+            }
+            catch (Tango::DevFailed& e)
+            {
+                std::lock_guard error_lk(mutex);
+                last_error = std::string(e.errors[0].desc);
+            }
+            lk.lock();
+            if (stop)
+                break;
+        }
+    }
+}
@@ -0,0 +1,104 @@
+/*
+* Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "PositionHistory.h"
+#include <algorithm>
+
+
+namespace Controller_ns
+{
+    PositionHistory::PositionHistory(const std::size_t capacity) : samples(std::max<std::size_t>(capacity, 1))
+    {
+    }
+
+    const PositionHistory::Sample& PositionHistory::at(const std::size_t i) const
+    {
+        return samples[(head + i) % samples.size()];
+    }
+
+    void PositionHistory::push(const Clock::time_point time, const double position)
+    {
+        const Sample sample{std::chrono::duration<double>(time.time_since_epoch()).count(), position};
+        if (count < samples.size())
+        {
+            samples[(head + count) % samples.size()] = sample;
+            count++;
+        }
+        else
+        {
+            samples[head] = sample;
+            head = (head + 1) % samples.size();
+        }
+    }
+
+    void PositionHistory::read(const double window, const std::size_t max_points, std::vector<double>& times,
+                               std::vector<double>& positions) const
+    {
+        times.clear();
+        positions.clear();
+        if (count == 0 || max_points == 0)
+            return;
+
+        // Samples are ordered by time, so the start of the window is found by a binary search.
+        const double start_time = at(count - 1).time - window;
+        std::size_t lo = 0, hi = count;
+        while (lo < hi)
+        {
+            const auto mid = (lo + hi) / 2;
+            if (at(mid).time < start_time)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        const std::size_t first = lo;
+        const std::size_t n = count - first;
+
+        auto append = [&](const Sample& sample)
+        {
+            times.push_back(sample.time);
+            positions.push_back(sample.position);
+        };
+
+        if (n <= max_points)
+        {
+            for (std::size_t i = first; i < count; i++)
+                append(at(i));
+            return;
+        }
+
+        // Each bucket contributes its minimum and maximum in the order they occurred.
+        const std::size_t buckets = std::max<std::size_t>(max_points / 2, 1);
+        for (std::size_t b = 0; b < buckets; b++)
+        {
+            const std::size_t begin = first + n * b / buckets;
+            const std::size_t end = first + n * (b + 1) / buckets;
+            if (begin == end)
+                continue;
+            std::size_t min_index = begin, max_index = begin;
+            for (std::size_t i = begin + 1; i < end; i++)
+            {
+                if (at(i).position < at(min_index).position)
+                    min_index = i;
+                if (at(i).position > at(max_index).position)
+                    max_index = i;
+            }
+            append(at(std::min(min_index, max_index)));
+            if (min_index != max_index && max_points > 1)
+                append(at(std::max(min_index, max_index)));
+        }
+    }
+}
@@ -0,0 +1,104 @@
+/*
+* Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "ProgramCache.h"
+#include <Automation1Compiler.h>
+#include <tango/tango.h>
+#include <cstdint>
+#include <format>
+#include <fstream>
+
+
+namespace Controller_ns
+{
+    namespace
+    {
+        // Directory on the controller file system the compiled programs are copied to.
+        constexpr auto controller_directory = "tango";
+
+        std::string last_error()
+        {
+            char msg[100];
+            Automation1_GetLastErrorMessage(msg, 100);
+            return msg;
+        }
+    }
+
+    void ProgramCache::set_directory(const std::filesystem::path& path)
+    {
+        std::lock_guard lk(mutex);
+        directory = path;
+    }
+
+    std::string ProgramCache::key(const std::string& source)
+    {
+        // 64 bit FNV-1a, stable across builds so the cache survives server restarts.
+        int version[3];
+        Automation1_GetApiVersion(&version[0], &version[1], &version[2]);
+        std::uint64_t hash = 14695981039346656037ull;
+        for (const auto c : std::format("{}.{}.{}\n{}", version[0], version[1], version[2], source))
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return std::format("{:016x}", hash);
+    }
+
+    std::filesystem::path ProgramCache::compile(const std::string& source)
+    {
+        const auto name = key(source);
+        std::lock_guard lk(mutex);
+        const auto compiled = directory / (name + ".a1exe");
+        if (std::filesystem::exists(compiled))
+            return compiled;
+
+        std::error_code ec;
+        std::filesystem::create_directories(directory, ec);
+        const auto source_path = directory / (name + ".ascript");
+        if (std::ofstream file(source_path); !(file << source))
+            Tango::Except::throw_exception("CompileError", std::format("Could not write {}", source_path.string()),
+                                           "ProgramCache::compile()");
+
+        // Compile to a temporary file first, so an interrupted compilation never leaves a broken cache entry.
+        const auto partial = directory / (name + ".a1exe.partial");
+        if (!Automation1_Compiler_Compile(source_path.c_str(), partial.c_str()))
+            Tango::Except::throw_exception("CompileError", last_error(), "ProgramCache::compile()");
+        std::filesystem::rename(partial, compiled, ec);
+        if (ec)
+            Tango::Except::throw_exception("CompileError", ec.message(), "ProgramCache::compile()");
+        return compiled;
+    }
+
+    std::string ProgramCache::upload(const Automation1Controller controller, const std::filesystem::path& compiled)
+    {
+        const auto target = std::format("{}/{}", controller_directory, compiled.filename().string());
+        std::lock_guard lk(mutex);
+        if (!uploaded.contains(target))
+        {
+            if (!Automation1_Files_WriteToController(controller, compiled.c_str(), target.c_str()))
+                Tango::Except::throw_exception("UploadError", last_error(), "ProgramCache::upload()");
+            uploaded.insert(target);
+        }
+        return target;
+    }
+
+    void ProgramCache::reset_uploads()
+    {
+        std::lock_guard lk(mutex);
+        uploaded.clear();
+    }
+}
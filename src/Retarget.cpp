@@ -0,0 +1,177 @@
+/*
+* Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "Retarget.h"
+#include <tango/tango.h>
+#include <algorithm>
+#include <cmath>
+#include <format>
+
+
+namespace Axis_ns
+{
+    // Time allowed for the free run to stop before the final move.
+    constexpr auto stop_timeout = std::chrono::seconds(10);
+
+    Retarget::Retarget(Automation1Controller& controller, std::mutex& controller_mutex,
+                       Controller_ns::Sampler& sampler, Controller_ns::FlightRecorder& recorder,
+                       VelocityStreamer& streamer, const double acceleration, const double rate) :
+        controller(controller), controller_mutex(controller_mutex), sampler(sampler), recorder(recorder),
+        streamer(streamer),
+        acceleration(acceleration), period(1. / std::max(rate, 1.))
+    {
+    }
+
+    Retarget::~Retarget()
+    {
+        abort();
+    }
+
+    void Retarget::move_to(const int axisID, const double target, const double velocity, Finished finished)
+    {
+        if (acceleration <= 0 || velocity <= 0)
+            Tango::Except::throw_exception("InvalidArgument", "Velocity and acceleration must be positive",
+                                           "Retarget::move_to()");
+        std::unique_lock lk(mutex);
+        if (running && !finishing && !aborted)
+        {
+            this->target = target;
+            this->velocity = velocity;
+            return;
+        }
+
+        lk.unlock();
+        if (thread.joinable())
+            thread.join();
+        lk.lock();
+        this->target = target;
+        this->velocity = velocity;
+        aborted = false;
+        finishing = false;
+        status_text = "running";
+        running = true;
+        thread = std::thread(&Retarget::run, this, axisID, std::move(finished));
+    }
+
+    void Retarget::abort()
+    {
+        {
+            std::lock_guard lk(mutex);
+            aborted = true;
+        }
+        cv.notify_all();
+        if (thread.joinable())
+            thread.join();
+    }
+
+    bool Retarget::is_running() const
+    {
+        return running;
+    }
+
+    std::string Retarget::status()
+    {
+        std::lock_guard lk(mutex);
+        return status_text;
+    }
+
+    bool Retarget::wait(const std::chrono::duration<double> duration)
+    {
+        std::unique_lock lk(mutex);
+        return !cv.wait_for(lk, duration, [this] { return aborted; });
+    }
+
+    void Retarget::run(int axisID, const Finished finished)
+    {
+        std::string result;
+        try
+        {
+            // Largest velocity change per streamed setpoint.
+            const double step = acceleration * period;
+            double current = sampler.axis(axisID).velocity_command;
+            double goal, limit;
+            while (true)
+            {
+                {
+                    std::lock_guard lk(mutex);
+                    if (aborted)
+                        break;
+                    goal = target;
+                    limit = velocity;
+                }
+                const double distance = goal - sampler.axis(axisID).position_command;
+                if (std::abs(distance) <= std::max(std::abs(current), step) * period)
+                    break;
+                // Fastest velocity that still allows to stop at the target.
+                const double braking = std::copysign(std::min(limit, std::sqrt(2 * acceleration *
+                                                         std::abs(distance))), distance);
+                current = std::clamp(braking, current - step, current + step);
+                streamer.set(axisID, current);
+                if (!wait(std::chrono::duration<double>(period)))
+                    break;
+            }
+
+            {
+                std::lock_guard lk(mutex);
+                finishing = true;
+            }
+            streamer.stop();
+            sampler.invalidate(axisID);
+
+            // Wait in short slices so an abort is not delayed until the free run has stopped.
+            const auto deadline = std::chrono::steady_clock::now() + stop_timeout;
+            std::optional<Controller_ns::AxisSnapshot> stopped;
+            while (!stopped && wait(std::chrono::duration<double>(0)))
+            {
+                if (std::chrono::steady_clock::now() > deadline)
+                    Tango::Except::throw_exception("Timeout", "The free run did not stop", "Retarget::run()");
+                stopped = sampler.wait_axis(axisID, finished, std::chrono::milliseconds(100));
+            }
+
+            // The abort check and the final move share the lock, so abort() either prevents the move or returns
+            // after it was sent and the abort of the caller stops it.
+            std::lock_guard lk(mutex);
+            if (stopped && !aborted)
+            {
+                goal = target;
+                limit = velocity;
+                std::lock_guard controller_lk(controller_mutex);
+                const bool ok = Automation1_Command_MoveAbsolute(controller, 1, &axisID, 1, &goal, 1, &limit, 1);
+                recorder.command(Controller_ns::FlightCommand::MoveAbsolute, axisID, {goal, limit}, ok);
+                if (!ok)
+                {
+                    char msg[100];
+                    Automation1_GetLastErrorMessage(msg, 100);
+                    Tango::Except::throw_exception("MotionError", msg, "Retarget::run()");
+                }
+                result = std::format("moved to {}", goal);
+            }
+            else
+                result = "aborted";
+        }
+        catch (Tango::DevFailed& e)
+        {
+            streamer.stop();
+            result = "error: " + (e.errors.length() > 0 ? std::string(e.errors[0].desc) : "unknown Tango error");
+        }
+        sampler.invalidate(axisID);
+
+        std::lock_guard lk(mutex);
+        status_text = result;
+        running = false;
+    }
+}
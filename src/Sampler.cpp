@@ -0,0 +1,637 @@
+/*
+* Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "Sampler.h"
+#include "Axis.h"
+#include "Trace.h"
+#include <tango/tango.h>
+#include <ranges>
+
+
+namespace Controller_ns
+{
+    // Maximum time a reader waits for a sample requested by invalidate().
+    constexpr auto sample_timeout = std::chrono::seconds(1);
+
+    // The controller Timer system status item counts milliseconds.
+    constexpr double controller_timer_unit = 1e-3;
+
+    // Number of status configurations (one per combination of due axes) kept between ticks.
+    constexpr std::size_t max_configs = 32;
+
+    Sampler::Sampler(Automation1Controller& controller, std::mutex& controller_mutex, FlightRecorder& recorder) :
+        controller(controller), controller_mutex(controller_mutex), recorder(recorder)
+    {
+    }
+
+    Sampler::~Sampler()
+    {
+        stop();
+    }
+
+    void Sampler::start(const double fast_rate, const double slow_rate, const double journal_seconds)
+    {
+        std::lock_guard lk(mutex);
+        if (running)
+            return;
+        fast_period = std::chrono::duration<double>(1. / std::max(fast_rate, 0.1));
+        slow_period = std::chrono::duration<double>(1. / std::max(std::min(slow_rate, fast_rate), 0.1));
+        journal_period = std::chrono::duration<double>(std::max(journal_seconds, 0.));
+        window_start = SampleClock::now();
+        running = true;
+        thread = std::thread(&Sampler::run, this);
+    }
+
+    void Sampler::stop()
+    {
+        {
+            std::lock_guard lk(mutex);
+            running = false;
+        }
+        cv.notify_all();
+        if (thread.joinable())
+            thread.join();
+        clear_configs();
+    }
+
+    void Sampler::add_axis(const int axisID)
+    {
+        std::lock_guard lk(mutex);
+        auto& entry = axes[axisID];
+        entry.references++;
+        entry.next_due = SampleClock::now();
+        entry.requested = entry.started + 1;
+        table.set_pending(axisID, true);
+        configs_dirty = true;
+        cv.notify_all();
+    }
+
+    void Sampler::remove_axis(const int axisID)
+    {
+        std::lock_guard lk(mutex);
+        if (const auto it = axes.find(axisID); it != axes.end() && --it->second.references <= 0)
+        {
+            axes.erase(it);
+            table.write_begin();
+            table.clear(axisID);
+            table.write_end();
+            configs_dirty = true;
+        }
+    }
+
+    void Sampler::invalidate(const int axisID)
+    {
+        std::lock_guard lk(mutex);
+        if (const auto it = axes.find(axisID); it != axes.end())
+        {
+            it->second.requested = it->second.started + 1;
+            it->second.next_due = SampleClock::now();
+            it->second.active = true;
+            table.set_pending(axisID, true);
+        }
+        cv.notify_all();
+    }
+
+    void Sampler::invalidate_all()
+    {
+        std::lock_guard lk(mutex);
+        const auto now = SampleClock::now();
+        for (auto& [id, entry] : axes)
+        {
+            entry.requested = entry.started + 1;
+            entry.next_due = now;
+            entry.active = true;
+            table.set_pending(id, true);
+        }
+        cv.notify_all();
+    }
+
+    void Sampler::add_encoder(const int axisID, const double rate, const std::size_t window,
+                              const double ema_time_constant)
+    {
+        std::lock_guard lk(mutex);
+        auto& entry = encoders[axisID];
+        entry.window_size = std::max(entry.window_size, window);
+        entry.ema_time_constant = std::max(entry.ema_time_constant, ema_time_constant);
+        if (rate > 0 && (entry.references == 0 || (entry.rate > 0 && rate > entry.rate)))
+            entry.rate = rate;
+        else if (rate <= 0)
+            entry.rate = 0;
+        entry.references++;
+        entry.next_due = SampleClock::now();
+        configs_dirty = true;
+        cv.notify_all();
+    }
+
+    void Sampler::remove_encoder(const int axisID)
+    {
+        std::lock_guard lk(mutex);
+        if (const auto it = encoders.find(axisID); it != encoders.end() && --it->second.references <= 0)
+        {
+            encoders.erase(it);
+            configs_dirty = true;
+        }
+    }
+
+    EncoderSnapshot Sampler::encoder(const int axisID)
+    {
+        std::unique_lock lk(mutex);
+        auto pending = [&]
+        {
+            const auto it = encoders.find(axisID);
+            return running && it != encoders.end() && it->second.attempts == 0;
+        };
+        if (pending())
+            cv.wait_for(lk, sample_timeout, [&] { return !pending(); });
+
+        const auto it = encoders.find(axisID);
+        if (it == encoders.end())
+            Tango::Except::throw_exception("StatusError", std::format("Encoder {} is not sampled", axisID),
+                                           "Sampler::encoder()");
+        if (!it->second.snapshot.valid)
+            Tango::Except::throw_exception("StatusError",
+                                           std::format("No position of encoder {}: {}", axisID, last_error),
+                                           "Sampler::encoder()");
+        return it->second.snapshot;
+    }
+
+    void Sampler::encoder_window(const int axisID, std::vector<EncoderSnapshot>& samples)
+    {
+        std::lock_guard lk(mutex);
+        const auto it = encoders.find(axisID);
+        if (it == encoders.end())
+            Tango::Except::throw_exception("StatusError", std::format("Encoder {} is not sampled", axisID),
+                                           "Sampler::encoder_window()");
+        samples.assign(it->second.window.begin(), it->second.window.end());
+    }
+
+    double Sampler::encoder_ema(const int axisID)
+    {
+        std::lock_guard lk(mutex);
+        const auto it = encoders.find(axisID);
+        if (it == encoders.end())
+            Tango::Except::throw_exception("StatusError", std::format("Encoder {} is not sampled", axisID),
+                                           "Sampler::encoder_ema()");
+        if (!it->second.snapshot.valid)
+            Tango::Except::throw_exception("StatusError",
+                                           std::format("No position of encoder {}: {}", axisID, last_error),
+                                           "Sampler::encoder_ema()");
+        return it->second.ema;
+    }
+
+    AxisSnapshot Sampler::axis(const int axisID)
+    {
+        if (const auto snapshot = table.load(axisID))
+            return *snapshot;
+
+        std::unique_lock lk(mutex);
+        auto pending = [&]
+        {
+            const auto it = axes.find(axisID);
+            return running && it != axes.end() && it->second.attempts < it->second.requested;
+        };
+        if (pending())
+            cv.wait_for(lk, sample_timeout, [&] { return !pending(); });
+
+        const auto it = axes.find(axisID);
+        if (it == axes.end())
+            Tango::Except::throw_exception("StatusError", std::format("Axis {} is not sampled", axisID),
+                                           "Sampler::axis()");
+        if (!it->second.snapshot.valid)
+            Tango::Except::throw_exception("StatusError", std::format("No status of axis {}: {}", axisID, last_error),
+                                           "Sampler::axis()");
+        return it->second.snapshot;
+    }
+
+    std::optional<AxisSnapshot> Sampler::wait_axis(const int axisID,
+                                                   const std::function<bool(const AxisSnapshot&)>& predicate,
+                                                   const std::chrono::duration<double> timeout)
+    {
+        const auto deadline = std::chrono::steady_clock::now() +
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout);
+        std::unique_lock lk(mutex);
+        bool timed_out = false;
+        while (true)
+        {
+            const auto it = axes.find(axisID);
+            if (it == axes.end())
+                Tango::Except::throw_exception("StatusError", std::format("Axis {} is not sampled", axisID),
+                                               "Sampler::wait_axis()");
+            if (const auto& entry = it->second; entry.attempts >= entry.requested && entry.snapshot.valid &&
+                predicate(entry.snapshot))
+                return entry.snapshot;
+            if (!running)
+                Tango::Except::throw_exception("StatusError", "The status sampler is not running",
+                                               "Sampler::wait_axis()");
+            if (timed_out)
+                return std::nullopt;
+            timed_out = cv.wait_until(lk, deadline) == std::cv_status::timeout;
+        }
+    }
+
+    int Sampler::notify_axis(const int axisID, std::function<bool(const AxisSnapshot&)> predicate,
+                             const std::chrono::duration<double> timeout, AxisCallback on_done)
+    {
+        std::lock_guard lk(mutex);
+        if (!axes.contains(axisID))
+            Tango::Except::throw_exception("StatusError", std::format("Axis {} is not sampled", axisID),
+                                           "Sampler::notify_axis()");
+        if (!running)
+            Tango::Except::throw_exception("StatusError", "The status sampler is not running",
+                                           "Sampler::notify_axis()");
+        const auto id = next_notification++;
+        const auto deadline = SampleClock::now() + std::chrono::duration_cast<SampleClock::duration>(timeout);
+        notifications.emplace(id, NotifyEntry{axisID, std::move(predicate), deadline, std::move(on_done)});
+        // Wakes the sampler, so it waits no longer than the deadline.
+        cv.notify_all();
+        return id;
+    }
+
+    void Sampler::cancel_notify(const int id)
+    {
+        std::lock_guard callback_lk(callback_mutex);
+        std::lock_guard lk(mutex);
+        notifications.erase(id);
+    }
+
+    double Sampler::axis_rate(const int axisID)
+    {
+        std::lock_guard lk(mutex);
+        const auto it = axes.find(axisID);
+        return it != axes.end() ? it->second.rate : 0.;
+    }
+
+    double Sampler::calls_per_second()
+    {
+        std::lock_guard lk(mutex);
+        return calls_rate;
+    }
+
+    void Sampler::position_history(const int axisID, const double window, const std::size_t max_points,
+                                   std::vector<double>& times, std::vector<double>& positions)
+    {
+        std::lock_guard lk(mutex);
+        const auto it = axes.find(axisID);
+        if (it == axes.end())
+            Tango::Except::throw_exception("StatusError", std::format("Axis {} is not sampled", axisID),
+                                           "Sampler::position_history()");
+        it->second.history.read(window, max_points, times, positions);
+    }
+
+    std::pair<double, double> Sampler::clock_offset_drift()
+    {
+        std::lock_guard lk(mutex);
+        return {clock.offset(), clock.drift()};
+    }
+
+    int Sampler::add_watch(const WatchExpression& expression, WatchCallback on_change)
+    {
+        for (const auto axisID : expression.axes())
+            add_axis(axisID);
+        std::lock_guard lk(mutex);
+        const auto id = next_watch++;
+        watches.emplace(id, WatchEntry{expression, std::move(on_change)});
+        return id;
+    }
+
+    void Sampler::remove_watch(const int id)
+    {
+        std::vector<int> used;
+        {
+            std::lock_guard callback_lk(callback_mutex);
+            std::lock_guard lk(mutex);
+            const auto it = watches.find(id);
+            if (it == watches.end())
+                return;
+            used = it->second.expression.axes();
+            watches.erase(it);
+        }
+        for (const auto axisID : used)
+            remove_axis(axisID);
+    }
+
+    std::optional<bool> Sampler::watch_state(const int id)
+    {
+        std::lock_guard lk(mutex);
+        const auto it = watches.find(id);
+        if (it == watches.end())
+            return std::nullopt;
+        return it->second.state;
+    }
+
+    void Sampler::evaluate_watches(const std::vector<int>& sampled, const SampleClock::time_point timestamp)
+    {
+        const std::function<const AxisSnapshot*(int)> snapshot = [this](const int axisID) -> const AxisSnapshot*
+        {
+            const auto it = axes.find(axisID);
+            return it == axes.end() ? nullptr : &it->second.snapshot;
+        };
+        for (auto& [id, watch] : watches)
+        {
+            if (std::ranges::none_of(watch.expression.axes(), [&](const int axisID)
+            {
+                return std::ranges::find(sampled, axisID) != sampled.end();
+            }))
+                continue;
+            const bool state = watch.expression.evaluate(snapshot);
+            if (watch.state == state)
+                continue;
+            watch.state = state;
+            changed_watches.emplace_back(id, state, timestamp);
+        }
+    }
+
+    void Sampler::evaluate_notifications(const std::vector<int>& sampled, const SampleClock::time_point now)
+    {
+        for (const auto& [id, notification] : notifications)
+        {
+            const auto it = axes.find(notification.axisID);
+            if (it == axes.end())
+                continue;
+            if (const auto& entry = it->second; std::ranges::find(sampled, notification.axisID) != sampled.end() &&
+                entry.attempts >= entry.requested && entry.snapshot.valid && notification.predicate(entry.snapshot))
+                done_notifications.emplace_back(id, entry.snapshot);
+            else if (now >= notification.deadline)
+                done_notifications.emplace_back(id, std::nullopt);
+        }
+    }
+
+    void Sampler::notify_watches(std::unique_lock<std::mutex>& lk)
+    {
+        if (changed_watches.empty() && done_notifications.empty())
+            return;
+        const auto changed = std::move(changed_watches);
+        changed_watches.clear();
+        const auto done = std::move(done_notifications);
+        done_notifications.clear();
+        lk.unlock();
+        {
+            // Same lock order as remove_watch(). While the callback lock is held no watch can be erased, so the
+            // entries stay valid after the sampler lock is released.
+            std::lock_guard callback_lk(callback_mutex);
+            std::vector<std::tuple<const WatchEntry*, bool, SampleClock::time_point>> calls;
+            std::vector<std::pair<AxisCallback, std::optional<AxisSnapshot>>> notify_calls;
+            lk.lock();
+            for (const auto& [id, state, timestamp] : changed)
+                if (const auto it = watches.find(id); it != watches.end())
+                    calls.emplace_back(&it->second, state, timestamp);
+            // Notifications fire once. One cancelled after the evaluation is not found here and not called.
+            for (const auto& [id, snapshot] : done)
+                if (const auto it = notifications.find(id); it != notifications.end())
+                {
+                    notify_calls.emplace_back(std::move(it->second.on_done), snapshot);
+                    notifications.erase(it);
+                }
+            lk.unlock();
+            for (const auto& [watch, state, timestamp] : calls)
+                if (watch->on_change)
+                    watch->on_change(state, timestamp);
+            for (const auto& [on_done, snapshot] : notify_calls)
+                if (on_done)
+                    on_done(snapshot);
+        }
+        lk.lock();
+    }
+
+    void Sampler::run()
+    {
+        const auto nItems = Axis_ns::axisStates.size();
+        std::vector<double> results;
+        std::vector<int> due;
+        std::vector<int> due_encoders;
+        std::vector<int> key;
+
+        std::unique_lock lk(mutex);
+        while (running)
+        {
+            if (configs_dirty)
+            {
+                clear_configs();
+                configs_dirty = false;
+            }
+
+            const auto now = SampleClock::now();
+            auto next = now + std::chrono::duration_cast<SampleClock::duration>(slow_period);
+            due.clear();
+            for (const auto& [id, entry] : axes)
+            {
+                if (entry.next_due <= now)
+                    due.push_back(id);
+                else
+                    next = std::min(next, entry.next_due);
+            }
+            due_encoders.clear();
+            for (const auto& [id, entry] : encoders)
+            {
+                if (entry.next_due <= now)
+                    due_encoders.push_back(id);
+                else
+                    next = std::min(next, entry.next_due);
+            }
+            for (const auto& notification : notifications | std::views::values)
+                next = std::min(next, notification.deadline);
+            if (due.empty() && due_encoders.empty())
+            {
+                // Timed out notifications of axes that are not due now.
+                evaluate_notifications({}, now);
+                if (!done_notifications.empty())
+                {
+                    notify_watches(lk);
+                    continue;
+                }
+                cv.wait_until(lk, next);
+                continue;
+            }
+
+            // Queries started from here on are no longer valid answers to a later invalidate().
+            for (const auto id : due)
+                axes[id].started++;
+            key = due;
+            for (const auto id : due_encoders)
+                key.push_back(-1 - id);
+            const auto config = config_for(key);
+            // Axis items of all due axes, the due encoder positions and the controller timer.
+            results.assign(due.size() * nItems + due_encoders.size() + 1, 0.);
+            lk.unlock();
+
+            bool ok = false;
+            SampleClock::time_point before;
+            SampleClock::time_point after;
+            std::string error;
+            {
+                std::lock_guard controller_lk(controller_mutex);
+                before = SampleClock::now();
+                if (controller != nullptr)
+                {
+                    TRACE_SCOPE(trace_calls, "Automation1_Status_GetResults", "items", results.size());
+                    ok = Automation1_Status_GetResults(controller, config, results.data(),
+                                                       static_cast<int>(results.size()));
+                }
+                after = SampleClock::now();
+                if (!ok)
+                {
+                    char msg[100];
+                    Automation1_GetLastErrorMessage(msg, 100);
+                    error = msg;
+                }
+            }
+
+            lk.lock();
+            const auto timestamp = ok
+                                       ? clock.update(results.back() * controller_timer_unit, before, after)
+                                       : before + (after - before) / 2;
+            window_calls++;
+            if (!ok)
+                last_error = error;
+            table.write_begin();
+            for (std::size_t i = 0; i < due.size(); i++)
+            {
+                const auto it = axes.find(due[i]);
+                if (it == axes.end())
+                    continue;
+                auto& entry = it->second;
+                entry.attempts++;
+                if (ok)
+                {
+                    const double* values = &results[i * nItems];
+                    auto& snapshot = entry.snapshot;
+                    const auto previous_fault = snapshot.valid ? std::optional(snapshot.axis_fault) : std::nullopt;
+                    snapshot.axis_status = values[Axis_ns::axisStates.at(Automation1AxisStatusItem_AxisStatus)];
+                    snapshot.drive_status = values[Axis_ns::axisStates.at(Automation1AxisStatusItem_DriveStatus)];
+                    snapshot.position_command = values[Axis_ns::axisStates.at(
+                        Automation1AxisStatusItem_ProgramPositionCommand)];
+                    snapshot.position_feedback = values[Axis_ns::axisStates.at(
+                        Automation1AxisStatusItem_ProgramPositionFeedback)];
+                    snapshot.velocity_command = values[Axis_ns::axisStates.at(
+                        Automation1AxisStatusItem_ProgramVelocityCommand)];
+                    snapshot.velocity_feedback = values[Axis_ns::axisStates.at(
+                        Automation1AxisStatusItem_ProgramVelocityFeedback)];
+                    snapshot.axis_fault = values[Axis_ns::axisStates.at(Automation1AxisStatusItem_AxisFault)];
+                    snapshot.timestamp = timestamp;
+                    snapshot.generation++;
+                    snapshot.valid = true;
+                    entry.window_samples++;
+                    entry.history.push(timestamp, snapshot.position_feedback);
+                    if (previous_fault && *previous_fault != snapshot.axis_fault)
+                        recorder.fault_change(due[i], *previous_fault, snapshot);
+                    if (journal_period.count() > 0 && timestamp >= entry.next_journal)
+                    {
+                        recorder.snapshot(due[i], snapshot);
+                        entry.next_journal = timestamp + std::chrono::duration_cast<SampleClock::duration>(
+                            journal_period);
+                    }
+
+                    const auto axis_status = static_cast<int>(snapshot.axis_status);
+                    const auto drive_status = static_cast<int>(snapshot.drive_status);
+                    const bool enabled = drive_status & Automation1DriveStatus_Enabled;
+                    const bool moving = !(axis_status & Automation1AxisStatus_MotionDone) ||
+                        axis_status & Automation1AxisStatus_Homing ||
+                        drive_status & Automation1DriveStatus_MoveActive;
+                    entry.active = enabled && moving;
+                }
+                entry.next_due = timestamp + std::chrono::duration_cast<SampleClock::duration>(
+                    entry.active ? fast_period : slow_period);
+                table.store(due[i], entry.snapshot);
+                table.set_pending(due[i], entry.attempts < entry.requested);
+            }
+            table.write_end();
+            if (ok)
+                evaluate_watches(due, timestamp);
+            evaluate_notifications(ok ? due : std::vector<int>{}, SampleClock::now());
+
+            for (std::size_t i = 0; i < due_encoders.size(); i++)
+            {
+                const auto it = encoders.find(due_encoders[i]);
+                if (it == encoders.end())
+                    continue;
+                auto& entry = it->second;
+                entry.attempts++;
+                if (ok)
+                {
+                    const double counts = results[due.size() * nItems + i];
+                    // Each step of the average is weighted by the real interval since the previous sample.
+                    if (!entry.snapshot.valid)
+                        entry.ema = counts;
+                    else
+                    {
+                        const std::chrono::duration<double> dt = timestamp - entry.snapshot.timestamp;
+                        const double alpha = entry.ema_time_constant > 0
+                                                 ? 1. - std::exp(-dt.count() / entry.ema_time_constant)
+                                                 : 1.;
+                        entry.ema += alpha * (counts - entry.ema);
+                    }
+                    entry.snapshot.counts = counts;
+                    entry.snapshot.timestamp = timestamp;
+                    entry.snapshot.valid = true;
+                    entry.window.push_back(entry.snapshot);
+                    while (entry.window.size() > entry.window_size)
+                        entry.window.pop_front();
+                }
+                const auto period = entry.rate > 0 ? std::chrono::duration<double>(1. / entry.rate) : fast_period;
+                entry.next_due = timestamp + std::chrono::duration_cast<SampleClock::duration>(period);
+            }
+
+            if (const std::chrono::duration<double> window = timestamp - window_start; window.count() >= 1.)
+            {
+                calls_rate = static_cast<double>(window_calls) / window.count();
+                window_calls = 0;
+                for (auto& entry : axes | std::views::values)
+                {
+                    entry.rate = static_cast<double>(entry.window_samples) / window.count();
+                    entry.window_samples = 0;
+                }
+                window_start = timestamp;
+            }
+            cv.notify_all();
+            notify_watches(lk);
+        }
+    }
+
+    Automation1StatusConfig Sampler::config_for(const std::vector<int>& key)
+    {
+        if (const auto it = configs.find(key); it != configs.end())
+            return it->second;
+        if (configs.size() >= max_configs)
+            clear_configs();
+
+        std::vector<Automation1AxisStatusItem> items(Axis_ns::axisStates.size());
+        for (const auto& [item, index] : Axis_ns::axisStates)
+            items[index] = item;
+
+        Automation1StatusConfig config{};
+        Automation1_StatusConfig_Create(&config);
+        for (const auto id : key)
+        {
+            if (id >= 0)
+                for (const auto item : items)
+                    Automation1_StatusConfig_AddAxisStatusItem(config, id, item, 0);
+            else
+                Automation1_StatusConfig_AddAxisStatusItem(config, -1 - id,
+                                                           Automation1AxisStatusItem_PrimaryBissAbsolutePosition, 0);
+        }
+        Automation1_StatusConfig_AddSystemStatusItem(config, Automation1SystemStatusItem_Timer, 0);
+        configs.emplace(key, config);
+        return config;
+    }
+
+    void Sampler::clear_configs()
+    {
+        for (const auto config : configs | std::views::values)
+            Automation1_StatusConfig_Destroy(config);
+        configs.clear();
+    }
+}
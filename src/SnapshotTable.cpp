@@ -0,0 +1,98 @@
+/*
+* Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "SnapshotTable.h"
+#include "Sampler.h"
+
+
+namespace Controller_ns
+{
+    void SnapshotTable::write_begin()
+    {
+        sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    void SnapshotTable::write_end()
+    {
+        sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    void SnapshotTable::store(const int axisID, const AxisSnapshot& snapshot)
+    {
+        if (!in_range(axisID))
+            return;
+        constexpr auto order = std::memory_order_relaxed;
+        axis_status[axisID].store(snapshot.axis_status, order);
+        drive_status[axisID].store(snapshot.drive_status, order);
+        position_command[axisID].store(snapshot.position_command, order);
+        position_feedback[axisID].store(snapshot.position_feedback, order);
+        velocity_command[axisID].store(snapshot.velocity_command, order);
+        velocity_feedback[axisID].store(snapshot.velocity_feedback, order);
+        axis_fault[axisID].store(snapshot.axis_fault, order);
+        timestamp[axisID].store(snapshot.timestamp.time_since_epoch().count(), order);
+        generation[axisID].store(snapshot.generation, order);
+        valid[axisID].store(snapshot.valid, order);
+    }
+
+    void SnapshotTable::clear(const int axisID)
+    {
+        if (!in_range(axisID))
+            return;
+        valid[axisID].store(false, std::memory_order_relaxed);
+        pending[axisID].store(false, std::memory_order_relaxed);
+    }
+
+    void SnapshotTable::set_pending(const int axisID, const bool value)
+    {
+        if (in_range(axisID))
+            pending[axisID].store(value, std::memory_order_relaxed);
+    }
+
+    std::optional<AxisSnapshot> SnapshotTable::load(const int axisID) const
+    {
+        if (!in_range(axisID))
+            return std::nullopt;
+        constexpr auto order = std::memory_order_relaxed;
+        AxisSnapshot snapshot;
+        bool is_pending;
+        std::uint64_t begin;
+        do
+        {
+            begin = sequence.load(std::memory_order_acquire);
+            if (begin & 1)
+                continue;
+            snapshot.axis_status = axis_status[axisID].load(order);
+            snapshot.drive_status = drive_status[axisID].load(order);
+            snapshot.position_command = position_command[axisID].load(order);
+            snapshot.position_feedback = position_feedback[axisID].load(order);
+            snapshot.velocity_command = velocity_command[axisID].load(order);
+            snapshot.velocity_feedback = velocity_feedback[axisID].load(order);
+            snapshot.axis_fault = axis_fault[axisID].load(order);
+            snapshot.timestamp = SampleClock::time_point(SampleClock::duration(timestamp[axisID].load(order)));
+            snapshot.generation = generation[axisID].load(order);
+            snapshot.valid = valid[axisID].load(order);
+            is_pending = pending[axisID].load(order);
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        while ((begin & 1) || sequence.load(std::memory_order_relaxed) != begin);
+
+        if (!snapshot.valid || is_pending)
+            return std::nullopt;
+        return snapshot;
+    }
+}
@@ -0,0 +1,127 @@
+/*
+* Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "StateFilter.h"
+#include <sstream>
+
+
+namespace Axis_ns
+{
+    void StateFilter::configure(const std::vector<std::string>& entries, const double dwell)
+    {
+        std::vector<Rule> parsed;
+        for (const auto& entry : entries)
+        {
+            std::vector<std::string> fields;
+            std::istringstream stream(entry);
+            for (std::string field; std::getline(stream, field, ':');)
+                fields.push_back(field);
+            if (fields.size() != 3)
+                Tango::Except::throw_exception("InvalidProperty", std::format("Invalid state rule '{}'", entry),
+                                               "StateFilter::configure()");
+
+            Rule rule{};
+            if (fields[0] != "*")
+                rule.from = parse_state(fields[0], entry);
+            if (fields[1] != "*")
+                rule.to = parse_state(fields[1], entry);
+            double seconds;
+            try
+            {
+                seconds = std::stod(fields[2]);
+            }
+            catch (const std::exception&)
+            {
+                seconds = -1.;
+            }
+            if (!(seconds >= 0.))
+                Tango::Except::throw_exception("InvalidProperty", std::format("Invalid hold time in '{}'", entry),
+                                               "StateFilter::configure()");
+            rule.hold = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+            parsed.push_back(rule);
+        }
+
+        std::lock_guard lk(mutex);
+        rules = std::move(parsed);
+        min_dwell = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(std::max(dwell, 0.)));
+        reported.reset();
+        candidate.reset();
+        suppressed_count = 0;
+    }
+
+    Tango::DevState StateFilter::filter(const Tango::DevState raw, const Clock::time_point now)
+    {
+        std::lock_guard lk(mutex);
+        if (!reported || raw == Tango::FAULT)
+        {
+            if (candidate)
+                suppressed_count++;
+            candidate.reset();
+            if (reported != raw)
+                reported_since = now;
+            reported = raw;
+            return raw;
+        }
+        if (raw == *reported)
+        {
+            // A flap: neither the change to the candidate nor the change back was reported.
+            if (candidate)
+                suppressed_count += 2;
+            candidate.reset();
+            return raw;
+        }
+
+        if (candidate != raw)
+        {
+            if (candidate)
+                suppressed_count++;
+            candidate = raw;
+            candidate_since = now;
+        }
+        if (now - candidate_since >= hold_time(*reported, raw) && now - reported_since >= min_dwell)
+        {
+            reported = raw;
+            reported_since = now;
+            candidate.reset();
+        }
+        return *reported;
+    }
+
+    std::uint64_t StateFilter::suppressed()
+    {
+        std::lock_guard lk(mutex);
+        return suppressed_count;
+    }
+
+    Tango::DevState StateFilter::parse_state(const std::string& name, const std::string& rule)
+    {
+        for (int state = Tango::ON; state <= Tango::UNKNOWN; state++)
+            if (name == Tango::DevStateName[state])
+                return static_cast<Tango::DevState>(state);
+        Tango::Except::throw_exception("InvalidProperty", std::format("Unknown state {} in '{}'", name, rule),
+                                       "StateFilter::configure()");
+    }
+
+    StateFilter::Clock::duration StateFilter::hold_time(const Tango::DevState from, const Tango::DevState to) const
+    {
+        Clock::duration hold{};
+        for (const auto& rule : rules)
+            if ((!rule.from || *rule.from == from) && (!rule.to || *rule.to == to))
+                hold = rule.hold;
+        return hold;
+    }
+}
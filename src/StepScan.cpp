@@ -0,0 +1,227 @@
+/*
+* Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "StepScan.h"
+#include <tango/tango.h>
+#include <cmath>
+#include <format>
+
+
+namespace Axis_ns
+{
+    // Time allowed for a step in addition to the ideal travel time.
+    constexpr double step_timeout_margin = 5.;
+
+    StepScan::StepScan(Automation1Controller& controller, std::mutex& controller_mutex,
+                       Controller_ns::Sampler& sampler, Controller_ns::FlightRecorder& recorder) :
+        controller(controller), controller_mutex(controller_mutex), sampler(sampler), recorder(recorder)
+    {
+    }
+
+    StepScan::~StepScan()
+    {
+        abort();
+    }
+
+    void StepScan::start(const int axisID, StepScanSettings settings,
+                         std::function<bool(const Controller_ns::AxisSnapshot&)> finished, MotionCheck check)
+    {
+        if (running)
+            Tango::Except::throw_exception("Busy", "A step scan is running", "StepScan::start()");
+        if (settings.positions.empty())
+            Tango::Except::throw_exception("InvalidArgument", "No scan points given", "StepScan::start()");
+        if (settings.velocity <= 0)
+            Tango::Except::throw_exception("InvalidArgument", "The velocity must be positive", "StepScan::start()");
+        if (thread.joinable())
+            thread.join();
+
+        {
+            std::lock_guard lk(mutex);
+            this->settings = std::move(settings);
+            aborted = false;
+            point_timestamps.clear();
+            point_positions.clear();
+            status_text = "running";
+        }
+        done = 0;
+        running = true;
+        thread = std::thread(&StepScan::run, this, axisID, std::move(finished), std::move(check));
+    }
+
+    void StepScan::abort()
+    {
+        {
+            std::lock_guard lk(mutex);
+            aborted = true;
+        }
+        cv.notify_all();
+        if (thread.joinable())
+            thread.join();
+    }
+
+    bool StepScan::is_running() const
+    {
+        return running;
+    }
+
+    int StepScan::progress() const
+    {
+        return done;
+    }
+
+    std::vector<double> StepScan::timestamps()
+    {
+        std::lock_guard lk(mutex);
+        return point_timestamps;
+    }
+
+    std::vector<double> StepScan::positions()
+    {
+        std::lock_guard lk(mutex);
+        return point_positions;
+    }
+
+    std::string StepScan::status()
+    {
+        std::lock_guard lk(mutex);
+        return status_text;
+    }
+
+    bool StepScan::wait(const std::chrono::duration<double> duration)
+    {
+        std::unique_lock lk(mutex);
+        return !cv.wait_for(lk, duration, [this] { return aborted; });
+    }
+
+    void StepScan::set_output(const int axisID, const int value)
+    {
+        std::lock_guard lk(controller_mutex);
+        if (!Automation1_Command_DigitalOutputSet(controller, 1, axisID, settings.trigger_output, value))
+        {
+            char msg[100];
+            Automation1_GetLastErrorMessage(msg, 100);
+            Tango::Except::throw_exception("TriggerError", msg, "StepScan::set_output()");
+        }
+    }
+
+    void StepScan::run(int axisID, const std::function<bool(const Controller_ns::AxisSnapshot&)> finished,
+                       const MotionCheck check)
+    {
+        std::string result;
+        bool output_high = false;
+        try
+        {
+            auto previous = sampler.axis(axisID).position_command;
+            for (std::size_t i = 0; i < settings.positions.size(); i++)
+            {
+                auto position = settings.positions[i];
+                {
+                    std::lock_guard lk(controller_mutex);
+                    const bool ok = Automation1_Command_MoveAbsolute(controller, 1, &axisID, 1, &position, 1,
+                                                                     &settings.velocity, 1);
+                    recorder.command(Controller_ns::FlightCommand::MoveAbsolute, axisID,
+                                     {position, settings.velocity}, ok);
+                    if (!ok)
+                    {
+                        char msg[100];
+                        Automation1_GetLastErrorMessage(msg, 100);
+                        Tango::Except::throw_exception("MotionError", msg, "StepScan::run()");
+                    }
+                }
+                sampler.invalidate(axisID);
+
+                // Wait in short slices so an abort is not delayed by a long move.
+                const auto timeout = std::chrono::duration<double>(
+                    std::abs(position - previous) / settings.velocity + step_timeout_margin);
+                const auto deadline = std::chrono::steady_clock::now() + timeout;
+                std::optional<Controller_ns::AxisSnapshot> snapshot;
+                while (!snapshot)
+                {
+                    if (!wait(std::chrono::duration<double>(0)))
+                        break;
+                    if (std::chrono::steady_clock::now() > deadline)
+                        Tango::Except::throw_exception("Timeout", std::format("Point {} not reached", i),
+                                                       "StepScan::run()");
+                    snapshot = sampler.wait_axis(axisID, finished, std::chrono::milliseconds(100));
+                }
+                if (!snapshot)
+                    break;
+                if (const auto error = check(*snapshot); !error.empty())
+                    Tango::Except::throw_exception("MotionError", error, "StepScan::run()");
+                previous = position;
+
+                if (!wait(std::chrono::duration<double>(settings.settle_time)))
+                    break;
+
+                const auto raised = std::chrono::steady_clock::now();
+                if (settings.trigger_output >= 0)
+                {
+                    set_output(axisID, 1);
+                    output_high = true;
+                }
+                // The first sample started after the rising edge is the point, not one taken before the pulse.
+                sampler.invalidate(axisID);
+                const auto triggered = sampler.axis(axisID);
+                if (output_high)
+                {
+                    wait(std::chrono::duration<double>(settings.trigger_time) -
+                         (std::chrono::steady_clock::now() - raised));
+                    set_output(axisID, 0);
+                    output_high = false;
+                }
+                {
+                    std::lock_guard lk(mutex);
+                    point_timestamps.push_back(std::chrono::duration<double>(
+                        triggered.timestamp.time_since_epoch()).count());
+                    point_positions.push_back(triggered.position_feedback);
+                }
+                done = static_cast<int>(i) + 1;
+            }
+        }
+        catch (Tango::DevFailed& e)
+        {
+            result = "error: " + (e.errors.length() > 0 ? std::string(e.errors[0].desc) : "unknown Tango error");
+        }
+        if (output_high)
+        {
+            try
+            {
+                set_output(axisID, 0);
+            }
+            catch (Tango::DevFailed& e)
+            {
+                result += "; trigger output not reset: " +
+                    (e.errors.length() > 0 ? std::string(e.errors[0].desc) : "unknown Tango error");
+            }
+        }
+
+        std::lock_guard lk(mutex);
+        if (aborted)
+        {
+            std::lock_guard controller_lk(controller_mutex);
+            recorder.command(Controller_ns::FlightCommand::Abort, axisID, {},
+                             Automation1_Command_Abort(controller, &axisID, 1));
+        }
+        if (!result.empty())
+            status_text = result;
+        else if (aborted)
+            status_text = std::format("aborted after {} of {} points", done.load(), settings.positions.size());
+        else
+            status_text = std::format("done, {} points", settings.positions.size());
+        running = false;
+    }
+}
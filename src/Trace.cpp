@@ -0,0 +1,164 @@
+/*
+* Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "Trace.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <tango/tango.h>
+
+
+namespace Controller_ns
+{
+    namespace
+    {
+        // Interval in which the thread buffers are drained. A buffer holds the events of a busy thread for longer.
+        constexpr auto drain_period = std::chrono::milliseconds(50);
+    }
+
+    Tracer& Tracer::instance()
+    {
+        static auto* tracer = new Tracer();
+        return *tracer;
+    }
+
+    Tracer::Tracer() : history(history_size), thread(&Tracer::run, this)
+    {
+    }
+
+    void Tracer::set_enabled(const bool enabled)
+    {
+        on.store(enabled, std::memory_order_relaxed);
+    }
+
+    std::int64_t Tracer::now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void Tracer::record(const TraceEvent& event)
+    {
+        auto& buffer = thread_buffer();
+        const auto head = buffer.head.load(std::memory_order_relaxed);
+        if (head - buffer.tail.load(std::memory_order_acquire) >= ThreadBuffer::capacity)
+        {
+            buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        buffer.events[head % ThreadBuffer::capacity] = event;
+        buffer.head.store(head + 1, std::memory_order_release);
+    }
+
+    Tracer::ThreadBuffer& Tracer::thread_buffer()
+    {
+        thread_local const auto buffer = [this]
+        {
+            auto created = std::make_shared<ThreadBuffer>();
+            std::lock_guard lk(buffers_mutex);
+            created->thread = next_thread++;
+            buffers.push_back(created);
+            return created;
+        }();
+        return *buffer;
+    }
+
+    void Tracer::run()
+    {
+        while (true)
+        {
+            std::this_thread::sleep_for(drain_period);
+            std::lock_guard lk(history_mutex);
+            drain();
+        }
+    }
+
+    void Tracer::drain()
+    {
+        std::lock_guard lk(buffers_mutex);
+        for (auto it = buffers.begin(); it != buffers.end();)
+        {
+            auto& buffer = **it;
+            const auto head = buffer.head.load(std::memory_order_acquire);
+            for (auto tail = buffer.tail.load(std::memory_order_relaxed); tail != head; tail++)
+            {
+                history[history_next % history_size] = buffer.events[tail % ThreadBuffer::capacity];
+                history[history_next % history_size].thread = buffer.thread;
+                history_next++;
+            }
+            buffer.tail.store(head, std::memory_order_release);
+
+            // Only the registry is left holding the buffer of an exited thread.
+            if (it->use_count() == 1)
+            {
+                dropped_exited += buffer.dropped.load(std::memory_order_relaxed);
+                it = buffers.erase(it);
+            }
+            else
+                ++it;
+        }
+    }
+
+    std::size_t Tracer::export_chrome(const std::filesystem::path& path)
+    {
+        std::vector<TraceEvent> events;
+        {
+            std::lock_guard lk(history_mutex);
+            drain();
+            const auto count = std::min(history_next, history_size);
+            events.reserve(count);
+            for (auto i = history_next - count; i != history_next; i++)
+                events.push_back(history[i % history_size]);
+        }
+        std::ranges::sort(events, {}, &TraceEvent::start);
+
+        std::ofstream file(path);
+        if (!file)
+            Tango::Except::throw_exception("TraceExportError", "Cannot write " + path.string(),
+                                           "Tracer::export_chrome()");
+        file << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        for (std::size_t i = 0; i < events.size(); i++)
+        {
+            const auto& event = events[i];
+            file << (i ? ",\n" : "\n") << R"({"name":")" << event.name << R"(","cat":"automation1","pid":1,"tid":)"
+                << event.thread << R"(,"ts":)" << static_cast<double>(event.start) / 1e3;
+            if (event.duration < 0)
+                file << R"(,"ph":"i","s":"t")";
+            else
+                file << R"(,"ph":"X","dur":)" << static_cast<double>(event.duration) / 1e3;
+            if (event.arg_name != nullptr)
+                file << R"(,"args":{")" << event.arg_name << "\":" << std::setprecision(9)
+                    << (std::isfinite(event.arg) ? event.arg : 0.) << std::setprecision(3);
+            file << (event.arg_name != nullptr ? "}}" : "}");
+        }
+        file << "\n]}\n";
+        if (!file)
+            Tango::Except::throw_exception("TraceExportError", "Cannot write " + path.string(),
+                                           "Tracer::export_chrome()");
+        return events.size();
+    }
+
+    std::uint64_t Tracer::dropped()
+    {
+        std::lock_guard lk(buffers_mutex);
+        auto count = dropped_exited;
+        for (const auto& buffer : buffers)
+            count += buffer->dropped.load(std::memory_order_relaxed);
+        return count;
+    }
+}
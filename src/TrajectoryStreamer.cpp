@@ -0,0 +1,184 @@
+/*
+* Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "TrajectoryStreamer.h"
+#include <tango/tango.h>
+#include <format>
+
+
+namespace Axis_ns
+{
+    // Interval in which the queue status is polled and the queue is refilled.
+    constexpr auto refill_period = std::chrono::milliseconds(5);
+
+    // Commands queued before the first MovePvt.
+    constexpr int setup_commands = 1;
+
+    TrajectoryStreamer::TrajectoryStreamer(Automation1Controller& controller, std::mutex& controller_mutex,
+                                           Controller_ns::FlightRecorder& recorder) :
+        controller(controller), controller_mutex(controller_mutex), recorder(recorder)
+    {
+    }
+
+    TrajectoryStreamer::~TrajectoryStreamer()
+    {
+        abort();
+    }
+
+    void TrajectoryStreamer::load(std::vector<Point> trajectory)
+    {
+        if (running)
+            Tango::Except::throw_exception("Busy", "A trajectory is running", "TrajectoryStreamer::load()");
+        if (thread.joinable())
+            thread.join();
+        points = std::move(trajectory);
+        executed = 0;
+        underrun_count = 0;
+        set_status(std::format("loaded {} points", points.size()));
+    }
+
+    void TrajectoryStreamer::start(const std::string& axisName, const int axisID, const int task, const int depth)
+    {
+        if (running)
+            Tango::Except::throw_exception("Busy", "A trajectory is running", "TrajectoryStreamer::start()");
+        if (points.empty())
+            Tango::Except::throw_exception("NotLoaded", "No trajectory loaded", "TrajectoryStreamer::start()");
+        if (thread.joinable())
+            thread.join();
+        executed = 0;
+        underrun_count = 0;
+        aborted = false;
+        running = true;
+        set_status("running");
+        thread = std::thread(&TrajectoryStreamer::run, this, axisName, axisID, task, std::max(depth, 2));
+    }
+
+    void TrajectoryStreamer::abort()
+    {
+        aborted = true;
+        if (thread.joinable())
+            thread.join();
+    }
+
+    bool TrajectoryStreamer::is_running() const
+    {
+        return running;
+    }
+
+    int TrajectoryStreamer::size() const
+    {
+        return static_cast<int>(points.size());
+    }
+
+    int TrajectoryStreamer::progress() const
+    {
+        return executed;
+    }
+
+    int TrajectoryStreamer::underruns() const
+    {
+        return underrun_count;
+    }
+
+    std::string TrajectoryStreamer::status() const
+    {
+        std::lock_guard lk(status_mutex);
+        return status_text;
+    }
+
+    void TrajectoryStreamer::set_status(const std::string& text)
+    {
+        std::lock_guard lk(status_mutex);
+        status_text = text;
+    }
+
+    void TrajectoryStreamer::run(const std::string axisName, int axisID, const int task, const int depth)
+    {
+        auto last_error = []
+        {
+            char msg[100];
+            Automation1_GetLastErrorMessage(msg, 100);
+            return std::string(msg);
+        };
+
+        Automation1CommandQueue queue{};
+        {
+            std::lock_guard lk(controller_mutex);
+            if (!Automation1_CommandQueue_Begin(controller, task, depth, false, false, &queue))
+            {
+                set_status("error: " + last_error());
+                running = false;
+                return;
+            }
+            Automation1_CommandQueue_AddCommand(queue, "SetupTaskTargetMode(TargetMode.Absolute)");
+        }
+
+        const auto total = static_cast<int>(points.size());
+        int sent = 0;
+        int emptied = 0;
+        std::string error;
+        while (!aborted)
+        {
+            Automation1CommandQueueStatus status{};
+            {
+                std::lock_guard lk(controller_mutex);
+                if (!Automation1_CommandQueue_GetStatus(queue, &status))
+                {
+                    error = last_error();
+                    break;
+                }
+                // The queue emptied while points were still pending: the host did not keep up.
+                if (status.NumberOfTimesEmptied > emptied && sent > 0 && sent < total)
+                    underrun_count += status.NumberOfTimesEmptied - emptied;
+                emptied = status.NumberOfTimesEmptied;
+                executed = std::clamp(status.NumberOfExecutedCommands - setup_commands, 0, total);
+
+                for (auto queued = status.NumberOfUnexecutedCommands; queued < depth && sent < total; queued++)
+                {
+                    const auto& [position, velocity, time] = points[sent];
+                    const auto command = std::format("MovePvt({}, {}, {}, {})", axisName, position, velocity,
+                                                     time);
+                    if (!Automation1_CommandQueue_AddCommand(queue, command.c_str()))
+                    {
+                        error = last_error();
+                        break;
+                    }
+                    sent++;
+                }
+            }
+            if (!error.empty() || executed >= total)
+                break;
+            std::this_thread::sleep_for(refill_period);
+        }
+
+        {
+            std::lock_guard lk(controller_mutex);
+            if (aborted)
+                recorder.command(Controller_ns::FlightCommand::Abort, axisID, {},
+                                 Automation1_Command_Abort(controller, &axisID, 1));
+            Automation1_CommandQueue_End(controller, queue, 0);
+        }
+
+        if (!error.empty())
+            set_status("error: " + error);
+        else if (aborted)
+            set_status(std::format("aborted after {} of {} points", executed.load(), total));
+        else
+            set_status(std::format("done, {} points", total));
+        running = false;
+    }
+}
@@ -0,0 +1,160 @@
+/*
+* Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "VelocityStreamer.h"
+#include <tango/tango.h>
+#include <format>
+
+
+namespace Axis_ns
+{
+    VelocityStreamer::VelocityStreamer(Automation1Controller& controller, std::mutex& controller_mutex,
+                                       Controller_ns::Sampler& sampler, Controller_ns::FlightRecorder& recorder,
+                                       const double rate, const double timeout) :
+        controller(controller), controller_mutex(controller_mutex), sampler(sampler), recorder(recorder),
+        period(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1. / std::max(rate, 1.)))),
+        timeout(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(timeout)))
+    {
+    }
+
+    VelocityStreamer::~VelocityStreamer()
+    {
+        stop();
+    }
+
+    void VelocityStreamer::set(const int axisID, const double velocity)
+    {
+        std::unique_lock lk(mutex);
+        if (running && !exiting)
+        {
+            if (fresh)
+                coalesced_count++;
+            target = velocity;
+            fresh = true;
+            last_update = Clock::now();
+            cv.notify_all();
+            return;
+        }
+
+        // The previous stream has ended or is about to.
+        lk.unlock();
+        if (thread.joinable())
+            thread.join();
+        lk.lock();
+        target = velocity;
+        fresh = true;
+        last_update = Clock::now();
+        stopping = false;
+        exiting = false;
+        halt_on_stop = true;
+        coalesced_count = 0;
+        status_text = "streaming";
+        running = true;
+        thread = std::thread(&VelocityStreamer::run, this, axisID);
+    }
+
+    void VelocityStreamer::stop(const bool halt)
+    {
+        {
+            std::lock_guard lk(mutex);
+            stopping = true;
+            halt_on_stop = halt;
+        }
+        cv.notify_all();
+        if (thread.joinable())
+            thread.join();
+    }
+
+    bool VelocityStreamer::is_running() const
+    {
+        return running;
+    }
+
+    double VelocityStreamer::velocity() const
+    {
+        return applied;
+    }
+
+    long VelocityStreamer::coalesced() const
+    {
+        return coalesced_count;
+    }
+
+    std::string VelocityStreamer::status()
+    {
+        std::lock_guard lk(mutex);
+        return status_text;
+    }
+
+    void VelocityStreamer::run(int axisID)
+    {
+        std::string result = "stopped";
+        std::unique_lock lk(mutex);
+        auto next_send = Clock::now();
+        while (true)
+        {
+            if (!cv.wait_until(lk, last_update + timeout, [this] { return stopping || fresh; }))
+            {
+                result = std::format("stopped, no setpoint for {:.3f} s",
+                                     std::chrono::duration<double>(timeout).count());
+                break;
+            }
+            if (stopping)
+                break;
+            // Setpoints arriving while waiting replace the pending one.
+            if (cv.wait_until(lk, next_send, [this] { return stopping; }))
+                break;
+
+            double velocity = target;
+            fresh = false;
+            lk.unlock();
+            bool ok;
+            {
+                std::lock_guard controller_lk(controller_mutex);
+                ok = Automation1_Command_MoveFreerun(controller, 1, &axisID, 1, &velocity, 1);
+                recorder.command(Controller_ns::FlightCommand::MoveFreerun, axisID, {velocity}, ok);
+                if (!ok)
+                {
+                    char msg[100];
+                    Automation1_GetLastErrorMessage(msg, 100);
+                    result = std::string("error: ") + msg;
+                }
+            }
+            lk.lock();
+            if (!ok)
+                break;
+            applied = velocity;
+            next_send = Clock::now() + period;
+        }
+
+        exiting = true;
+        const bool halt = halt_on_stop;
+        lk.unlock();
+        if (halt)
+        {
+            std::lock_guard controller_lk(controller_mutex);
+            recorder.command(Controller_ns::FlightCommand::MoveFreerunStop, axisID, {},
+                             Automation1_Command_MoveFreerunStop(controller, 1, &axisID, 1));
+        }
+        sampler.invalidate(axisID);
+
+        lk.lock();
+        status_text = result;
+        fresh = false;
+        running = false;
+    }
+}
@@ -0,0 +1,344 @@
+/*
+* Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "WatchExpression.h"
+#include "Sampler.h"
+#include <tango/tango.h>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+
+
+namespace Controller_ns
+{
+    class WatchExpression::Parser
+    {
+    public:
+        Parser(WatchExpression& expression, const AxisResolver& resolve, const std::optional<int> default_axis) :
+            expression(expression), text(expression.source), resolve(resolve), default_axis(default_axis)
+        {
+        }
+
+        void run()
+        {
+            parse_or();
+            skip_space();
+            if (pos < text.size())
+                fail("unexpected '" + text.substr(pos) + "'");
+        }
+
+    private:
+        void fail(const std::string& reason) const
+        {
+            Tango::Except::throw_exception("InvalidExpression",
+                                           std::format("Watch expression '{}': {}", text, reason),
+                                           "WatchExpression::parse()");
+        }
+
+        void skip_space()
+        {
+            while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos])))
+                pos++;
+        }
+
+        [[nodiscard]] static bool is_word_char(const char c)
+        {
+            return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+        }
+
+        // Consumes the symbol unless it is the start of the longer symbol.
+        bool accept(const char* symbol, const char* longer = nullptr)
+        {
+            skip_space();
+            if (longer != nullptr && text.compare(pos, std::strlen(longer), longer) == 0)
+                return false;
+            if (text.compare(pos, std::strlen(symbol), symbol) != 0)
+                return false;
+            pos += std::strlen(symbol);
+            return true;
+        }
+
+        bool accept_word(const char* word)
+        {
+            skip_space();
+            const auto length = std::strlen(word);
+            if (text.compare(pos, length, word) != 0 ||
+                (pos + length < text.size() && is_word_char(text[pos + length])))
+                return false;
+            pos += length;
+            return true;
+        }
+
+        void emit(const Operation& operation)
+        {
+            switch (operation.code)
+            {
+            case Operation::Constant:
+            case Operation::Load:
+                depth++;
+                break;
+            case Operation::Not:
+                break;
+            default:
+                depth--;
+            }
+            if (depth > max_stack)
+                fail("too deeply nested");
+            expression.program.push_back(operation);
+        }
+
+        void parse_or()
+        {
+            parse_and();
+            while (accept("||") || accept_word("or"))
+            {
+                parse_and();
+                emit({Operation::Or});
+            }
+        }
+
+        void parse_and()
+        {
+            parse_not();
+            while (accept("&&") || accept_word("and"))
+            {
+                parse_not();
+                emit({Operation::And});
+            }
+        }
+
+        void parse_not()
+        {
+            if (accept("!", "!=") || accept_word("not"))
+            {
+                parse_not();
+                emit({Operation::Not});
+                return;
+            }
+            parse_comparison();
+        }
+
+        void parse_comparison()
+        {
+            static const std::pair<const char*, Operation::Code> operators[] = {
+                {"<=", Operation::LessEqual}, {">=", Operation::GreaterEqual}, {"==", Operation::Equal},
+                {"!=", Operation::NotEqual}, {"<", Operation::Less}, {">", Operation::Greater}
+            };
+            parse_operand();
+            for (const auto& [symbol, code] : operators)
+            {
+                if (accept(symbol))
+                {
+                    parse_operand();
+                    emit({code});
+                    return;
+                }
+            }
+            if (accept("&", "&&"))
+            {
+                parse_operand();
+                emit({Operation::BitTest});
+            }
+        }
+
+        void parse_operand()
+        {
+            static const std::map<std::string, Field> fields = {
+                {"position", Field::Position}, {"position_command", Field::PositionCommand},
+                {"velocity", Field::Velocity}, {"velocity_command", Field::VelocityCommand},
+                {"axis_status", Field::AxisStatus}, {"drive_status", Field::DriveStatus},
+                {"axis_fault", Field::AxisFault}, {"enabled", Field::Enabled}, {"homed", Field::Homed},
+                {"motion_done", Field::MotionDone}, {"cw_limit", Field::CwLimit}, {"ccw_limit", Field::CcwLimit},
+                {"fault", Field::Fault}
+            };
+
+            if (accept("("))
+            {
+                parse_or();
+                if (!accept(")"))
+                    fail("missing ')'");
+                return;
+            }
+            skip_space();
+            if (pos >= text.size())
+                fail("operand expected");
+
+            if (const char c = text[pos]; std::isdigit(static_cast<unsigned char>(c)) || c == '.' || c == '-' ||
+                c == '+')
+            {
+                char* end;
+                const double value = std::strtod(text.c_str() + pos, &end);
+                if (end == text.c_str() + pos)
+                    fail("invalid number at '" + text.substr(pos) + "'");
+                pos = static_cast<std::size_t>(end - text.c_str());
+                emit({Operation::Constant, value});
+                return;
+            }
+
+            std::string name = word();
+            std::optional<int> axisID = default_axis;
+            if (pos < text.size() && text[pos] == '.')
+            {
+                pos++;
+                axisID = resolve(name);
+                name = word();
+            }
+            const auto field = fields.find(name);
+            if (field == fields.end())
+                fail("unknown field '" + name + "'");
+            if (!axisID)
+                fail("field '" + name + "' needs an axis, e.g. X." + name);
+            if (std::ranges::find(expression.used_axes, *axisID) == expression.used_axes.end())
+                expression.used_axes.push_back(*axisID);
+            emit({Operation::Load, 0., *axisID, field->second});
+        }
+
+        std::string word()
+        {
+            const auto start = pos;
+            while (pos < text.size() && is_word_char(text[pos]))
+                pos++;
+            if (pos == start)
+                fail("name expected at '" + text.substr(start) + "'");
+            return text.substr(start, pos - start);
+        }
+
+        WatchExpression& expression;
+
+        const std::string& text;
+
+        const AxisResolver& resolve;
+
+        std::optional<int> default_axis;
+
+        std::size_t pos{};
+
+        std::size_t depth{};
+    };
+
+    WatchExpression WatchExpression::parse(const std::string& text, const AxisResolver& resolve,
+                                           const std::optional<int> default_axis)
+    {
+        WatchExpression expression;
+        expression.source = text;
+        Parser(expression, resolve, default_axis).run();
+        return expression;
+    }
+
+    bool WatchExpression::evaluate(const std::function<const AxisSnapshot*(int)>& snapshot) const
+    {
+        std::array<double, max_stack> stack{};
+        std::size_t top = 0;
+        for (const auto& operation : program)
+        {
+            if (operation.code == Operation::Constant)
+            {
+                stack[top++] = operation.value;
+                continue;
+            }
+            if (operation.code == Operation::Load)
+            {
+                const auto* axis = snapshot(operation.axisID);
+                if (axis == nullptr || !axis->valid)
+                    return false;
+                stack[top++] = field_value(operation.field, *axis);
+                continue;
+            }
+            if (operation.code == Operation::Not)
+            {
+                stack[top - 1] = stack[top - 1] == 0 ? 1. : 0.;
+                continue;
+            }
+
+            const double b = stack[--top];
+            double& a = stack[top - 1];
+            switch (operation.code)
+            {
+            case Operation::Less:
+                a = a < b;
+                break;
+            case Operation::LessEqual:
+                a = a <= b;
+                break;
+            case Operation::Greater:
+                a = a > b;
+                break;
+            case Operation::GreaterEqual:
+                a = a >= b;
+                break;
+            case Operation::Equal:
+                a = a == b;
+                break;
+            case Operation::NotEqual:
+                a = a != b;
+                break;
+            case Operation::BitTest:
+                a = (static_cast<std::int64_t>(a) & static_cast<std::int64_t>(b)) != 0;
+                break;
+            case Operation::And:
+                a = a != 0 && b != 0;
+                break;
+            case Operation::Or:
+                a = a != 0 || b != 0;
+                break;
+            default:
+                break;
+            }
+        }
+        return top == 1 && stack[0] != 0;
+    }
+
+    double WatchExpression::field_value(const Field field, const AxisSnapshot& snapshot)
+    {
+        const auto axis_status = static_cast<int>(snapshot.axis_status);
+        const auto drive_status = static_cast<int>(snapshot.drive_status);
+        switch (field)
+        {
+        case Field::Position:
+            return snapshot.position_feedback;
+        case Field::PositionCommand:
+            return snapshot.position_command;
+        case Field::Velocity:
+            return snapshot.velocity_feedback;
+        case Field::VelocityCommand:
+            return snapshot.velocity_command;
+        case Field::AxisStatus:
+            return snapshot.axis_status;
+        case Field::DriveStatus:
+            return snapshot.drive_status;
+        case Field::AxisFault:
+            return snapshot.axis_fault;
+        case Field::Enabled:
+            return (drive_status & Automation1DriveStatus_Enabled) != 0;
+        case Field::Homed:
+            return (axis_status & Automation1AxisStatus_Homed) != 0;
+        case Field::MotionDone:
+            return (axis_status & Automation1AxisStatus_MotionDone) != 0;
+        case Field::CwLimit:
+            return (drive_status & Automation1DriveStatus_CwEndOfTravelLimitInput) != 0;
+        case Field::CcwLimit:
+            return (drive_status & Automation1DriveStatus_CcwEndOfTravelLimitInput) != 0;
+        case Field::Fault:
+            return snapshot.axis_fault != 0;
+        }
+        return 0.;
+    }
+}
@@ -0,0 +1,140 @@
+/*
+* Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "WatchSet.h"
+#include <algorithm>
+#include <cctype>
+
+
+namespace Controller_ns
+{
+    namespace
+    {
+        Tango::TimeVal to_timeval(const SampleClock::time_point time)
+        {
+            const auto us = std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+            Tango::TimeVal tv{};
+            tv.tv_sec = static_cast<decltype(tv.tv_sec)>(us / 1000000);
+            tv.tv_usec = static_cast<decltype(tv.tv_usec)>(us % 1000000);
+            return tv;
+        }
+    }
+
+    WatchSet::WatchSet(Tango::DeviceImpl& device, EventPusher& events, Automation1Controller& controller,
+                       std::mutex& controller_mutex, Sampler& sampler) :
+        device(device), events(events), controller(controller), controller_mutex(controller_mutex), sampler(sampler)
+    {
+    }
+
+    WatchSet::~WatchSet()
+    {
+        clear();
+    }
+
+    void WatchSet::add(const std::string& name, const std::string& expression, const std::optional<int> default_axis,
+                       std::unique_ptr<Tango::Attr> attribute)
+    {
+        if (name.empty() || !std::ranges::all_of(name, [](const char c)
+        {
+            return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+        }))
+            Tango::Except::throw_exception("InvalidName", "Watch names may only contain letters, digits and '_'",
+                                           "WatchSet::add()");
+        if (watches.contains(name))
+            Tango::Except::throw_exception("InvalidName", std::format("Watch {} exists already", name),
+                                           "WatchSet::add()");
+        const auto watch = WatchExpression::parse(expression, [this](const std::string& axis)
+        {
+            int axisID;
+            std::lock_guard lk(controller_mutex);
+            if (!Automation1_Controller_GetAxisIndexFromAxisName(controller, axis.c_str(), &axisID))
+            {
+                char msg[100];
+                Automation1_GetLastErrorMessage(msg, 100);
+                Tango::Except::throw_exception("AxisNotFound", std::format("Axis {}: {}", axis, msg),
+                                               "WatchSet::add()");
+            }
+            return axisID;
+        }, default_axis);
+
+        const auto attribute_name = WatchSet::attribute_name(name);
+        device.add_attribute(attribute.release());
+        device.set_change_event(attribute_name, true, false);
+        const auto id = sampler.add_watch(watch, [this, attribute_name](const bool state,
+                                                                        const SampleClock::time_point timestamp)
+        {
+            // Every state change is pushed, a short pulse must not collapse into its final state.
+            events.append(attribute_name, [this, attribute_name, tv = to_timeval(timestamp),
+                            value = Tango::DevBoolean(state)]() mutable
+            {
+                device.push_change_event(attribute_name, &value, tv, Tango::ATTR_VALID);
+            });
+        });
+        watches.emplace(name, Watch{watch.text(), id});
+    }
+
+    void WatchSet::remove(const std::string& name)
+    {
+        const auto it = watches.find(name);
+        if (it == watches.end())
+            Tango::Except::throw_exception("UnknownWatch", std::format("No watch named {}", name),
+                                           "WatchSet::remove()");
+        sampler.remove_watch(it->second.id);
+        watches.erase(it);
+        device.remove_attribute(attribute_name(name), true, false);
+    }
+
+    void WatchSet::clear()
+    {
+        for (const auto& [name, watch] : watches)
+        {
+            sampler.remove_watch(watch.id);
+            try
+            {
+                device.remove_attribute(attribute_name(name), true, false);
+            }
+            catch (const Tango::DevFailed&)
+            {
+            }
+        }
+        watches.clear();
+    }
+
+    void WatchSet::read(Tango::Attribute& attribute)
+    {
+        const auto it = std::ranges::find_if(watches, [&](const auto& entry)
+        {
+            return attribute_name(entry.first) == attribute.get_name();
+        });
+        if (it == watches.end())
+            Tango::Except::throw_exception("UnknownWatch", std::format("No watch for {}", attribute.get_name()),
+                                           "WatchSet::read()");
+        const auto state = sampler.watch_state(it->second.id);
+        if (!state)
+            Tango::Except::throw_exception("NotEvaluated", "The watch was not evaluated yet", "WatchSet::read()");
+        it->second.value = *state;
+        attribute.set_value(&it->second.value);
+    }
+
+    std::vector<std::string> WatchSet::list() const
+    {
+        std::vector<std::string> entries;
+        for (const auto& [name, watch] : watches)
+            entries.push_back(name + ": " + watch.expression);
+        return entries;
+    }
+}
@@ -0,0 +1,162 @@
+/*
+* Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Prints the records of a flight recorder journal as text, oldest first. Works on the journal of a running server
+// and after a crash, without the Tango and automation1 libraries.
+//
+//   automation1_journal <journal> [--axis <id>] [--last <count>]
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "FlightRecord.h"
+
+using namespace Controller_ns;
+
+namespace
+{
+    std::string format_time(const std::int64_t ns)
+    {
+        const std::time_t seconds = ns / 1000000000;
+        std::tm utc{};
+        gmtime_r(&seconds, &utc);
+        std::ostringstream text;
+        text << std::put_time(&utc, "%Y-%m-%dT%H:%M:%S") << '.' << std::setw(9) << std::setfill('0')
+            << ns % 1000000000 << 'Z';
+        return text.str();
+    }
+
+    std::string hex(const double word)
+    {
+        std::ostringstream text;
+        text << "0x" << std::hex << static_cast<std::uint64_t>(word);
+        return text.str();
+    }
+
+    std::string describe(const FlightRecord& record)
+    {
+        std::ostringstream text;
+        text << std::setprecision(10);
+        const auto* v = record.values;
+        switch (record.type)
+        {
+        case FlightRecordType::Start:
+            text << "start";
+            break;
+        case FlightRecordType::Command:
+            text << "command axis=" << record.axisID << ' '
+                << flight_command_name(static_cast<FlightCommand>(record.code));
+            for (int i = 0, n = 0; i < 3; i++)
+                if (!std::isnan(v[i]))
+                    text << (n++ ? "," : " args=") << v[i];
+            text << (v[3] != 0 ? " ok" : " failed");
+            break;
+        case FlightRecordType::FaultChange:
+            text << "fault axis=" << record.axisID << ' ' << hex(v[0]) << " -> " << hex(v[1]) << " axis_status="
+                << hex(v[2]) << " drive_status=" << hex(v[3]) << " position=" << v[4];
+            break;
+        case FlightRecordType::Snapshot:
+            text << "status axis=" << record.axisID << " axis_status=" << hex(v[0]) << " drive_status=" << hex(v[1])
+                << " fault=" << hex(v[2]) << " position=" << v[3] << " velocity=" << v[4];
+            break;
+        default:
+            text << "unknown type " << static_cast<int>(record.type);
+        }
+        return text.str();
+    }
+
+    int usage()
+    {
+        std::cerr << "usage: automation1_journal <journal> [--axis <id>] [--last <count>]" << std::endl;
+        return 2;
+    }
+}
+
+int main(const int argc, char* argv[])
+{
+    if (argc < 2)
+        return usage();
+    std::optional<int> axis;
+    std::optional<std::size_t> last;
+    for (int i = 2; i < argc; i++)
+    {
+        if (i + 1 < argc && std::strcmp(argv[i], "--axis") == 0)
+            axis = std::atoi(argv[++i]);
+        else if (i + 1 < argc && std::strcmp(argv[i], "--last") == 0)
+            last = std::strtoull(argv[++i], nullptr, 10);
+        else
+            return usage();
+    }
+
+    std::ifstream file(argv[1], std::ios::binary);
+    FlightRecordHeader header{};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    {
+        std::cerr << argv[1] << ": cannot read the journal header" << std::endl;
+        return 1;
+    }
+    if (header.magic != flight_record_magic || header.version != flight_record_version ||
+        header.record_size != sizeof(FlightRecord))
+    {
+        std::cerr << argv[1] << ": not a flight recorder journal of version " << flight_record_version << std::endl;
+        return 1;
+    }
+
+    // The capacity comes from the file, a damaged header must not make the decoder allocate more than the file holds.
+    std::error_code error;
+    const auto file_size = std::filesystem::file_size(argv[1], error);
+    if (error)
+    {
+        std::cerr << argv[1] << ": " << error.message() << std::endl;
+        return 1;
+    }
+    const std::uint64_t stored = (file_size - sizeof(header)) / sizeof(FlightRecord);
+    if (header.capacity > stored)
+        std::cerr << argv[1] << ": header capacity " << header.capacity << " exceeds the " << stored
+            << " records in the file, the journal is truncated" << std::endl;
+
+    std::vector<FlightRecord> records(std::min(header.capacity, stored));
+    file.read(reinterpret_cast<char*>(records.data()),
+              static_cast<std::streamsize>(records.size() * sizeof(FlightRecord)));
+    records.resize(static_cast<std::size_t>(file.gcount()) / sizeof(FlightRecord));
+
+    // Empty slots and records torn by a crash have sequence 0.
+    std::erase_if(records, [&](const FlightRecord& record)
+    {
+        return record.sequence == 0 || (axis && record.type != FlightRecordType::Start && record.axisID != *axis);
+    });
+    std::ranges::sort(records, {}, &FlightRecord::sequence);
+    if (last && records.size() > *last)
+        records.erase(records.begin(), records.end() - static_cast<std::ptrdiff_t>(*last));
+
+    std::cout << "# " << header.head << " records written, " << std::min(header.capacity, stored) << " kept"
+        << std::endl;
+    for (const auto& record : records)
+        std::cout << record.sequence << ' ' << format_time(record.time) << ' ' << describe(record) << '\n';
+    return 0;
+}
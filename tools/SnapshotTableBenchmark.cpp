@@ -0,0 +1,235 @@
+/*
+ * Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Compares axis snapshot reads from the sequence locked SnapshotTable with reads of a map under a mutex, as done
+// before, for 1 to 32 concurrent readers while one writer publishes samples like the sampler. Prints the reads per
+// second, the mean time per read, the writer time per sample and the number of torn reads (snapshots mixing two
+// samples), which must be 0.
+//
+//   automation1_snapshot_bench [--seconds <s>] [--axes <count>] [--period <us>]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Sampler.h"
+#include "SnapshotTable.h"
+
+using namespace Controller_ns;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Settings
+    {
+        // Time the readers read back to back per measurement.
+        std::chrono::duration<double> duration{1.};
+        int axes{8};
+        // Time between two samples of all axes.
+        std::chrono::microseconds period{1000};
+    };
+
+    struct Result
+    {
+        double reads_per_second{};
+        double read_ns{};
+        double write_mean_us{};
+        double write_max_us{};
+        std::size_t torn{};
+    };
+
+    // All fields of a sample carry its number, so a reader can tell a snapshot mixing two samples.
+    AxisSnapshot make_sample(const std::uint64_t number)
+    {
+        const auto value = static_cast<double>(number);
+        AxisSnapshot snapshot;
+        snapshot.axis_status = value;
+        snapshot.drive_status = value;
+        snapshot.position_command = value;
+        snapshot.position_feedback = value;
+        snapshot.velocity_command = value;
+        snapshot.velocity_feedback = value;
+        snapshot.axis_fault = value;
+        snapshot.timestamp = SampleClock::time_point(SampleClock::duration(static_cast<SampleClock::rep>(number)));
+        snapshot.generation = number;
+        snapshot.valid = true;
+        return snapshot;
+    }
+
+    bool is_torn(const AxisSnapshot& snapshot)
+    {
+        const auto value = static_cast<double>(snapshot.generation);
+        return snapshot.axis_status != value || snapshot.drive_status != value || snapshot.position_command != value
+            || snapshot.position_feedback != value || snapshot.velocity_command != value
+            || snapshot.velocity_feedback != value || snapshot.axis_fault != value
+            || snapshot.timestamp.time_since_epoch().count() != static_cast<SampleClock::rep>(snapshot.generation);
+    }
+
+    // Runs write(sample number) every period in one thread and read(axisID) back to back in the reader threads.
+    template <typename Write, typename Read>
+    Result measure(const Settings& settings, const int readers, Write write, Read read)
+    {
+        std::atomic<bool> stop{false};
+        std::atomic<bool> go{false};
+        double write_total = 0;
+        double write_max = 0;
+        std::uint64_t writes = 0;
+        std::thread writer([&]
+        {
+            while (!go.load(std::memory_order_acquire))
+                std::this_thread::yield();
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                const auto start = Clock::now();
+                write(++writes);
+                const auto duration = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+                write_total += duration;
+                write_max = std::max(write_max, duration);
+                std::this_thread::sleep_for(settings.period);
+            }
+        });
+
+        std::vector<std::size_t> reads(readers);
+        std::vector<std::size_t> torn(readers);
+        std::vector<std::thread> threads;
+        for (int r = 0; r < readers; r++)
+        {
+            threads.emplace_back([&, r]
+            {
+                while (!go.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+                std::size_t count = 0;
+                std::size_t torn_count = 0;
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    if (is_torn(read(static_cast<int>((count + r) % settings.axes))))
+                        torn_count++;
+                    count++;
+                }
+                reads[r] = count;
+                torn[r] = torn_count;
+            });
+        }
+
+        const auto start = Clock::now();
+        go = true;
+        std::this_thread::sleep_for(settings.duration);
+        stop = true;
+        const auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        for (auto& thread : threads)
+            thread.join();
+        writer.join();
+
+        Result result;
+        std::size_t total = 0;
+        for (int r = 0; r < readers; r++)
+        {
+            total += reads[r];
+            result.torn += torn[r];
+        }
+        result.reads_per_second = static_cast<double>(total) / elapsed;
+        result.read_ns = total > 0 ? elapsed * 1e9 * readers / static_cast<double>(total) : 0.;
+        result.write_mean_us = writes > 0 ? write_total / static_cast<double>(writes) : 0.;
+        result.write_max_us = write_max;
+        return result;
+    }
+
+    Result locked_map(const Settings& settings, const int readers)
+    {
+        std::mutex mutex;
+        std::map<int, AxisSnapshot> snapshots;
+        for (int axisID = 0; axisID < settings.axes; axisID++)
+            snapshots[axisID] = make_sample(0);
+        return measure(settings, readers, [&](const std::uint64_t number)
+        {
+            std::lock_guard lk(mutex);
+            for (int axisID = 0; axisID < settings.axes; axisID++)
+                snapshots[axisID] = make_sample(number);
+        }, [&](const int axisID)
+        {
+            std::lock_guard lk(mutex);
+            return snapshots.at(axisID);
+        });
+    }
+
+    Result snapshot_table(const Settings& settings, const int readers)
+    {
+        auto table = std::make_unique<SnapshotTable>();
+        auto publish = [&](const std::uint64_t number)
+        {
+            table->write_begin();
+            for (int axisID = 0; axisID < settings.axes; axisID++)
+                table->store(axisID, make_sample(number));
+            table->write_end();
+        };
+        publish(0);
+        return measure(settings, readers, publish, [&](const int axisID)
+        {
+            return table->load(axisID).value_or(AxisSnapshot{});
+        });
+    }
+
+    void print(const char* method, const int readers, const Result& result)
+    {
+        std::cout << std::setw(15) << method << std::setw(8) << readers << std::fixed << std::setprecision(0)
+            << std::setw(14) << result.reads_per_second << std::setprecision(1) << std::setw(12) << result.read_ns
+            << std::setw(12) << result.write_mean_us << std::setw(14) << result.write_max_us << std::setw(8)
+            << result.torn << std::endl;
+    }
+
+    int usage()
+    {
+        std::cerr << "usage: automation1_snapshot_bench [--seconds <s>] [--axes <count>] [--period <us>]"
+            << std::endl;
+        return 2;
+    }
+}
+
+int main(const int argc, char* argv[])
+{
+    Settings settings;
+    for (int i = 1; i < argc; i++)
+    {
+        if (i + 1 < argc && std::strcmp(argv[i], "--seconds") == 0)
+            settings.duration = std::chrono::duration<double>(std::atof(argv[++i]));
+        else if (i + 1 < argc && std::strcmp(argv[i], "--axes") == 0)
+            settings.axes = std::clamp(std::atoi(argv[++i]), 1, SnapshotTable::max_axes);
+        else if (i + 1 < argc && std::strcmp(argv[i], "--period") == 0)
+            settings.period = std::chrono::microseconds(std::strtoll(argv[++i], nullptr, 10));
+        else
+            return usage();
+    }
+
+    std::cout << std::setw(15) << "method" << std::setw(8) << "readers" << std::setw(14) << "reads/s"
+        << std::setw(12) << "read ns" << std::setw(12) << "write us" << std::setw(14) << "write max us"
+        << std::setw(8) << "torn" << std::endl;
+    for (const int readers : {1, 2, 4, 8, 16, 32})
+    {
+        print("locked map", readers, locked_map(settings, readers));
+        print("snapshot table", readers, snapshot_table(settings, readers));
+    }
+    return 0;
+}
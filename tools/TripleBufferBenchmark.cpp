@@ -0,0 +1,217 @@
+/*
+ * Tango-Device-Server for Automation1 Aerotech Controller
+ * Copyright (C) 2025  Marcus Zuber
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+// Compares the hand over of captured positions to a reader: the triple buffer used by PositionCapture against a
+// copy of the whole capture under a mutex, as done before. For growing captures it prints the time and the heap
+// allocations per read, and the mean and worst time the writer needs to append and publish a chunk.
+//
+//   automation1_triple_buffer_bench [--seconds <s>] [--chunk <points>] [--period <us>]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+#include "TripleBuffer.h"
+
+using namespace Controller_ns;
+
+namespace
+{
+    // Heap allocations of the calling thread.
+    thread_local std::size_t allocations = 0;
+}
+
+void* operator new(const std::size_t size)
+{
+    allocations++;
+    if (void* memory = std::malloc(size == 0 ? 1 : size))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Settings
+    {
+        // Time the reader reads back to back per measurement.
+        std::chrono::duration<double> duration{1.};
+        // Points appended per writer cycle, like one drain of the drive array.
+        std::size_t chunk{100};
+        std::chrono::microseconds period{1000};
+    };
+
+    struct Result
+    {
+        double read_ns{};
+        double allocations_per_read{};
+        double write_mean_us{};
+        double write_max_us{};
+    };
+
+    // Runs the writer in its own thread: it appends settings.chunk points every period with append(), which
+    // returns the time spent. The reader calls read() back to back for settings.duration.
+    template <typename Append, typename Read>
+    Result measure(const Settings& settings, Append append, Read read)
+    {
+        std::atomic<bool> stop{false};
+        double write_total = 0;
+        double write_max = 0;
+        std::size_t writes = 0;
+        std::thread writer([&]
+        {
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                const auto duration = std::chrono::duration<double, std::micro>(append()).count();
+                write_total += duration;
+                write_max = std::max(write_max, duration);
+                writes++;
+                std::this_thread::sleep_for(settings.period);
+            }
+        });
+
+        allocations = 0;
+        std::size_t reads = 0;
+        const auto start = Clock::now();
+        auto elapsed = Clock::duration::zero();
+        while (elapsed < settings.duration)
+        {
+            read();
+            reads++;
+            elapsed = Clock::now() - start;
+        }
+        const auto reader_allocations = allocations;
+        stop = true;
+        writer.join();
+
+        Result result;
+        result.read_ns = std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(reads);
+        result.allocations_per_read = static_cast<double>(reader_allocations) / static_cast<double>(reads);
+        result.write_mean_us = writes > 0 ? write_total / static_cast<double>(writes) : 0.;
+        result.write_max_us = write_max;
+        return result;
+    }
+
+    Result locked_copy(const Settings& settings, const std::size_t points)
+    {
+        std::mutex mutex;
+        std::vector<double> capture(points, 1.);
+        std::vector<double> positions;
+        volatile std::size_t sink = 0;
+        return measure(settings, [&]
+        {
+            const auto start = Clock::now();
+            std::lock_guard lk(mutex);
+            capture.insert(capture.end(), settings.chunk, 1.);
+            return Clock::now() - start;
+        }, [&]
+        {
+            {
+                std::lock_guard lk(mutex);
+                positions = capture;
+            }
+            sink = sink + positions.size();
+        });
+    }
+
+    Result triple_buffer(const Settings& settings, const std::size_t points)
+    {
+        std::vector<double> capture(points, 1.);
+        TripleBuffer<std::vector<double>> published;
+        // Same incremental publish as PositionCapture::publish().
+        auto publish = [&]
+        {
+            auto& back = published.back();
+            back.insert(back.end(), capture.begin() + static_cast<std::ptrdiff_t>(back.size()), capture.end());
+            published.publish();
+        };
+        // Brings all three buffers up to the initial capture before measuring.
+        for (int i = 0; i < 3; i++)
+            publish();
+        volatile std::size_t sink = 0;
+        return measure(settings, [&]
+        {
+            const auto start = Clock::now();
+            capture.insert(capture.end(), settings.chunk, 1.);
+            publish();
+            return Clock::now() - start;
+        }, [&]
+        {
+            published.acquire();
+            sink = sink + published.front().size();
+        });
+    }
+
+    void print(const char* method, const std::size_t points, const Result& result)
+    {
+        std::cout << std::setw(14) << method << std::setw(10) << points << std::fixed << std::setprecision(1)
+            << std::setw(14) << result.read_ns << std::setprecision(3) << std::setw(14)
+            << result.allocations_per_read << std::setprecision(1) << std::setw(14) << result.write_mean_us
+            << std::setw(14) << result.write_max_us << std::endl;
+    }
+
+    int usage()
+    {
+        std::cerr << "usage: automation1_triple_buffer_bench [--seconds <s>] [--chunk <points>] [--period <us>]"
+            << std::endl;
+        return 2;
+    }
+}
+
+int main(const int argc, char* argv[])
+{
+    Settings settings;
+    for (int i = 1; i < argc; i++)
+    {
+        if (i + 1 < argc && std::strcmp(argv[i], "--seconds") == 0)
+            settings.duration = std::chrono::duration<double>(std::atof(argv[++i]));
+        else if (i + 1 < argc && std::strcmp(argv[i], "--chunk") == 0)
+            settings.chunk = std::strtoull(argv[++i], nullptr, 10);
+        else if (i + 1 < argc && std::strcmp(argv[i], "--period") == 0)
+            settings.period = std::chrono::microseconds(std::strtoll(argv[++i], nullptr, 10));
+        else
+            return usage();
+    }
+
+    std::cout << std::setw(14) << "method" << std::setw(10) << "points" << std::setw(14) << "read ns"
+        << std::setw(14) << "allocs/read" << std::setw(14) << "write us" << std::setw(14) << "write max us"
+        << std::endl;
+    for (const std::size_t points : {1000, 10000, 100000, 1000000})
+    {
+        print("locked copy", points, locked_copy(settings, points));
+        print("triple buffer", points, triple_buffer(settings, points));
+    }
+    return 0;
+}